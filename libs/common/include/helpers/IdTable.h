@@ -0,0 +1,83 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#ifndef IdTable_h__
+#define IdTable_h__
+
+#include "RTTR_Assert.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace helpers {
+
+/// Maps ids from a dense counter to values (default: value initialized).
+/// The ids are split into blocks of BLOCK_SIZE entries which are only allocated when a value in them is set,
+/// so lookups are 2 array accesses and unused id ranges (e.g. of long gone objects) take no memory
+template<typename T, unsigned T_blockSize = 1024>
+class IdTable
+{
+public:
+    static constexpr unsigned BLOCK_SIZE = T_blockSize;
+
+    IdTable() : numSet_(0) {}
+
+    /// Remove all values
+    void clear()
+    {
+        blocks_.clear();
+        numSet_ = 0;
+    }
+    /// Prepare for ids less than the given one
+    void reserve(unsigned idLimit) { blocks_.reserve((idLimit + BLOCK_SIZE - 1) / BLOCK_SIZE); }
+
+    /// Return the value of the id or the default value if it was not set
+    T get(unsigned id) const
+    {
+        const unsigned blockIdx = id / BLOCK_SIZE;
+        if(blockIdx >= blocks_.size() || !blocks_[blockIdx])
+            return T();
+        return (*blocks_[blockIdx])[id % BLOCK_SIZE];
+    }
+    /// Set the value of the id which must not be set yet and must not be the default value
+    void insert(unsigned id, const T& value)
+    {
+        RTTR_Assert(value != T());
+        const unsigned blockIdx = id / BLOCK_SIZE;
+        if(blockIdx >= blocks_.size())
+            blocks_.resize(blockIdx + 1);
+        if(!blocks_[blockIdx])
+            blocks_[blockIdx] = std::make_unique<Block>();
+        T& entry = (*blocks_[blockIdx])[id % BLOCK_SIZE];
+        RTTR_Assert(entry == T());
+        entry = value;
+        ++numSet_;
+    }
+    bool contains(unsigned id) const { return get(id) != T(); }
+    /// Number of ids with a value
+    unsigned size() const { return numSet_; }
+
+private:
+    using Block = std::array<T, BLOCK_SIZE>;
+    std::vector<std::unique_ptr<Block>> blocks_;
+    unsigned numSet_;
+};
+
+} // namespace helpers
+
+#endif // IdTable_h__
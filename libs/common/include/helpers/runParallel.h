@@ -0,0 +1,48 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#ifndef runParallel_h__
+#define runParallel_h__
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace helpers {
+
+/// Call func(i) for all i in [0, count) using up to numThreads threads (including the calling one)
+template<class T_Func>
+void runParallel(unsigned numThreads, unsigned count, const T_Func& func)
+{
+    std::atomic<unsigned> next(0);
+    const auto work = [&next, count, &func]() {
+        for(unsigned i = next++; i < count; i = next++)
+            func(i);
+    };
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < std::min(numThreads, count); i++)
+        threads.emplace_back(work);
+    work();
+    for(std::thread& thread : threads)
+        thread.join();
+}
+
+} // namespace helpers
+
+#endif // runParallel_h__
@@ -124,7 +124,7 @@ const std::array<const char*, 104> SUPPRESS_UNUSED FILE_PATHS = {{
   /* 94 */ "<RTTR_CONFIG>",                     // Einstellungsordner
   /* 95 */ "<RTTR_RTTR>/LSTS",                  // systemweite lstfiles (immer bei start geladen)
   /* 96 */ "<RTTR_RTTR>/LSTS/GAME",             // systemweite lstfiles (immer bei spielstart geladen)
-  /* 97 */ "",                                  // unused
+  /* 97 */ "<RTTR_USERDATA>/CACHE",             // Cache for packed textures
   /* 98 */ "<RTTR_USERDATA>/LSTS",              // persönliche lstfiles (immer bei start geladen)
   /* 99 */ "<RTTR_USERDATA>/LSTS/GAME",         // persönliche lstfiles (immer bei spielstart geladen)
   /*100 */ "<RTTR_USERDATA>/screenshots",       // Screenshots
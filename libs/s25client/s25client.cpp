@@ -29,6 +29,7 @@
 #include "files.h"
 #include "mygettext/mygettext.h"
 #include "ogl/glAllocator.h"
+#include "random/Random.h"
 #include "libsiedler2/libsiedler2.h"
 #include "s25util/LocaleHelper.h"
 #include "s25util/Log.h"
@@ -39,6 +40,7 @@
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/iostream.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <ctime>
@@ -383,6 +385,8 @@ int RunProgram(po::variables_map& options)
     atexit(&ExitHandler);
     if(!InitDirectories())
         return 1;
+    if(options.count("random-history"))
+        RANDOM.SetHistorySize(std::max(1u, options["random-history"].as<unsigned>()));
 
     // Zufallsgenerator initialisieren (Achtung: nur für Animations-Offsets interessant, für alles andere (spielentscheidende) wird unser
     // Generator verwendet)
@@ -442,6 +446,7 @@ int main(int argc, char** argv)
     desc.add_options()
         ("help,h", "Show help")
         ("map,m", po::value<std::string>(),"Map to load")
+        ("random-history", po::value<unsigned>(), "Number of random number generations kept for async logs")
         ("version", "Show version information and exit")
         ;
     // clang-format on
@@ -0,0 +1,205 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "HeadlessGame.h"
+#include "RTTR_AssertError.h"
+#include "RttrConfig.h"
+#include "ogl/glAllocator.h"
+#include "random/Random.h"
+#include "libsiedler2/libsiedler2.h"
+#include "s25util/LocaleHelper.h"
+#include "s25util/Log.h"
+#include <boost/nowide/args.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace bnw = boost::nowide;
+namespace po = boost::program_options;
+
+namespace {
+/// Return the peak memory usage of this process in KiB
+uint64_t GetPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    // Reported in bytes instead of KiB
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+void PrintChecksum(const HeadlessGame& game)
+{
+    const AsyncChecksum checksum = game.GetChecksum();
+    bnw::cout << "GF " << game.GetGFNumber() << ": Checksum " << checksum.randChecksum << " ObjCt " << checksum.objCt << " ObjIdCt "
+              << checksum.objIdCt << " EventCt " << checksum.eventCt << " EvInstanceCt " << checksum.evInstanceCt << " MapHash "
+              << checksum.mapHash << " PlayerHash " << checksum.playerHash << " EventQueueHash " << checksum.eventQueueHash << std::endl;
+}
+
+int RunSimulation(const po::variables_map& options)
+{
+    if(!LocaleHelper::init())
+        return 1;
+    if(!RTTRCONFIG.Init())
+        return 1;
+    libsiedler2::setAllocator(new GlAllocator());
+    if(options.count("random-history"))
+        RANDOM.SetHistorySize(std::max(1u, options["random-history"].as<unsigned>()));
+
+    int result = 0;
+    {
+        HeadlessGame game(options["ai-threads"].as<unsigned>());
+        if(options.count("async-log"))
+            game.SetAsyncLogPath(options["async-log"].as<std::string>());
+        game.SetVerifyStateHashes(options.count("verify-state-hashes") > 0);
+        bool loaded;
+        const auto startLoad = std::chrono::steady_clock::now();
+        if(options.count("replay"))
+            loaded = game.LoadReplay(options["replay"].as<std::string>());
+        else
+            loaded = game.LoadSavegame(options["savegame"].as<std::string>(), options["seed"].as<unsigned>());
+        if(!loaded)
+        {
+            bnw::cerr << "Loading failed: " << game.GetLastErrorMsg() << std::endl;
+            libsiedler2::setAllocator(nullptr);
+            return 1;
+        }
+        const auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startLoad);
+        bnw::cout << "Loaded game at GF " << game.GetGFNumber() << " in " << loadTime.count() << "ms" << std::endl;
+
+        const unsigned maxGF = options["max-gf"].as<unsigned>();
+        const unsigned checksumInterval = options["checksum-interval"].as<unsigned>();
+        std::vector<unsigned> checksumGFs;
+        if(options.count("checksum-gf"))
+            checksumGFs = options["checksum-gf"].as<std::vector<unsigned>>();
+        std::sort(checksumGFs.begin(), checksumGFs.end());
+
+        const unsigned startGF = game.GetGFNumber();
+        const auto startTime = std::chrono::steady_clock::now();
+        while(game.GetGFNumber() < maxGF && !game.IsFinished())
+        {
+            const unsigned curGF = game.GetGFNumber();
+            if((checksumInterval && curGF % checksumInterval == 0) || std::binary_search(checksumGFs.begin(), checksumGFs.end(), curGF))
+                PrintChecksum(game);
+            game.RunGF();
+        }
+        const auto runTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - startTime);
+        const unsigned numGFs = game.GetGFNumber() - startGF;
+
+        PrintChecksum(game);
+        bnw::cout << "Ran " << numGFs << " GFs in " << runTime.count() << "s";
+        if(runTime.count() > 0)
+            bnw::cout << " (" << static_cast<unsigned>(numGFs / runTime.count()) << " GF/s)";
+        bnw::cout << std::endl;
+        bnw::cout << "Peak memory usage: " << GetPeakMemoryUsage() << " KiB" << std::endl;
+        if(game.GetNumAsyncGFs())
+        {
+            bnw::cout << "Replay was asynchronous in " << game.GetNumAsyncGFs() << " GFs" << std::endl;
+            result = 2;
+        }
+        if(game.GetNumStateHashErrors())
+        {
+            bnw::cout << "State hashes were wrong after " << game.GetNumStateHashErrors() << " GFs" << std::endl;
+            result = 3;
+        }
+    }
+    libsiedler2::setAllocator(nullptr);
+    return result;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bnw::args _(argc, argv);
+
+    po::options_description desc("Runs the game simulation of a replay or savegame without graphics or sound as fast as possible.\n"
+                                 "Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show help")
+        ("replay,r", po::value<std::string>(), "Replay to run")
+        ("savegame,s", po::value<std::string>(), "Savegame to continue with AI players")
+        ("seed", po::value<unsigned>()->default_value(0), "Random seed used for savegames")
+        ("max-gf", po::value<unsigned>()->default_value(std::numeric_limits<unsigned>::max()), "Stop at this GF")
+        ("checksum-gf", po::value<std::vector<unsigned>>()->multitoken(), "Print the checksum at these GFs")
+        ("checksum-interval", po::value<unsigned>()->default_value(0), "Print the checksum every n GFs")
+        ("ai-threads", po::value<unsigned>()->default_value(0), "Maximum number of threads running the AIs (0 = all cores)")
+        ("random-history", po::value<unsigned>(), "Number of random number generations kept for the async log")
+        ("async-log", po::value<std::string>(), "Save the random number log to this file when the replay gets asynchronous")
+        ("verify-state-hashes", "Recalculate the state hashes after each GF to find untracked changes (slow)")
+        ;
+    // clang-format on
+
+    po::variables_map options;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(desc).run(), options);
+    } catch(const po::error& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n\n";
+        bnw::cerr << desc << "\n";
+        return 1;
+    }
+    po::notify(options);
+
+    if(options.count("help"))
+    {
+        bnw::cout << desc << "\n";
+        return 0;
+    }
+    if(options.count("replay") == options.count("savegame"))
+    {
+        bnw::cerr << "Error: Exactly one of replay or savegame must be given\n\n";
+        bnw::cerr << desc << "\n";
+        return 1;
+    }
+
+    try
+    {
+        return RunSimulation(options);
+    } catch(RTTR_AssertError& error)
+    {
+        LOG.write("%1%\n", LogTarget::Stderr) % error.what();
+        return 42;
+    } catch(const std::exception& error)
+    {
+        LOG.write("Error: %1%\n", LogTarget::Stderr) % error.what();
+        return 1;
+    }
+}
@@ -21,13 +21,44 @@
 #include "FileChecksum.h"
 #include "Game.h"
 #include "GameObject.h"
+#include "GamePlayer.h"
+#include "StateHash.h"
+#include "helpers/strUtils.h"
 #include "random/Random.h"
 #include "s25util/Serializer.h"
+#include <vector>
 
-AsyncChecksum::AsyncChecksum() : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0) {}
+namespace {
+unsigned CalcPlayerHash(const Game& game)
+{
+    StateHash hash;
+    for(unsigned id = 0; id < game.world_.GetNumPlayers(); ++id)
+    {
+        const Inventory& inventory = game.world_.GetPlayer(id).GetInventory();
+        const uint64_t playerKey = static_cast<uint64_t>(id) << 32;
+        for(unsigned i = 0; i < inventory.goods.size(); ++i)
+            hash.Add(playerKey | i, inventory.goods[i]);
+        for(unsigned i = 0; i < inventory.people.size(); ++i)
+            hash.Add(playerKey | (i + inventory.goods.size()), inventory.people[i]);
+    }
+    return hash.Get();
+}
+
+/// State hashes are only compared if both are available
+bool StateHashesDiffer(unsigned lhs, unsigned rhs)
+{
+    return lhs != 0 && rhs != 0 && lhs != rhs;
+}
+} // namespace
+
+AsyncChecksum::AsyncChecksum()
+    : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0), mapHash(0), playerHash(0), eventQueueHash(0)
+{}
 
-AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt)
-    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt)
+AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt,
+                             unsigned mapHash, unsigned playerHash, unsigned eventQueueHash)
+    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt), mapHash(mapHash),
+      playerHash(playerHash), eventQueueHash(eventQueueHash)
 {}
 
 void AsyncChecksum::Serialize(Serializer& ser) const
@@ -37,15 +68,25 @@ void AsyncChecksum::Serialize(Serializer& ser) const
     ser.PushUnsignedInt(objIdCt);
     ser.PushUnsignedInt(eventCt);
     ser.PushUnsignedInt(evInstanceCt);
+    ser.PushUnsignedInt(mapHash);
+    ser.PushUnsignedInt(playerHash);
+    ser.PushUnsignedInt(eventQueueHash);
 }
 
-void AsyncChecksum::Deserialize(Serializer& ser)
+void AsyncChecksum::Deserialize(Serializer& ser, bool withStateHashes)
 {
     randChecksum = ser.PopUnsignedInt();
     objCt = ser.PopUnsignedInt();
     objIdCt = ser.PopUnsignedInt();
     eventCt = ser.PopUnsignedInt();
     evInstanceCt = ser.PopUnsignedInt();
+    if(withStateHashes)
+    {
+        mapHash = ser.PopUnsignedInt();
+        playerHash = ser.PopUnsignedInt();
+        eventQueueHash = ser.PopUnsignedInt();
+    } else
+        mapHash = playerHash = eventQueueHash = 0;
 }
 
 unsigned AsyncChecksum::getHash() const
@@ -55,8 +96,37 @@ unsigned AsyncChecksum::getHash() const
     return CalcChecksumOfBuffer(ser.GetData(), ser.GetLength());
 }
 
+std::string AsyncChecksum::getDivergentParts(const AsyncChecksum& rhs) const
+{
+    std::vector<std::string> parts;
+    if(randChecksum != rhs.randChecksum)
+        parts.push_back("random");
+    if(objCt != rhs.objCt || objIdCt != rhs.objIdCt)
+        parts.push_back("objects");
+    if(eventCt != rhs.eventCt || evInstanceCt != rhs.evInstanceCt)
+        parts.push_back("events");
+    if(StateHashesDiffer(mapHash, rhs.mapHash))
+        parts.push_back("map");
+    if(StateHashesDiffer(playerHash, rhs.playerHash))
+        parts.push_back("players");
+    if(StateHashesDiffer(eventQueueHash, rhs.eventQueueHash))
+        parts.push_back("event queue");
+    return helpers::join(parts, ", ");
+}
+
 AsyncChecksum AsyncChecksum::create(const Game& game)
 {
     return AsyncChecksum(RANDOM.GetChecksum(), GameObject::GetNumObjs(), GameObject::GetObjIDCounter(), game.em_->GetNumActiveEvents(),
-                         game.em_->GetEventInstanceCtr());
+                         game.em_->GetEventInstanceCtr(), game.world_.GetStateHash(), CalcPlayerHash(game),
+                         game.em_->GetStateHash());
+}
+
+std::string AsyncChecksum::checkStateHashes(const Game& game)
+{
+    std::vector<std::string> parts;
+    if(game.world_.GetStateHash() != game.world_.CalcStateHash())
+        parts.push_back("map");
+    if(game.em_->GetStateHash() != game.em_->CalcStateHash())
+        parts.push_back("event queue");
+    return helpers::join(parts, ", ");
 }
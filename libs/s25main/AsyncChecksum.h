@@ -19,6 +19,8 @@
 #ifndef AsyncChecksum_h__
 #define AsyncChecksum_h__
 
+#include <string>
+
 class Game;
 class Serializer;
 
@@ -28,14 +30,25 @@ struct AsyncChecksum
     unsigned randChecksum;
     unsigned objCt, objIdCt;
     unsigned eventCt, evInstanceCt;
+    /// Hashes of the game state: Owners, roads and objects of the map, inventories of the players and the queued events.
+    /// 0 if not available (e.g. from old replays)
+    unsigned mapHash, playerHash, eventQueueHash;
     AsyncChecksum();
-    AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt);
+    AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt, unsigned mapHash,
+                  unsigned playerHash, unsigned eventQueueHash);
     void Serialize(Serializer& ser) const;
-    void Deserialize(Serializer& ser);
+    /// Read the checksum. The state hashes are only read if they are contained
+    void Deserialize(Serializer& ser, bool withStateHashes = true);
     /// Get a hash for this checksum
     unsigned getHash() const;
+    /// Return the names of the parts of the game which differ (comma separated) or an empty string if the checksums match.
+    /// State hashes missing in one of the checksums are ignored
+    std::string getDivergentParts(const AsyncChecksum& rhs) const;
 
     static AsyncChecksum create(const Game& game);
+    /// Recalculate the incrementally updated state hashes of the game from scratch.
+    /// Return the names of the parts whose hashes differ, i.e. where a change was not tracked, or an empty string
+    static std::string checkStateHashes(const Game& game);
 
     bool operator==(const AsyncChecksum& rhs) const;
     bool operator!=(const AsyncChecksum& rhs) const;
@@ -44,7 +57,8 @@ struct AsyncChecksum
 inline bool AsyncChecksum::operator==(const AsyncChecksum& rhs) const
 {
     return randChecksum == rhs.randChecksum && objCt == rhs.objCt && objIdCt == rhs.objIdCt && eventCt == rhs.eventCt
-           && evInstanceCt == rhs.evInstanceCt;
+           && evInstanceCt == rhs.evInstanceCt && mapHash == rhs.mapHash && playerHash == rhs.playerHash
+           && eventQueueHash == rhs.eventQueueHash;
 }
 
 inline bool AsyncChecksum::operator!=(const AsyncChecksum& rhs) const
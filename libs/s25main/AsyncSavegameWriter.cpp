@@ -0,0 +1,106 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "AsyncSavegameWriter.h"
+#include "Savegame.h"
+#include <exception>
+
+constexpr unsigned AsyncSavegameWriter::MAX_QUEUED_SAVES;
+
+AsyncSavegameWriter::AsyncSavegameWriter() : stop_(false), thread_(&AsyncSavegameWriter::Run, this) {}
+
+AsyncSavegameWriter::~AsyncSavegameWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+}
+
+bool AsyncSavegameWriter::Push(std::unique_ptr<Savegame> save, const std::string& filePath, const std::string& mapName)
+{
+    return Push(std::move(save), filePath, [filePath, mapName](Savegame& savegame) { return savegame.Save(filePath, mapName); });
+}
+
+bool AsyncSavegameWriter::Push(std::unique_ptr<Savegame> save, const std::string& filePath, WriteFunc write)
+{
+    RTTR_Assert(save && write);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(jobs_.size() >= MAX_QUEUED_SAVES)
+            return false;
+        jobs_.push_back(Job{std::move(save), filePath, std::move(write)});
+    }
+    cond_.notify_all();
+    return true;
+}
+
+bool AsyncSavegameWriter::IsFull() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size() >= MAX_QUEUED_SAVES;
+}
+
+std::vector<AsyncSavegameWriter::Result> AsyncSavegameWriter::PopResults()
+{
+    std::vector<Result> results;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(results, results_);
+    return results;
+}
+
+void AsyncSavegameWriter::WaitForCompletion()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return jobs_.empty(); });
+}
+
+void AsyncSavegameWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(true)
+    {
+        cond_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+        // Finish outstanding jobs even when stopping so no savegame is lost
+        if(jobs_.empty())
+            return;
+        // Job stays in the queue while being written so it counts towards the limit
+        Job& job = jobs_.front();
+        lock.unlock();
+
+        Result result{job.filePath, false, "", std::chrono::milliseconds::zero()};
+        const auto startTime = std::chrono::steady_clock::now();
+        try
+        {
+            result.success = job.write(*job.save);
+            if(!result.success)
+                result.errorMsg = "Could not write file";
+        } catch(std::exception& e)
+        {
+            result.errorMsg = e.what();
+        }
+        result.writeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+        lock.lock();
+        jobs_.pop_front();
+        results_.push_back(std::move(result));
+        cond_.notify_all();
+    }
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AsyncSavegameWriter_h__
+#define AsyncSavegameWriter_h__
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Savegame;
+
+/// Writes savegames which were already snapshotted in memory to disk on a worker thread
+/// so the game loop only pays for the snapshot itself.
+/// All public functions must be called from the same (main) thread
+class AsyncSavegameWriter
+{
+public:
+    /// Maximum number of savegames waiting to be written. Further ones get rejected
+    static constexpr unsigned MAX_QUEUED_SAVES = 2;
+
+    /// Writes the savegame somewhere. Return false on failure
+    using WriteFunc = std::function<bool(Savegame&)>;
+
+    struct Result
+    {
+        std::string filePath;
+        bool success;
+        std::string errorMsg;
+        std::chrono::milliseconds writeTime;
+    };
+
+    AsyncSavegameWriter();
+    /// Writes all outstanding savegames before returning
+    ~AsyncSavegameWriter();
+
+    /// Queue the savegame for writing. Return false if the queue is full
+    bool Push(std::unique_ptr<Savegame> save, const std::string& filePath, const std::string& mapName);
+    /// Queue the savegame to be written by the function (e.g. into an open file). filePath is only used for the result
+    bool Push(std::unique_ptr<Savegame> save, const std::string& filePath, WriteFunc write);
+    bool IsFull() const;
+    /// Return the results of all writes finished since the last call
+    std::vector<Result> PopResults();
+    /// Block until all queued savegames are written
+    void WaitForCompletion();
+
+private:
+    struct Job
+    {
+        std::unique_ptr<Savegame> save;
+        std::string filePath;
+        WriteFunc write;
+    };
+
+    void Run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    /// Jobs not yet finished. The front one is currently being written (if busy)
+    std::deque<Job> jobs_;
+    std::vector<Result> results_;
+    bool stop_;
+    std::thread thread_;
+};
+
+#endif // AsyncSavegameWriter_h__
@@ -24,7 +24,17 @@
 #include "s25util/Log.h"
 #include <mygettext/mygettext.h>
 
-EventManager::EventManager(unsigned startGF) : numActiveEvents(0), eventInstanceCtr(1), currentGF(startGF), curActiveEvent(nullptr) {}
+namespace {
+uint64_t GetEventHashValue(const GameEvent& event)
+{
+    return (static_cast<uint64_t>(event.obj->GetObjId()) << 32) ^ (static_cast<uint64_t>(event.id) << 24) ^ event.GetTargetGF();
+}
+} // namespace
+
+EventManager::EventManager(unsigned startGF)
+    : numActiveEvents(0), eventInstanceCtr(1), currentGF(startGF), numEventsInWheel(0), curActiveEvent(nullptr),
+      eventPool(sizeof(GameEvent))
+{}
 
 EventManager::~EventManager()
 {
@@ -33,17 +43,33 @@ EventManager::~EventManager()
 
 void EventManager::Clear()
 {
-    for(auto& event : events)
+    for(EventBucket& bucket : eventWheel)
+    {
+        for(const GameEvent* ev : bucket)
+        {
+            if(!ev)
+                continue;
+            FreeEvent(ev);
+            RTTR_Assert(numActiveEvents > 0u);
+            numActiveEvents--;
+        }
+        bucket.clear();
+    }
+    numEventsInWheel = 0;
+    for(auto& event : farEvents)
     {
         for(const GameEvent* ev : event.second)
         {
-            delete ev;
+            if(!ev)
+                continue;
+            FreeEvent(ev);
             RTTR_Assert(numActiveEvents > 0u);
             numActiveEvents--;
         }
     }
-    events.clear();
+    farEvents.clear();
     RTTR_Assert(numActiveEvents == 0u);
+    stateHash_.Clear();
 
     for(auto& it : killList)
     {
@@ -59,12 +85,27 @@ void EventManager::Clear()
     eventInstanceCtr = 1u;
 }
 
+void EventManager::FreeEvent(const GameEvent* event)
+{
+    if(!event)
+        return;
+    event->~GameEvent();
+    eventPool.free(const_cast<GameEvent*>(event));
+}
+
 const GameEvent* EventManager::AddEventToQueue(const GameEvent* event)
 {
     // Should be in the future!
     RTTR_Assert(event->GetTargetGF() > currentGF);
-    events[event->GetTargetGF()].push_back(event);
+    const unsigned targetGF = event->GetTargetGF();
+    if(IsInWheel(targetGF))
+    {
+        GetWheelBucket(targetGF).push_back(event);
+        ++numEventsInWheel;
+    } else
+        farEvents[targetGF].push_back(event);
     ++numActiveEvents;
+    stateHash_.Add(event->GetInstanceId(), GetEventHashValue(*event));
     return event;
 }
 
@@ -73,7 +114,7 @@ const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, uns
     RTTR_Assert(obj);
     RTTR_Assert(gf_length);
 
-    return AddEventToQueue(new GameEvent(GetNextEventInstanceId(), obj, currentGF, gf_length, id));
+    return AddEventToQueue(MakeEvent(GetNextEventInstanceId(), obj, currentGF, gf_length, id));
 }
 
 const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, unsigned id, unsigned gf_elapsed)
@@ -81,7 +122,7 @@ const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, uns
     RTTR_Assert(gf_length > gf_elapsed);
     // Anfang des Events in die Vergangenheit zurückverlegen
     RTTR_Assert(currentGF >= gf_elapsed);
-    return AddEventToQueue(new GameEvent(GetNextEventInstanceId(), obj, currentGF - gf_elapsed, gf_length, id));
+    return AddEventToQueue(MakeEvent(GetNextEventInstanceId(), obj, currentGF - gf_elapsed, gf_length, id));
 }
 
 unsigned EventManager::GetNextEventInstanceId()
@@ -94,12 +135,62 @@ unsigned EventManager::GetNextEventInstanceId()
 
 void EventManager::ExecuteNextGF()
 {
-    currentGF++;
+    AdvanceToGF(currentGF + 1);
 
     ExecuteCurrentEvents();
     DestroyCurrentObjects();
 }
 
+void EventManager::AdvanceToGF(unsigned newGF)
+{
+    RTTR_Assert(newGF >= currentGF);
+    RTTR_Assert(newGF == currentGF + 1 || GetNextEventGF() == 0 || GetNextEventGF() >= newGF);
+    // Buckets of skipped GFs can only contain removed events. They get reused for the GFs now entering the wheel
+    for(unsigned gf = currentGF; gf < newGF && gf - currentGF < EVENT_WHEEL_SIZE; ++gf)
+    {
+        EventBucket& bucket = GetWheelBucket(gf);
+        RTTR_Assert(!helpers::contains_if(bucket, [](const GameEvent* ev) { return ev != nullptr; }));
+        bucket.clear();
+    }
+    currentGF = newGF;
+    // Move all events that are now in range into the wheel.
+    // Those were added before any event for the same GF could have been added to the wheel, so appending keeps the order
+    while(!farEvents.empty() && IsInWheel(farEvents.begin()->first))
+    {
+        auto itEvents = farEvents.begin();
+        EventBucket& bucket = GetWheelBucket(itEvents->first);
+        RTTR_Assert(bucket.empty());
+        for(const GameEvent* ev : itEvents->second)
+        {
+            if(ev)
+            {
+                bucket.push_back(ev);
+                ++numEventsInWheel;
+            }
+        }
+        farEvents.erase(itEvents);
+    }
+}
+
+unsigned EventManager::GetNextEventGF() const
+{
+    if(numEventsInWheel > 0u)
+    {
+        for(unsigned gf = currentGF; gf < currentGF + EVENT_WHEEL_SIZE; ++gf)
+        {
+            if(helpers::contains_if(GetWheelBucket(gf), [](const GameEvent* ev) { return ev != nullptr; }))
+                return gf;
+        }
+        RTTR_Assert(false);
+    }
+    for(const auto& event : farEvents)
+    {
+        if(helpers::contains_if(event.second, [](const GameEvent* ev) { return ev != nullptr; }))
+            return event.first;
+    }
+    return 0;
+}
+
 void EventManager::DestroyCurrentObjects()
 {
     // Remove all objects
@@ -115,47 +206,70 @@ void EventManager::DestroyCurrentObjects()
     killList.clear();
 }
 
+template<class T_Func>
+bool EventManager::FindEvent(const T_Func& func) const
+{
+    // Stop scanning the wheel once all of its events were seen
+    unsigned numRemaining = numEventsInWheel;
+    for(unsigned gf = currentGF; numRemaining > 0u && gf < currentGF + EVENT_WHEEL_SIZE; ++gf)
+    {
+        for(const GameEvent* ev : GetWheelBucket(gf))
+        {
+            if(!ev)
+                continue;
+            if(func(ev))
+                return true;
+            --numRemaining;
+        }
+    }
+    for(const auto& event : farEvents)
+    {
+        for(const GameEvent* ev : event.second)
+        {
+            if(ev && func(ev))
+                return true;
+        }
+    }
+    return false;
+}
+
 std::vector<const GameEvent*> EventManager::GetEvents() const
 {
     std::vector<const GameEvent*> nextEv;
-    for(const auto& event : events)
-        nextEv.insert(nextEv.end(), event.second.begin(), event.second.end());
+    nextEv.reserve(numActiveEvents);
+    FindEvent([&nextEv](const GameEvent* ev) {
+        nextEv.push_back(ev);
+        return false;
+    });
     return nextEv;
 }
 
 void EventManager::ExecuteCurrentEvents()
 {
-    if(events.empty())
-        return;
-    // Get list of events to be executed next
-    auto itCurEvents = events.begin();
-
-    RTTR_Assert(itCurEvents->first >= currentGF);
-
-    if(itCurEvents->first == currentGF)
-        ExecuteEvents(itCurEvents);
-}
-
-void EventManager::ExecuteEvents(const EventMap::iterator& itEvents)
-{
-    EventList& curEvents = itEvents->second;
+    EventBucket& curEvents = GetWheelBucket(currentGF);
     // We have to allow 2 cases:
-    // 1) Adding of events to current GF -> std::list allows this without invalidating any iterators
-    // 2) Checking for events -> Remove all deleted events so only valid ones are in the list
-    for(auto e_it = curEvents.begin(); e_it != curEvents.end(); e_it = curEvents.erase(e_it))
+    // 1) Events cannot be added to the current GF, so the bucket is not reallocated while iterating
+    // 2) Removed events are set to nullptr and skipped
+    for(unsigned i = 0; i < curEvents.size(); ++i)
     {
-        const GameEvent* ev = (*e_it);
+        const GameEvent* ev = curEvents[i];
+        if(!ev)
+            continue;
+        RTTR_Assert(ev->GetTargetGF() == currentGF);
         RTTR_Assert(ev->obj);
         RTTR_Assert(ev->obj->GetObjId() <= GameObject::GetObjIDCounter());
 
+        stateHash_.Remove(ev->GetInstanceId(), GetEventHashValue(*ev));
         curActiveEvent = ev;
         ev->obj->HandleEvent(ev->id);
 
-        delete ev;
+        curEvents[i] = nullptr;
+        FreeEvent(ev);
         --numActiveEvents;
+        --numEventsInWheel;
     }
     curActiveEvent = nullptr;
-    events.erase(itEvents);
+    curEvents.clear();
 }
 
 void EventManager::Serialize(SerializedGameData& sgd) const
@@ -194,30 +308,27 @@ void EventManager::Deserialize(SerializedGameData& sgd)
         boost::format eventCtError(_("Event count mismatch. Read events: %1%. Expected: %2%.\n"));
         throw SerializedGameData::Error((eventCtError % numActiveEvents % numEvents).str());
     }
-    for(const auto& it : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : it.second)
+        if(ev->GetInstanceId() >= eventInstanceCtr)
         {
-            if(ev->GetInstanceId() >= eventInstanceCtr)
-            {
-                boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
-                throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
-            }
+            boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
+            throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
         }
     }
 }
 
+unsigned EventManager::CalcStateHash() const
+{
+    StateHash hash;
+    for(const GameEvent* ev : GetEvents())
+        hash.Add(ev->GetInstanceId(), GetEventHashValue(*ev));
+    return hash.Get();
+}
+
 bool EventManager::ObjectHasEvents(const GameObject& obj)
 {
-    for(auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                return true;
-        }
-    }
-    return false;
+    return FindEvent([&obj](const GameEvent* ev) { return ev->obj == &obj; });
 }
 
 bool EventManager::IsObjectInKillList(const GameObject& obj)
@@ -238,32 +349,40 @@ void EventManager::RemoveEvent(const GameEvent*& ep)
         return;
     }
     RemoveEventFromQueue(*ep);
-    deletePtr(ep);
+    FreeEvent(ep);
+    ep = nullptr;
 }
 
 void EventManager::RemoveEventFromQueue(const GameEvent& event)
 {
     RTTR_Assert(curActiveEvent != &event);
-    auto itEventsAtTime = events.find(event.GetTargetGF());
-    if(itEventsAtTime != events.end())
+    const unsigned targetGF = event.GetTargetGF();
+    EventBucket* eventsAtTime = nullptr;
+    if(targetGF >= currentGF && IsInWheel(targetGF))
+        eventsAtTime = &GetWheelBucket(targetGF);
+    else
+    {
+        auto itEventsAtTime = farEvents.find(targetGF);
+        if(itEventsAtTime != farEvents.end())
+            eventsAtTime = &itEventsAtTime->second;
+    }
+    if(eventsAtTime)
     {
-        EventList& eventsAtTime = itEventsAtTime->second;
-        auto e_it = helpers::find(eventsAtTime, &event);
-        if(e_it != eventsAtTime.end())
+        auto e_it = helpers::find(*eventsAtTime, &event);
+        if(e_it != eventsAtTime->end())
         {
-            eventsAtTime.erase(e_it);
+            // Only mark as removed as we might currently iterate over this bucket
+            *e_it = nullptr;
             --numActiveEvents;
-            RTTR_Assert(!helpers::contains(eventsAtTime, &event)); // Event existed multiple times?
+            stateHash_.Remove(event.GetInstanceId(), GetEventHashValue(event));
+            if(IsInWheel(targetGF))
+                --numEventsInWheel;
+            RTTR_Assert(!helpers::contains(*eventsAtTime, &event)); // Event existed multiple times?
         } else
         {
             RTTR_Assert(false);
             LOG.write("Bug detected: Event to be removed did not exist");
         }
-
-        // Note: Removing this is possible, as it cannot be the currently processed list
-        //       because there is always the curActiveEvent left, which cannot be removed (check above)
-        if(eventsAtTime.empty())
-            events.erase(itEventsAtTime);
     } else
     {
         RTTR_Assert(false);
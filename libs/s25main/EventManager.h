@@ -19,14 +19,23 @@
 
 #pragma once
 
+#include "GameEvent.h"
+#include "StateHash.h"
+#include <boost/pool/pool.hpp>
+#include <array>
 #include <list>
 #include <map>
+#include <new>
+#include <utility>
 #include <vector>
 
 class SerializedGameData;
-class GameEvent;
 class GameObject;
 
+/// Schedules GameEvents and executes them at their target GF
+/// Events due within the next EVENT_WHEEL_SIZE GFs are stored in a ring of per-GF buckets (timing wheel),
+/// events further in the future are kept in an overflow map and moved into the wheel when their GF gets near.
+/// Events for the same GF are always executed in the order they were added.
 class EventManager
 {
 public:
@@ -38,6 +47,10 @@ public:
 
     unsigned GetNumActiveEvents() const { return numActiveEvents; }
     unsigned GetEventInstanceCtr() const { return eventInstanceCtr; }
+    /// Return the hash of all queued events. It is updated when events are added or removed
+    unsigned GetStateHash() const { return stateHash_.Get(); }
+    /// Calculate the hash of all queued events from scratch. Differs from GetStateHash if a change was missed
+    unsigned CalcStateHash() const;
 
     /// Increase the GF# and execute all events of that GF
     void ExecuteNextGF();
@@ -60,35 +73,81 @@ public:
 
     unsigned GetCurrentGF() const { return currentGF; }
 
-    /// Return true if the object has any active events. SLOW!
+    /// Return true if the object has any active events. Slow as it checks all events
     bool ObjectHasEvents(const GameObject& obj);
     /// Return true if the object will be destroyed after the current GF
     bool IsObjectInKillList(const GameObject& obj);
 
+    /// Construct a new event in the event memory pool. It still needs to be added to the queue or freed with FreeEvent
+    template<typename... T_Args>
+    GameEvent* MakeEvent(T_Args&&... args);
+    /// Return an event that is not (or no longer) in the queue to the memory pool
+    void FreeEvent(const GameEvent* event);
+
 protected:
-    // Use list to allow removing of events while iterating (Event A can cause Event B in the same GF to be removed)
-    using EventList = std::list<const GameEvent*>;
-    using EventMap = std::map<unsigned, EventList>;
+    /// Number of GFs covered by the timing wheel. Must be a power of 2
+    static constexpr unsigned EVENT_WHEEL_SIZE = 1024;
+    /// Events of one GF in the order they were added.
+    /// Removed events are set to nullptr to allow removing events while iterating (Event A can cause Event B in the same GF to be removed)
+    using EventBucket = std::vector<const GameEvent*>;
+    /// Events for GFs outside of the timing wheel. Mapping of GF to Events to be executed in this GF
+    using EventMap = std::map<unsigned, EventBucket>;
     // Use list to allow adding events while iterating (Destroying 1 object may lead to destruction of another)
     using GameObjList = std::list<GameObject*>;
     unsigned numActiveEvents;
     /// Instances created. Must be != 0
     unsigned eventInstanceCtr;
     unsigned currentGF;
-    EventMap events;      /// Mapping of GF to Events to be executed in this GF
+    /// Buckets for the GFs [currentGF, currentGF + EVENT_WHEEL_SIZE), indexed by GF % EVENT_WHEEL_SIZE
+    std::array<EventBucket, EVENT_WHEEL_SIZE> eventWheel;
+    /// Number of (not removed) events in the timing wheel
+    unsigned numEventsInWheel;
+    /// Events for GFs >= currentGF + EVENT_WHEEL_SIZE
+    EventMap farEvents;
     GameObjList killList; /// Objects that will be killed after current GF
     const GameEvent* curActiveEvent;
+    /// Memory for the GameEvent instances
+    boost::pool<> eventPool;
+    /// Hash of target GF, object and ID of all queued events
+    StateHash stateHash_;
 
     const GameEvent* AddEventToQueue(const GameEvent* event);
     void RemoveEventFromQueue(const GameEvent& event);
+    /// Set the current GF to the given one and move events that are now in the range of the timing wheel.
+    /// There must not be any events before newGF
+    void AdvanceToGF(unsigned newGF);
+    /// Return the GF of the next event (>= current GF) or 0 if there is none
+    unsigned GetNextEventGF() const;
     /// Execute all events of the current GF
     void ExecuteCurrentEvents();
-    /// Execute the events from the given iterator
-    void ExecuteEvents(const EventMap::iterator& itEvents);
     /// Destroy all objects in the kill list
     void DestroyCurrentObjects();
     /// Get all events in the order they will be processed
     std::vector<const GameEvent*> GetEvents() const;
+
+private:
+    EventBucket& GetWheelBucket(unsigned gf) { return eventWheel[gf & (EVENT_WHEEL_SIZE - 1)]; }
+    const EventBucket& GetWheelBucket(unsigned gf) const { return eventWheel[gf & (EVENT_WHEEL_SIZE - 1)]; }
+    bool IsInWheel(unsigned gf) const { return gf - currentGF < EVENT_WHEEL_SIZE; }
+    /// Call func for the events in the order they will be processed until it returns true. Return whether it did
+    template<class T_Func>
+    bool FindEvent(const T_Func& func) const;
 };
 
+template<typename... T_Args>
+GameEvent* EventManager::MakeEvent(T_Args&&... args)
+{
+    void* mem = eventPool.malloc();
+    if(!mem)
+        throw std::bad_alloc();
+    try
+    {
+        return new(mem) GameEvent(std::forward<T_Args>(args)...);
+    } catch(...)
+    {
+        eventPool.free(mem);
+        throw;
+    }
+}
+
 #endif // !EVENTMANAGER_H_INCLUDED
@@ -42,6 +42,8 @@ public:
     /// Does the remaining initializations for starting the game
     void Start(bool startFromSave);
     void RunGF();
+    /// Mark the game as started without running the start actions as the state was restored from an already running game
+    void SetStarted() { started_ = true; }
     bool IsStarted() const { return started_; }
     bool IsGameFinished() const { return finished_; }
     AIPlayer* GetAIPlayer(unsigned id);
@@ -378,10 +378,7 @@ template<class T_IsWarehouseGood>
 nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsWarehouseGood& isWarehouseGood, bool to_wh,
                                             bool use_boat_roads, unsigned* length, const RoadSegment* forbidden) const
 {
-    nobBaseWarehouse* best = nullptr;
-
-    unsigned best_length = std::numeric_limits<unsigned>::max();
-
+    std::vector<nobBaseWarehouse*> candidates;
     for(nobBaseWarehouse* wh : buildings.GetStorehouses())
     {
         // Lagerhaus geeignet?
@@ -396,21 +393,30 @@ nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsW
                 *length = 0;
             return wh;
         }
+        candidates.push_back(wh);
+    }
 
-        // now check if there is at least a chance that the next wh is closer than current best because pathfinding takes time
-        if(gwg.CalcDistance(start.GetPos(), wh->GetPos()) > best_length)
-            continue;
+    nobBaseWarehouse* best = nullptr;
+    unsigned best_length = std::numeric_limits<unsigned>::max();
+    RoadPathFinder& pathFinder = gwg.GetRoadPathFinder();
+    if(candidates.size() == 1u)
+    {
         // Bei der erlaubten Benutzung von Bootsstraßen Waren-Pathfinding benutzen wenns zu nem Lagerhaus gehn soll start <-> ziel tauschen
         // bei der wegfindung
+        nobBaseWarehouse* wh = candidates.front();
         unsigned tlength;
-        if(gwg.GetRoadPathFinder().FindPath(to_wh ? start : *wh, to_wh ? *wh : start, use_boat_roads, best_length, forbidden, &tlength))
+        if(pathFinder.FindPath(to_wh ? start : *wh, to_wh ? *wh : start, use_boat_roads, best_length, forbidden, &tlength))
         {
-            if(tlength < best_length || !best)
-            {
-                best_length = tlength;
-                best = wh;
-            }
+            best_length = tlength;
+            best = wh;
         }
+    } else if(!candidates.empty())
+    {
+        // Search all of them at once instead of one path search per warehouse
+        const std::vector<const noRoadNode*> goals(candidates.begin(), candidates.end());
+        unsigned bestIdx;
+        if(pathFinder.FindNearestGoal(start, goals, to_wh, use_boat_roads, forbidden, &bestIdx, &best_length))
+            best = candidates[bestIdx];
     }
 
     if(length)
@@ -446,6 +452,8 @@ void GamePlayer::AddBuilding(noBuilding* bld, BuildingType bldType)
 
     if(bldType == BLD_HARBORBUILDING)
     {
+        // New ship connections for wares
+        gwg.GetRoadPathFinder().InvalidateWarePaths(GetPlayerId());
         // Schiff durchgehen und denen Bescheid sagen
         for(noShip* ship : ships)
             ship->NewHarborBuilt(static_cast<nobHarborBuilding*>(bld));
@@ -466,7 +474,8 @@ void GamePlayer::RemoveBuilding(noBuilding* bld, BuildingType bldType)
     buildings.Remove(bld, bldType);
     ChangeStatisticValue(STAT_BUILDINGS, -1);
     if(bldType == BLD_HARBORBUILDING)
-    { // Schiffen Bescheid sagen
+    {
+        // Schiffen Bescheid sagen
         for(auto& ship : ships)
             ship->HarborDestroyed(static_cast<nobHarborBuilding*>(bld));
     } else if(bldType == BLD_HEADQUARTERS)
@@ -1048,6 +1057,17 @@ noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
     // sort our clients, highest score first
     std::sort(possibleClients.begin(), possibleClients.end());
 
+    // Calculate the path lengths to all clients at once when there is more than 1 (usually many wares start at the same node in a row)
+    // No path can be longer than needed for the client with the most points
+    RoadPathFinder& pathFinder = gwg.GetRoadPathFinder();
+    if(possibleClients.size() > 1u)
+    {
+        const auto itMaxPoints = std::max_element(possibleClients.begin(), possibleClients.end(),
+                                                  [](const ClientForWare& lhs, const ClientForWare& rhs) { return lhs.points < rhs.points; });
+        if(itMaxPoints->points)
+            pathFinder.CalcWarePathLengths(*start, itMaxPoints->points * 2 - 1);
+    }
+
     noBaseBuilding* lastBld = nullptr;
     noBaseBuilding* bestBld = nullptr;
     unsigned best_points = 0;
@@ -1073,8 +1093,7 @@ noBaseBuilding* GamePlayer::FindClientForWare(Ware* ware)
         // Find path ONLY if it may be better. Pathfinding is limited to the worst path score that would lead to a better score.
         // This eliminates the worst case scenario where all nodes in a split road network would be hit by the pathfinding only
         // to conclude that there is no possible path.
-        if(gwg.FindPathForWareOnRoads(*start, *possibleClient.bld, &path_length, nullptr, (possibleClient.points - best_points) * 2 - 1)
-           != 0xFF)
+        if(pathFinder.GetWarePathLength(*start, *possibleClient.bld, (possibleClient.points - best_points) * 2 - 1, &path_length))
         {
             unsigned score = possibleClient.points - (path_length / 2);
 
@@ -1119,6 +1138,11 @@ nobBaseMilitary* GamePlayer::FindClientForCoin(Ware* ware) const
     nobBaseMilitary* bb = nullptr;
     unsigned best_points = 0, points;
 
+    RoadPathFinder& pathFinder = gwg.GetRoadPathFinder();
+    // The paths to all military buildings are needed
+    if(buildings.GetMilitaryBuildings().size() > 1u)
+        pathFinder.CalcWarePathLengths(*ware->GetLocation(), std::numeric_limits<unsigned>::max());
+
     // Militärgebäude durchgehen
     for(nobMilitary* milBld : buildings.GetMilitaryBuildings())
     {
@@ -1129,7 +1153,7 @@ nobBaseMilitary* GamePlayer::FindClientForCoin(Ware* ware) const
         if(points)
         {
             // Weg dorthin berechnen
-            if(gwg.FindPathForWareOnRoads(*ware->GetLocation(), *milBld, &way_points) != 0xFF)
+            if(pathFinder.GetWarePathLength(*ware->GetLocation(), *milBld, std::numeric_limits<unsigned>::max(), &way_points))
             {
                 // Die Wegpunkte noch davon abziehen
                 points -= way_points;
@@ -113,6 +113,7 @@ void GlobalGameSettings::registerAllAddons()
     registerAddon(std::make_unique<AddonFrontierDistanceReachable>());
     registerAddon(std::make_unique<AddonCoinsCapturedBld>());
     registerAddon(std::make_unique<AddonDemolishBldWORes>());
+    registerAddon(std::make_unique<AddonHierarchicalPathfinding>());
 }
 
 void GlobalGameSettings::resetAddons()
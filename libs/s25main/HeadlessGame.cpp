@@ -0,0 +1,261 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "HeadlessGame.h"
+#include "EventManager.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "Replay.h"
+#include "Savegame.h"
+#include "SerializedGameData.h"
+#include "ai/AIPlayer.h"
+#include "ai/AIRunner.h"
+#include "factories/AIFactory.h"
+#include "network/PlayerGameCommands.h"
+#include "random/Random.h"
+#include "world/GameWorld.h"
+#include "gameTypes/MapInfo.h"
+#include "s25util/Log.h"
+#include <boost/filesystem/operations.hpp>
+
+namespace bfs = boost::filesystem;
+
+HeadlessGame::HeadlessGame(unsigned numAIThreads)
+    : aiRunner_(std::make_unique<AIRunner>(numAIThreads)), nextReplayGF_(0), numAsyncGFs_(0), verifyStateHashes_(false),
+      numStateHashErrors_(0)
+{}
+
+HeadlessGame::~HeadlessGame()
+{
+    // Objects must be destroyed before the temporary files (e.g. the lua script)
+    game_.reset();
+    if(!tmpDir_.empty())
+    {
+        boost::system::error_code ec;
+        bfs::remove_all(tmpDir_, ec);
+    }
+}
+
+bool HeadlessGame::LoadReplay(const std::string& filePath)
+{
+    RTTR_Assert(!game_);
+    replay_ = std::make_unique<Replay>();
+    MapInfo mapInfo;
+    if(!replay_->LoadHeader(filePath, true) || !replay_->LoadGameData(mapInfo))
+    {
+        lastErrorMsg_ = replay_->GetLastErrorMsg();
+        replay_.reset();
+        return false;
+    }
+
+    if(mapInfo.type == MAPTYPE_OLDMAP)
+    {
+        tmpDir_ = bfs::temp_directory_path() / bfs::unique_path("rttr-%%%%-%%%%-%%%%");
+        boost::system::error_code ec;
+        bfs::create_directories(tmpDir_, ec);
+        bfs::path mapFilePath = tmpDir_ / bfs::path(mapInfo.filepath).filename();
+        mapInfo.filepath = mapFilePath.string();
+        if(ec || !mapInfo.mapData.DecompressToFile(mapInfo.filepath))
+        {
+            lastErrorMsg_ = "Error decompressing map file";
+            return false;
+        }
+        if(mapInfo.luaData.length)
+        {
+            mapInfo.luaFilepath = mapFilePath.replace_extension("lua").string();
+            if(!mapInfo.luaData.DecompressToFile(mapInfo.luaFilepath))
+            {
+                lastErrorMsg_ = "Error decompressing lua file";
+                return false;
+            }
+        }
+    }
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < replay_->GetNumPlayers(); ++i)
+        players.push_back(PlayerInfo(replay_->GetPlayer(i)));
+
+    RANDOM.Init(replay_->random_init);
+    if(!StartGame(replay_->ggs, players, mapInfo))
+        return false;
+    replay_->ReadGF(&nextReplayGF_);
+    return true;
+}
+
+bool HeadlessGame::LoadSavegame(const std::string& filePath, unsigned randomSeed)
+{
+    RTTR_Assert(!game_);
+    MapInfo mapInfo;
+    mapInfo.type = MAPTYPE_SAVEGAME;
+    mapInfo.savegame = std::make_unique<Savegame>();
+    if(!mapInfo.savegame->Load(filePath, true, true))
+    {
+        lastErrorMsg_ = mapInfo.savegame->GetLastErrorMsg();
+        return false;
+    }
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < mapInfo.savegame->GetNumPlayers(); ++i)
+        players.push_back(PlayerInfo(mapInfo.savegame->GetPlayer(i)));
+
+    RANDOM.Init(randomSeed);
+    if(!StartGame(mapInfo.savegame->ggs, players, mapInfo))
+        return false;
+
+    // Nobody is playing so let the AI take over the human players too
+    for(unsigned id = 0; id < game_->world_.GetNumPlayers(); ++id)
+    {
+        const GamePlayer& player = game_->world_.GetPlayer(id);
+        if(player.isUsed())
+            game_->AddAIPlayer(AIFactory::Create(player.isHuman() ? AI::Info(AI::DEFAULT, AI::HARD) : player.aiInfo, id, game_->world_));
+    }
+    pendingAICmds_.resize(game_->aiPlayers_.size());
+    return true;
+}
+
+bool HeadlessGame::StartGame(const GlobalGameSettings& ggs, const std::vector<PlayerInfo>& players, MapInfo& mapInfo)
+{
+    const unsigned startGF = (mapInfo.type == MAPTYPE_SAVEGAME) ? mapInfo.savegame->start_gf : 0;
+    game_ = std::make_shared<Game>(ggs, startGF, players);
+    GameWorld& gameWorld = game_->world_;
+    if(mapInfo.savegame)
+    {
+        try
+        {
+            mapInfo.savegame->sgd.ReadSnapshot(game_);
+        } catch(SerializedGameData::Error& error)
+        {
+            lastErrorMsg_ = error.what();
+            game_.reset();
+            return false;
+        }
+    } else if(!gameWorld.SetupNewGame(game_, mapInfo.filepath, mapInfo.luaFilepath))
+    {
+        lastErrorMsg_ = "Could not load map " + mapInfo.filepath;
+        game_.reset();
+        return false;
+    }
+    gameWorld.InitAfterLoad();
+    game_->Start(!!mapInfo.savegame);
+    return true;
+}
+
+void HeadlessGame::RunGF()
+{
+    RTTR_Assert(game_);
+    const bool isNWF = !replay_;
+    if(replay_)
+        ExecuteReplayCmds();
+    else
+        ExecuteAICmds();
+
+    aiRunner_->RunGF(game_->aiPlayers_, GetGFNumber(), isNWF);
+    // Nobody to read them
+    for(AIPlayer& ai : game_->aiPlayers_)
+        ai.FetchChatMessages();
+    game_->RunGF();
+    if(verifyStateHashes_)
+        VerifyStateHashes();
+}
+
+void HeadlessGame::VerifyStateHashes()
+{
+    const std::string wrongParts = AsyncChecksum::checkStateHashes(*game_);
+    if(wrongParts.empty())
+        return;
+    if(numStateHashErrors_ == 0)
+        LOG.write("Untracked change of the state hash at GF %u in %s\n") % GetGFNumber() % wrongParts;
+    numStateHashErrors_++;
+}
+
+void HeadlessGame::ExecuteReplayCmds()
+{
+    const AsyncChecksum checksum = AsyncChecksum::create(*game_);
+    const unsigned curGF = GetGFNumber();
+    bool isAsync = false;
+    while(nextReplayGF_ == curGF)
+    {
+        switch(replay_->ReadRCType())
+        {
+            case Replay::RC_CHAT:
+            {
+                uint8_t player, dest;
+                std::string message;
+                replay_->ReadChatCommand(player, dest, message);
+                break;
+            }
+            case Replay::RC_GAME:
+            {
+                PlayerGameCommands msg;
+                uint8_t gcPlayer;
+                replay_->ReadGameCommand(gcPlayer, msg);
+                for(const gc::GameCommandPtr& gc : msg.gcs)
+                    gc->Execute(game_->world_, gcPlayer);
+                const std::string divergentParts = msg.checksum.randChecksum != 0 ? msg.checksum.getDivergentParts(checksum) : "";
+                if(!divergentParts.empty() && !isAsync)
+                {
+                    if(numAsyncGFs_ == 0)
+                    {
+                        LOG.write("Async at GF %u in %s: Checksum %i:%i ObjCt %u:%u ObjIdCt %u:%u\n") % curGF % divergentParts
+                          % msg.checksum.randChecksum % checksum.randChecksum % msg.checksum.objCt % checksum.objCt % msg.checksum.objIdCt
+                          % checksum.objIdCt;
+                        if(!asyncLogPath_.empty())
+                            RANDOM.SaveLog(asyncLogPath_);
+                    }
+                    isAsync = true;
+                    numAsyncGFs_++;
+                }
+                break;
+            }
+            case Replay::RC_KEYFRAME:
+            case Replay::RC_KEYFRAMEDATA: replay_->SkipKeyframe(); break;
+            default: break;
+        }
+        replay_->ReadGF(&nextReplayGF_);
+    }
+}
+
+void HeadlessGame::ExecuteAICmds()
+{
+    // Commands of the last NWF get executed now, then the AIs can create new ones
+    for(unsigned i = 0; i < game_->aiPlayers_.size(); ++i)
+    {
+        AIPlayer& ai = game_->aiPlayers_[i];
+        for(const gc::GameCommandPtr& gc : pendingAICmds_[i])
+            gc->Execute(game_->world_, ai.GetPlayerId());
+        pendingAICmds_[i] = ai.FetchGameCommands();
+    }
+}
+
+bool HeadlessGame::IsFinished() const
+{
+    if(replay_)
+        return GetGFNumber() > replay_->GetLastGF();
+    return game_->IsGameFinished();
+}
+
+unsigned HeadlessGame::GetGFNumber() const
+{
+    return game_->em_->GetCurrentGF();
+}
+
+AsyncChecksum HeadlessGame::GetChecksum() const
+{
+    return AsyncChecksum::create(*game_);
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef HeadlessGame_h__
+#define HeadlessGame_h__
+
+#include "AsyncChecksum.h"
+#include "GameCommand.h"
+#include <boost/filesystem/path.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+class AIRunner;
+class Game;
+class GlobalGameSettings;
+class MapInfo;
+struct PlayerInfo;
+class Replay;
+
+/// Runs a game from a replay or savegame without GUI, drivers and frame timing.
+/// Used to measure and verify the simulation itself
+class HeadlessGame
+{
+public:
+    /// Run the AIs with at most the given number of threads (0 = number of hardware threads)
+    explicit HeadlessGame(unsigned numAIThreads = 0);
+    ~HeadlessGame();
+
+    /// Load a replay whose commands get executed during the run. Return false on error
+    bool LoadReplay(const std::string& filePath);
+    /// Load a savegame and continue it with AIs for all players (humans get a hard AI)
+    bool LoadSavegame(const std::string& filePath, unsigned randomSeed);
+
+    /// Save the log of the game RNG to this file when the replay gets asynchronous
+    void SetAsyncLogPath(const std::string& filePath) { asyncLogPath_ = filePath; }
+    /// Recalculate the state hashes after every GF to find changes of the game state which are not tracked by them
+    void SetVerifyStateHashes(bool verify) { verifyStateHashes_ = verify; }
+
+    /// Run a single GF including the commands for it
+    void RunGF();
+    /// True when the last GF of the replay was run or the objective of the game was reached
+    bool IsFinished() const;
+
+    unsigned GetGFNumber() const;
+    AsyncChecksum GetChecksum() const;
+    /// Number of GFs at which the replay was asynchronous to the recorded game
+    unsigned GetNumAsyncGFs() const { return numAsyncGFs_; }
+    /// Number of GFs after which the state hashes did not match a recalculation (only if verification is enabled)
+    unsigned GetNumStateHashErrors() const { return numStateHashErrors_; }
+    const std::string& GetLastErrorMsg() const { return lastErrorMsg_; }
+    const Game& GetGame() const { return *game_; }
+
+private:
+    bool StartGame(const GlobalGameSettings& ggs, const std::vector<PlayerInfo>& players, MapInfo& mapInfo);
+    void ExecuteReplayCmds();
+    void ExecuteAICmds();
+    void VerifyStateHashes();
+
+    std::shared_ptr<Game> game_;
+    std::unique_ptr<Replay> replay_;
+    std::unique_ptr<AIRunner> aiRunner_;
+    /// GF of the next command in the replay
+    unsigned nextReplayGF_;
+    unsigned numAsyncGFs_;
+    bool verifyStateHashes_;
+    unsigned numStateHashErrors_;
+    /// Commands fetched from each AI in the last NWF, executed in the next one like over the network
+    std::vector<std::vector<gc::GameCommandPtr>> pendingAICmds_;
+    /// Temporary folder for the map and lua script of a replay
+    boost::filesystem::path tmpDir_;
+    std::string asyncLogPath_;
+    std::string lastErrorMsg_;
+};
+
+#endif // HeadlessGame_h__
@@ -61,9 +61,55 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 using namespace std::chrono;
 
+namespace {
+/// FNV-1a hash used to detect changes of the loaded files
+class FilesHash
+{
+    uint64_t value_ = 14695981039346656037u;
+
+public:
+    void add(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < size; i++)
+        {
+            value_ ^= bytes[i];
+            value_ *= 1099511628211u;
+        }
+    }
+    void add(const std::string& value) { add(value.data(), value.size()); }
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported");
+        add(&value, sizeof(value));
+    }
+    /// Add path, size and modification time of the file or of all files in the directory
+    void addFile(const bfs::path& filePath)
+    {
+        add(filePath.string());
+        boost::system::error_code ec;
+        if(!bfs::is_directory(filePath, ec))
+        {
+            add(static_cast<uint64_t>(bfs::file_size(filePath, ec)));
+            add(static_cast<int64_t>(bfs::last_write_time(filePath, ec)));
+            return;
+        }
+        std::vector<bfs::path> entries;
+        for(const auto& it : bfs::directory_iterator(filePath, ec))
+            entries.push_back(it.path());
+        std::sort(entries.begin(), entries.end());
+        for(const bfs::path& entry : entries)
+            addFile(entry);
+    }
+    uint64_t get() const { return value_; }
+};
+} // namespace
+
 Loader::Loader(Log& logger, const RttrConfig& config)
     : logger_(logger), config_(config), isWinterGFX_(false), map_gfx(nullptr), stp(nullptr)
 {
@@ -809,12 +855,32 @@ void Loader::fillCaches()
 
     if(SETTINGS.video.shared_textures)
     {
-        // generate mega texture
-        stp->pack();
+        // Use the textures from the last run if nothing changed, else generate mega texture
+        const std::string cachePath = config_.ExpandPath(FILE_PATHS[97]) + "/textures.dat";
+        const uint64_t cacheKey = CalcTextureCacheKey();
+        if(stp->load(cachePath, cacheKey))
+            logger_.write(_("Loaded packed textures from %s\n")) % cachePath;
+        else if(stp->pack(true) && !stp->save(cachePath, cacheKey))
+            logger_.write(_("Failed to save packed textures to %s\n")) % cachePath;
     } else
         stp.reset();
 }
 
+uint64_t Loader::CalcTextureCacheKey() const
+{
+    FilesHash hash;
+    for(const auto& it : files_)
+    {
+        hash.add(it.first);
+        hash.add(it.second.filesHash);
+        // Which of the archives are used for the map and the nations is relevant too
+        hash.add(&it.second.archiv == map_gfx);
+        hash.add(helpers::contains(nation_gfx, &it.second.archiv));
+    }
+    hash.add(isWinterGFX_);
+    return hash.get();
+}
+
 /**
  *  Extrahiert eine Textur aus den Daten.
  */
@@ -965,6 +1031,10 @@ bool Loader::LoadFile(const std::string& pfad, const libsiedler2::ArchivItem_Pal
         if(!LoadFile(entry.archiv, pfad, palette))
             return false;
         entry.loadedAfterOverrideChange = true;
+        FilesHash hash;
+        for(const std::string& filePath : GetFilesToLoad(pfad))
+            hash.addFile(filePath);
+        entry.filesHash = hash.get();
     }
     return true;
 }
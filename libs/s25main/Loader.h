@@ -72,6 +72,8 @@ class Loader
         /// List of files used to build this archiv
         std::vector<std::string> filesUsed;
         bool loadedAfterOverrideChange;
+        /// Hash of the paths, sizes and modification times of the files loaded into the archiv
+        uint64_t filesHash = 0;
     };
     struct OverrideFolder
     {
@@ -179,6 +181,8 @@ private:
     bool LoadArchiv(libsiedler2::Archiv& archiv, const std::string& pfad, const libsiedler2::ArchivItem_Palette* palette = nullptr);
     bool LoadOverrideDirectory(const std::string& path);
     bool LoadFilesFromArray(const std::vector<unsigned>& files);
+    /// Key for the cache of the packed textures. Changes when the used files change
+    uint64_t CalcTextureCacheKey() const;
 
     template<typename T>
     static T convertChecked(libsiedler2::ArchivItem* item)
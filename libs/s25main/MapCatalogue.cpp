@@ -0,0 +1,226 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "MapCatalogue.h"
+#include "helpers/runParallel.h"
+#include "ogl/glArchivItem_Map.h"
+#include "libsiedler2/ArchivItem_Map_Header.h"
+#include "s25util/BinaryFile.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+constexpr std::array<char, 8> indexSignature = {{'R', 'T', 'T', 'R', 'M', 'I', 'D', 'X'}};
+constexpr uint16_t indexVersion = 1;
+
+void writeUInt64(BinaryFile& file, uint64_t value)
+{
+    file.WriteUnsignedInt(static_cast<uint32_t>(value));
+    file.WriteUnsignedInt(static_cast<uint32_t>(value >> 32));
+}
+
+uint64_t readUInt64(BinaryFile& file)
+{
+    const uint64_t low = file.ReadUnsignedInt();
+    return low | (static_cast<uint64_t>(file.ReadUnsignedInt()) << 32);
+}
+
+/// Set size and modification time of the file. Return false if it does not exist
+bool readFileStatus(MapCatalogue::Entry& entry)
+{
+    boost::system::error_code ec;
+    entry.fileSize = bfs::file_size(entry.filePath, ec);
+    if(ec)
+        return false;
+    entry.lastWriteTime = bfs::last_write_time(entry.filePath, ec);
+    return !ec;
+}
+} // namespace
+
+MapCatalogue::MapCatalogue(std::string indexFilePath) : indexFilePath_(std::move(indexFilePath)), changed_(false) {}
+
+bool MapCatalogue::Load()
+{
+    std::unordered_map<std::string, Entry> entries;
+    BinaryFile file;
+    if(!file.Open(indexFilePath_, OFM_READ))
+        return false;
+    try
+    {
+        std::array<char, indexSignature.size()> signature;
+        file.ReadRawData(&signature[0], signature.size());
+        if(signature != indexSignature || file.ReadUnsignedShort() != indexVersion)
+            return false;
+        const unsigned numEntries = file.ReadUnsignedInt();
+        entries.reserve(numEntries);
+        for(unsigned i = 0; i < numEntries; i++)
+        {
+            Entry entry;
+            entry.filePath = file.ReadLongString();
+            entry.fileSize = readUInt64(file);
+            entry.lastWriteTime = static_cast<int64_t>(readUInt64(file));
+            entry.isValid = file.ReadUnsignedChar() != 0;
+            entry.name = file.ReadShortString();
+            entry.author = file.ReadShortString();
+            entry.width = file.ReadUnsignedShort();
+            entry.height = file.ReadUnsignedShort();
+            entry.numPlayers = file.ReadUnsignedChar();
+            entry.gfxSet = file.ReadUnsignedChar();
+            std::string filePath = entry.filePath;
+            entries.emplace(std::move(filePath), std::move(entry));
+        }
+    } catch(std::runtime_error&)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_ = std::move(entries);
+    changed_ = false;
+    return true;
+}
+
+bool MapCatalogue::Save()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(!changed_)
+        return true;
+
+    boost::system::error_code ec;
+    bfs::create_directories(bfs::path(indexFilePath_).parent_path(), ec);
+    BinaryFile file;
+    if(!file.Open(indexFilePath_, OFM_WRITE))
+        return false;
+    file.WriteRawData(&indexSignature[0], indexSignature.size());
+    file.WriteUnsignedShort(indexVersion);
+    file.WriteUnsignedInt(static_cast<uint32_t>(entries_.size()));
+    for(const auto& it : entries_)
+    {
+        const Entry& entry = it.second;
+        file.WriteLongString(entry.filePath);
+        writeUInt64(file, entry.fileSize);
+        writeUInt64(file, static_cast<uint64_t>(entry.lastWriteTime));
+        file.WriteUnsignedChar(entry.isValid ? 1 : 0);
+        file.WriteShortString(entry.name);
+        file.WriteShortString(entry.author);
+        file.WriteUnsignedShort(entry.width);
+        file.WriteUnsignedShort(entry.height);
+        file.WriteUnsignedChar(entry.numPlayers);
+        file.WriteUnsignedChar(entry.gfxSet);
+    }
+    changed_ = false;
+    return true;
+}
+
+std::vector<MapCatalogue::Entry> MapCatalogue::Update(const std::vector<std::string>& filePaths, unsigned numThreads,
+                                                      const std::atomic<bool>* abort)
+{
+    if(numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<Entry> result(filePaths.size());
+    helpers::runParallel(numThreads, static_cast<unsigned>(filePaths.size()), [&](unsigned i) {
+        if(abort && *abort)
+            return;
+        Entry& entry = result[i];
+        entry.filePath = filePaths[i];
+        // Vanished files stay invalid and are removed
+        if(!readFileStatus(entry))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(entries_.erase(entry.filePath))
+                changed_ = true;
+            return;
+        }
+        bool isCurrent = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = entries_.find(entry.filePath);
+            if(it != entries_.end() && it->second.fileSize == entry.fileSize && it->second.lastWriteTime == entry.lastWriteTime)
+            {
+                entry = it->second;
+                isCurrent = true;
+            }
+        }
+        if(!isCurrent)
+        {
+            entry = ReadEntry(filePaths[i]);
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_[entry.filePath] = entry;
+            changed_ = true;
+        }
+        boost::system::error_code ec;
+        entry.hasLua = bfs::is_regular_file(bfs::path(entry.filePath).replace_extension("lua"), ec);
+    });
+    if(abort && *abort)
+        result.clear();
+    return result;
+}
+
+void MapCatalogue::RemoveMissing(const std::vector<std::string>& folders, const std::vector<std::string>& filePaths)
+{
+    const std::unordered_set<std::string> existingFiles(filePaths.begin(), filePaths.end());
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(auto it = entries_.begin(); it != entries_.end();)
+    {
+        const bfs::path fileName = bfs::path(it->first).filename();
+        // Build the path the same way a directory listing does to check if the file is in one of the folders
+        const bool isInFolders = std::any_of(folders.begin(), folders.end(), [&](const std::string& folder) {
+            return (bfs::path(folder) / fileName).make_preferred().string() == it->first;
+        });
+        if(isInFolders && !existingFiles.count(it->first))
+        {
+            it = entries_.erase(it);
+            changed_ = true;
+        } else
+            ++it;
+    }
+}
+
+size_t MapCatalogue::GetNumEntries() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+MapCatalogue::Entry MapCatalogue::ReadEntry(const std::string& filePath)
+{
+    Entry entry;
+    entry.filePath = filePath;
+    if(!readFileStatus(entry))
+        return entry;
+    glArchivItem_Map map;
+    bnw::ifstream file(filePath, std::ios::binary);
+    if(!file || map.load(file, true) != 0)
+        return entry;
+    const libsiedler2::ArchivItem_Map_Header& header = map.getHeader();
+    entry.isValid = true;
+    entry.name = header.getName();
+    entry.author = header.getAuthor();
+    entry.width = header.getWidth();
+    entry.height = header.getHeight();
+    entry.numPlayers = header.getNumPlayers();
+    entry.gfxSet = header.getGfxSet();
+    return entry;
+}
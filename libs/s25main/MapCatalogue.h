@@ -0,0 +1,76 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef MapCatalogue_h__
+#define MapCatalogue_h__
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Persistent index of map files containing the header data needed to list them.
+/// Only files which are new or changed (by size or modification time) need to be parsed.
+/// All functions are thread safe
+class MapCatalogue
+{
+public:
+    struct Entry
+    {
+        std::string filePath;
+        uint64_t fileSize = 0;
+        int64_t lastWriteTime = 0;
+        /// False if the header could not be read
+        bool isValid = false;
+        /// Name and author as stored in the file (ANSI)
+        std::string name, author;
+        uint16_t width = 0, height = 0;
+        uint8_t numPlayers = 0, gfxSet = 0;
+        /// Whether a lua script exists next to the map. Checked on every update, not stored
+        bool hasLua = false;
+    };
+
+    explicit MapCatalogue(std::string indexFilePath);
+
+    /// Load the stored index replacing the current entries. Return false if it does not exist or is invalid
+    bool Load();
+    /// Write the index if it was changed since the last load or save
+    bool Save();
+
+    /// Return the entries of the given files in the same order. Files not in the index or changed since get their header read
+    /// using up to numThreads threads (0 = all cores). If abort gets set the remaining files are skipped and an empty list is returned
+    std::vector<Entry> Update(const std::vector<std::string>& filePaths, unsigned numThreads = 0,
+                              const std::atomic<bool>* abort = nullptr);
+    /// Remove the entries of files directly inside one of the folders which are not in filePaths (deleted or renamed)
+    void RemoveMissing(const std::vector<std::string>& folders, const std::vector<std::string>& filePaths);
+    size_t GetNumEntries() const;
+
+    /// Read the header of the map file without using the index
+    static Entry ReadEntry(const std::string& filePath);
+
+private:
+    const std::string indexFilePath_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    bool changed_;
+};
+
+#endif // MapCatalogue_h__
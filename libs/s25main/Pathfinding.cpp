@@ -16,13 +16,18 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "rttrDefines.h" // IWYU pragma: keep
+#include "EventManager.h"
 #include "GamePlayer.h"
+#include "GlobalGameSettings.h"
+#include "addons/const_addons.h"
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/HierarchicalPathFinder.h"
 #include "pathfinding/PathConditionHuman.h"
 #include "pathfinding/PathConditionShip.h"
 #include "pathfinding/PathConditionTrade.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ShipDistanceFields.h"
 #include "world/GameWorldGame.h"
 #include "gameTypes/ShipDirection.h"
 #include "gameData/GameConsts.h"
@@ -32,6 +37,11 @@ unsigned char GameWorldBase::FindHumanPath(const MapPoint start, const MapPoint
                                            unsigned* length, std::vector<Direction>* route) const
 {
     Direction first_dir(Direction::NORTHEAST);
+    // Long paths can be found much faster on the cluster abstraction. If that fails there might still be a path so do the full search
+    if(!random_route && GetGGS().isEnabled(AddonId::HIERARCHICAL_PATHFINDING)
+       && CalcDistance(start, dest) >= HierarchicalPathFinder::MIN_DISTANCE
+       && hierarchicalPathFinder->FindHumanPath(start, dest, max_route, route, length, &first_dir))
+        return first_dir.toUInt();
     if(GetFreePathFinder().FindPath(start, dest, random_route, max_route, route, length, &first_dir, PathConditionHuman(*this)))
         return first_dir.toUInt();
     else
@@ -61,23 +71,32 @@ unsigned char GameWorldGame::FindPathForWareOnRoads(const noRoadNode& start, con
 }
 
 bool GameWorldBase::FindShipPathToHarbor(const MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route,
-                                         unsigned* length)
+                                         unsigned* length, unsigned maxDistance)
 {
-    // Find the distance to the furthest harbor from the target harbor and take that as maximum
-    unsigned maxDistance = 0;
-
-    for(int iDir = 0; iDir < ShipDirection::COUNT; iDir++)
+    if(!maxDistance)
     {
-        const std::vector<HarborPos::Neighbor>& neighbors = GetHarborNeighbors(harborId, ShipDirection::fromInt(iDir));
-        for(const HarborPos::Neighbor& neighbor : neighbors)
+        // Find the distance to the furthest harbor from the target harbor and take that as maximum
+        for(int iDir = 0; iDir < ShipDirection::COUNT; iDir++)
         {
-            if(IsHarborAtSea(neighbor.id, seaId) && neighbor.distance > maxDistance)
-                maxDistance = neighbor.distance;
+            const std::vector<HarborPos::Neighbor>& neighbors = GetHarborNeighbors(harborId, ShipDirection::fromInt(iDir));
+            for(const HarborPos::Neighbor& neighbor : neighbors)
+            {
+                if(IsHarborAtSea(neighbor.id, seaId) && neighbor.distance > maxDistance)
+                    maxDistance = neighbor.distance;
+            }
         }
+        // Add a few fields reserve
+        maxDistance += 6;
+    }
+    const MapPoint coastalPt = GetCoastalPoint(harborId, seaId);
+    // Seas don't change, so walk along the precalculated distances unless they would use too much memory
+    if(maxDistance < ShipDistanceFields::MAX_LENGTH && shipDistanceFields->IsUsable())
+    {
+        // Same variation of equally long paths as the random route of the FreePathFinder
+        const unsigned firstDir = GetIdx(start) * GetEvMgr().GetCurrentGF() % Direction::COUNT;
+        return shipDistanceFields->FindPath(start, coastalPt, maxDistance, firstDir, route, length);
     }
-    // Add a few fields reserve
-    maxDistance += 6;
-    return FindShipPath(start, GetCoastalPoint(harborId, seaId), maxDistance, route, length);
+    return FindShipPath(start, coastalPt, maxDistance, route, length);
 }
 
 bool GameWorldBase::FindShipPath(const MapPoint start, const MapPoint dest, unsigned maxDistance, std::vector<Direction>* route,
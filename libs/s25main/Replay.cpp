@@ -21,9 +21,19 @@
 #include "network/PlayerGameCommands.h"
 #include "gameTypes/MapInfo.h"
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <memory>
 #include <mygettext/mygettext.h>
 
+namespace {
+/// GF value marking the end of the commands (followed by the keyframe index)
+constexpr unsigned END_GF = 0xFFFFFFFF;
+/// Identifier at the end of the file after the position of the keyframe index
+constexpr std::array<char, 4> KEYFRAME_INDEX_ID = {{'K', 'F', 'I', 'X'}};
+} // namespace
+
 std::string Replay::GetSignature() const
 {
     return "RTTRRP2";
@@ -32,12 +42,18 @@ std::string Replay::GetSignature() const
 uint16_t Replay::GetVersion() const
 {
     /// Version des Replay-Formates
+    return 7;
+}
+
+uint16_t Replay::GetMinVersion() const
+{
+    // Version 6 is the same without the state hashes in the checksums, version 5 also without keyframes
     return 5;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Replay::Replay() : random_init(0), isRecording(false), lastGF_(0), last_gf_file_pos(0), mapType_(MAPTYPE_OLDMAP) {}
+Replay::Replay() : random_init(0), isRecording(false), lastGF_(0), last_gf_file_pos(0), mapType_(MAPTYPE_OLDMAP), lastRecordGF_(0) {}
 
 Replay::~Replay()
 {
@@ -46,12 +62,18 @@ Replay::~Replay()
 
 void Replay::Close()
 {
-    file.Close();
+    StopRecording();
     ClearPlayers();
+    keyframes_.clear();
 }
 
 void Replay::StopRecording()
 {
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    // Keyframes without data are not indexed
+    pendingKeyframes_.clear();
+    if(IsRecording())
+        WriteKeyframeIndex();
     file.Close();
     isRecording = false;
 }
@@ -66,6 +88,9 @@ bool Replay::StartRecording(const std::string& filename, const MapInfo& mapInfo)
         return false;
 
     isRecording = true;
+    keyframes_.clear();
+    pendingKeyframes_.clear();
+    lastRecordGF_ = 0;
     /// End-GF (erstmal nur 0, wird dann im Spiel immer geupdatet)
     lastGF_ = 0;
     mapType_ = mapInfo.type;
@@ -188,6 +213,7 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
                 }
                 break;
         }
+        LoadKeyframes();
     } catch(std::runtime_error& e)
     {
         lastErrorMsg = e.what();
@@ -199,10 +225,12 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
 void Replay::AddChatCommand(unsigned gf, uint8_t player, uint8_t dest, const std::string& str)
 {
     RTTR_Assert(IsRecording());
+    std::lock_guard<std::mutex> lock(recordMutex_);
     if(!file.IsValid())
         return;
 
     file.WriteUnsignedInt(gf);
+    lastRecordGF_ = std::max(lastRecordGF_, gf);
 
     file.WriteUnsignedChar(RC_CHAT);
     file.WriteUnsignedChar(player);
@@ -216,10 +244,12 @@ void Replay::AddChatCommand(unsigned gf, uint8_t player, uint8_t dest, const std
 void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
 {
     RTTR_Assert(IsRecording());
+    std::lock_guard<std::mutex> lock(recordMutex_);
     if(!file.IsValid())
         return;
 
     file.WriteUnsignedInt(gf);
+    lastRecordGF_ = std::max(lastRecordGF_, gf);
 
     file.WriteUnsignedChar(RC_GAME);
     Serializer ser;
@@ -231,6 +261,217 @@ void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommand
     file.Flush();
 }
 
+void Replay::AddKeyframe(unsigned gf)
+{
+    RTTR_Assert(IsRecording());
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    if(!file.IsValid())
+        return;
+
+    file.WriteUnsignedInt(gf);
+    lastRecordGF_ = std::max(lastRecordGF_, gf);
+
+    file.WriteUnsignedChar(RC_KEYFRAME);
+    // Empty, the data follows later
+    file.WriteUnsignedInt(0);
+    pendingKeyframes_.push_back(Keyframe{gf, file.Tell(), 0});
+
+    file.Flush();
+}
+
+void Replay::AddKeyframeData(unsigned gf, Savegame& save, const UsedPRNG& rngState)
+{
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    const auto itPending =
+      std::find_if(pendingKeyframes_.begin(), pendingKeyframes_.end(), [gf](const Keyframe& keyframe) { return keyframe.gf == gf; });
+    // Recording might have been stopped already
+    if(!IsRecording() || itPending == pendingKeyframes_.end())
+        return;
+    Keyframe keyframe = *itPending;
+    pendingKeyframes_.erase(itPending);
+
+    // Readers expect non-decreasing GFs, so this is stored with the GF of the last command
+    file.WriteUnsignedInt(lastRecordGF_);
+
+    file.WriteUnsignedChar(RC_KEYFRAMEDATA);
+    keyframe.dataPos = file.Tell();
+    // Length gets written when known
+    file.WriteUnsignedInt(0);
+    file.WriteUnsignedInt(gf);
+    Serializer ser;
+    rngState.serialize(ser);
+    ser.WriteToFile(file);
+    save.Save(file, GetMapName());
+    const unsigned endPos = file.Tell();
+    file.Seek(keyframe.dataPos, SEEK_SET);
+    file.WriteUnsignedInt(endPos - keyframe.dataPos - sizeof(uint32_t));
+    file.Seek(0, SEEK_END);
+    keyframes_.insert(std::upper_bound(keyframes_.begin(), keyframes_.end(), keyframe,
+                                       [](const Keyframe& lhs, const Keyframe& rhs) { return lhs.gf < rhs.gf; }),
+                      keyframe);
+
+    file.Flush();
+}
+
+void Replay::WriteKeyframeIndex()
+{
+    const unsigned indexPos = file.Tell();
+    file.WriteUnsignedInt(END_GF);
+    file.WriteUnsignedChar(RC_REPLAYEND);
+    file.WriteUnsignedInt(keyframes_.size());
+    for(const Keyframe& keyframe : keyframes_)
+    {
+        file.WriteUnsignedInt(keyframe.gf);
+        file.WriteUnsignedInt(keyframe.cmdPos);
+        file.WriteUnsignedInt(keyframe.dataPos);
+    }
+    file.WriteUnsignedInt(indexPos);
+    file.WriteRawData(KEYFRAME_INDEX_ID.data(), KEYFRAME_INDEX_ID.size());
+}
+
+void Replay::LoadKeyframes()
+{
+    keyframes_.clear();
+    const unsigned cmdsStartPos = file.Tell();
+    file.Seek(0, SEEK_END);
+    const unsigned fileSize = file.Tell();
+
+    const unsigned trailerSize = sizeof(uint32_t) + KEYFRAME_INDEX_ID.size();
+    if(fileSize >= cmdsStartPos + trailerSize)
+    {
+        file.Seek(fileSize - trailerSize, SEEK_SET);
+        const unsigned indexPos = file.ReadUnsignedInt();
+        std::array<char, 4> indexId;
+        file.ReadRawData(indexId.data(), indexId.size());
+        if(indexId == KEYFRAME_INDEX_ID && indexPos >= cmdsStartPos && indexPos < fileSize - trailerSize)
+        {
+            file.Seek(indexPos, SEEK_SET);
+            if(file.ReadUnsignedInt() == END_GF && file.ReadUnsignedChar() == RC_REPLAYEND)
+            {
+                const unsigned numKeyframes = file.ReadUnsignedInt();
+                if(numKeyframes > (fileSize - indexPos) / (3 * sizeof(uint32_t)))
+                    throw std::runtime_error(_("Invalid keyframe index"));
+                keyframes_.resize(numKeyframes);
+                for(Keyframe& keyframe : keyframes_)
+                {
+                    keyframe.gf = file.ReadUnsignedInt();
+                    keyframe.cmdPos = file.ReadUnsignedInt();
+                    keyframe.dataPos = file.ReadUnsignedInt();
+                }
+                file.Seek(cmdsStartPos, SEEK_SET);
+                return;
+            }
+        }
+    }
+
+    // No index, so go through all commands
+    file.Seek(cmdsStartPos, SEEK_SET);
+    // Marked keyframes whose data was not yet found
+    std::vector<Keyframe> pendingKeyframes;
+    try
+    {
+        unsigned gf;
+        bool endReached = false;
+        while(!endReached && ReadGF(&gf))
+        {
+            switch(ReadRCType())
+            {
+                case RC_CHAT:
+                {
+                    uint8_t player, dest;
+                    std::string str;
+                    ReadChatCommand(player, dest, str);
+                    break;
+                }
+                case RC_GAME:
+                {
+                    Serializer ser;
+                    ser.ReadFromFile(file);
+                    break;
+                }
+                case RC_KEYFRAME:
+                    SkipKeyframe();
+                    pendingKeyframes.push_back(Keyframe{gf, file.Tell(), 0});
+                    break;
+                case RC_KEYFRAMEDATA:
+                {
+                    const unsigned dataPos = file.Tell();
+                    // Only use complete keyframes
+                    if(file.ReadUnsignedInt() > fileSize - dataPos - sizeof(uint32_t))
+                        endReached = true;
+                    else
+                    {
+                        const unsigned keyframeGF = file.ReadUnsignedInt();
+                        const auto itPending = std::find_if(pendingKeyframes.begin(), pendingKeyframes.end(),
+                                                            [keyframeGF](const Keyframe& keyframe) { return keyframe.gf == keyframeGF; });
+                        if(itPending != pendingKeyframes.end())
+                        {
+                            keyframes_.push_back(Keyframe{keyframeGF, itPending->cmdPos, dataPos});
+                            pendingKeyframes.erase(itPending);
+                        }
+                        file.Seek(dataPos, SEEK_SET);
+                        SkipKeyframe();
+                    }
+                    break;
+                }
+                default: endReached = true; break;
+            }
+        }
+    } catch(std::runtime_error&)
+    {
+        // Truncated file. Use the keyframes found so far
+    }
+    std::sort(keyframes_.begin(), keyframes_.end(), [](const Keyframe& lhs, const Keyframe& rhs) { return lhs.gf < rhs.gf; });
+    file.Seek(cmdsStartPos, SEEK_SET);
+}
+
+const Replay::Keyframe* Replay::FindKeyframe(unsigned gf) const
+{
+    const auto it =
+      std::upper_bound(keyframes_.begin(), keyframes_.end(), gf, [](unsigned gf, const Keyframe& keyframe) { return gf < keyframe.gf; });
+    if(it == keyframes_.begin())
+        return nullptr;
+    return &*std::prev(it);
+}
+
+bool Replay::ReadKeyframe(const Keyframe& keyframe, Savegame& save, UsedPRNG& rngState)
+{
+    RTTR_Assert(IsReplaying());
+    const unsigned oldPos = file.Tell();
+    try
+    {
+        file.Seek(keyframe.dataPos, SEEK_SET);
+        // Skip length
+        file.ReadUnsignedInt();
+        if(file.ReadUnsignedInt() != keyframe.gf)
+            throw std::runtime_error(_("Invalid keyframe"));
+        Serializer ser;
+        ser.ReadFromFile(file);
+        rngState.deserialize(ser);
+        if(!save.Load(file, true, true))
+        {
+            lastErrorMsg = save.GetLastErrorMsg();
+            file.Seek(oldPos, SEEK_SET);
+            return false;
+        }
+    } catch(std::runtime_error& e)
+    {
+        lastErrorMsg = e.what();
+        file.Seek(oldPos, SEEK_SET);
+        return false;
+    }
+    // Continue with the commands after the keyframe marker
+    file.Seek(keyframe.cmdPos, SEEK_SET);
+    return true;
+}
+
+void Replay::SkipKeyframe()
+{
+    RTTR_Assert(IsReplaying());
+    const unsigned length = file.ReadUnsignedInt();
+    file.Seek(length, SEEK_CUR);
+}
+
 bool Replay::ReadGF(unsigned* gf)
 {
     RTTR_Assert(IsReplaying());
@@ -244,7 +485,8 @@ bool Replay::ReadGF(unsigned* gf)
             return false;
         throw;
     }
-    return true;
+    // Keyframe index follows
+    return *gf != END_GF;
 }
 
 Replay::ReplayCommand Replay::ReadRCType()
@@ -268,12 +510,13 @@ void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
     Serializer ser;
     ser.ReadFromFile(file);
     player = ser.PopUnsignedChar();
-    cmds.Deserialize(ser);
+    cmds.Deserialize(ser, readVersion >= 7);
 }
 
 void Replay::UpdateLastGF(unsigned last_gf)
 {
     RTTR_Assert(IsRecording());
+    std::lock_guard<std::mutex> lock(recordMutex_);
     if(!file.IsValid())
         return;
 
@@ -20,17 +20,23 @@
 #pragma once
 
 #include "SavedFile.h"
+#include "random/Random.h"
 #include "gameTypes/MapType.h"
 #include "s25util/BinaryFile.h"
+#include <mutex>
 #include <string>
+#include <vector>
 
 class MapInfo;
+class Savegame;
 struct PlayerGameCommands;
 
 /// Holds a replay that is being recorded or was recorded and loaded
 /// It has a header that holds minimal information:
 ///     File header (version etc.), record time, map name, player names, length (last GF), savegame header (if applicable)
 /// All game relevant data is stored afterwards
+/// Periodic keyframes (full game state) are marked between the commands. Their data follows later as it is written
+/// in the background and all keyframes are indexed at the end of the file
 class Replay : public SavedFile
 {
 public:
@@ -39,7 +45,21 @@ public:
     {
         RC_REPLAYEND = 0,
         RC_CHAT,
-        RC_GAME
+        RC_GAME,
+        /// Marks the position of a keyframe in the commands
+        RC_KEYFRAME,
+        /// Game state of a keyframe marked before
+        RC_KEYFRAMEDATA
+    };
+
+    /// Game state stored at the start of a GF
+    struct Keyframe
+    {
+        unsigned gf;
+        /// Position of the commands following the keyframe
+        unsigned cmdPos;
+        /// Position of the keyframe data in the file
+        unsigned dataPos;
     };
 
     Replay();
@@ -49,6 +69,7 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinVersion() const override;
 
     /// Beginnt die Save-Datei und schreibt den Header
     bool StartRecording(const std::string& filename, const MapInfo& mapInfo);
@@ -68,6 +89,11 @@ public:
     void AddChatCommand(unsigned gf, uint8_t player, uint8_t dest, const std::string& str);
     /// Fügt ein Spiel-Kommando hinzu (schreibt)
     void AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds);
+    /// Mark the start of the given GF (before its commands are executed) as a keyframe. Its data must be added afterwards
+    void AddKeyframe(unsigned gf);
+    /// Add the game state of the keyframe marked at the given GF. May be called from another thread while recording.
+    /// The data of the savegame should be compressed already as the file is locked while writing it
+    void AddKeyframeData(unsigned gf, Savegame& save, const UsedPRNG& rngState);
 
     /// Liest RC-Type aus, liefert false, wenn das Replay zu Ende ist
     bool ReadGF(unsigned* gf);
@@ -76,6 +102,14 @@ public:
     /// Liest ein Chat-Command aus
     void ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str);
     void ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds);
+    /// Skip a keyframe (marker or data) found while reading the commands
+    void SkipKeyframe();
+
+    const std::vector<Keyframe>& GetKeyframes() const { return keyframes_; }
+    /// Return the last keyframe at or before the given GF or nullptr if there is none
+    const Keyframe* FindKeyframe(unsigned gf) const;
+    /// Read the keyframe and continue reading commands after it. On error false is returned and the read position is unchanged
+    bool ReadKeyframe(const Keyframe& keyframe, Savegame& save, UsedPRNG& rngState);
 
     /// Aktualisiert den End-GF, schreibt ihn in die Replaydatei (nur beim Spielen bzw. Schreiben verwenden!)
     void UpdateLastGF(unsigned last_gf);
@@ -94,6 +128,18 @@ protected:
     /// Position des End-GF in der Datei
     unsigned last_gf_file_pos;
     MapType mapType_;
+    std::vector<Keyframe> keyframes_;
+    /// Keyframes marked while recording whose data was not yet added
+    std::vector<Keyframe> pendingKeyframes_;
+    /// Highest GF of all records written so far
+    unsigned lastRecordGF_;
+    /// Locks the file and keyframes while recording as keyframe data is added from another thread
+    std::mutex recordMutex_;
+
+    /// Write the index of all keyframes after the last command
+    void WriteKeyframeIndex();
+    /// Read the keyframe index or find the keyframes if it is missing (e.g. aborted recording)
+    void LoadKeyframes();
 };
 
 #endif //! GAMEREPLAY_H_INCLUDED
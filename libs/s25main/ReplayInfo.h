@@ -25,7 +25,7 @@
 
 struct ReplayInfo
 {
-    ReplayInfo() : async(0), end(false), next_gf(0), all_visible(false) {}
+    ReplayInfo() : async(0), end(false), next_gf(0), all_visible(false), seekGF(0) {}
 
     /// Replaydatei
     Replay replay;
@@ -37,6 +37,8 @@ struct ReplayInfo
     unsigned next_gf;
     /// Alles sichtbar (FoW deaktiviert)
     bool all_visible;
+    /// GF to jump to by restoring a keyframe, 0 if none requested
+    unsigned seekGF;
 };
 
 #endif // ReplayInfo_h__
@@ -22,6 +22,7 @@
 #include "SerializedGameData.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "figures/nofCarrier.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "random/Random.h"
 #include "world/GameWorldGame.h"
 #include "nodeObjs/noFlag.h"
@@ -333,7 +334,25 @@ void RoadSegment::TryGetDonkey()
 {
     // Nur rufen, falls es eine Eselstraße ist, noch kein Esel da ist, aber schon ein Träger da ist
     if(NeedDonkey())
+    {
         carriers_[1] = gwg->GetPlayer(f1->GetPlayer()).OrderDonkey(this);
+        gwg->GetRoadPathFinder().InvalidateWarePaths(f1->GetPlayer());
+    }
+}
+
+void RoadSegment::setCarrier(unsigned char nr, nofCarrier* c)
+{
+    RTTR_Assert(!c || !hasCarrier(nr));
+    carriers_[nr] = c;
+    // Carriers on the road change the costs for wares
+    gwg->GetRoadPathFinder().InvalidateWarePaths(f1->GetPlayer());
+}
+
+void RoadSegment::GotDonkey(nofCarrier* donkey)
+{
+    RTTR_Assert(!carriers_[1]);
+    carriers_[1] = donkey;
+    gwg->GetRoadPathFinder().InvalidateWarePaths(f1->GetPlayer());
 }
 
 /**
@@ -352,6 +371,7 @@ void RoadSegment::CarrierAbrogated(nofCarrier* carrier)
         // Kein Esel mehr da, versuchen, neuen zu bestellen
         this->carriers_[1] = gwg->GetPlayer(f1->GetPlayer()).OrderDonkey(this);
     }
+    gwg->GetRoadPathFinder().InvalidateWarePaths(f1->GetPlayer());
 }
 /**
  * Return flag at the other end of the road
@@ -71,21 +71,13 @@ public:
     /// gibt den Carrier nr zurück
     nofCarrier* getCarrier(unsigned char nr) const { return carriers_[nr]; }
     /// setzt den Carrier nr auf c
-    void setCarrier(unsigned char nr, nofCarrier* c)
-    {
-        RTTR_Assert(!c || !hasCarrier(nr));
-        carriers_[nr] = c;
-    }
+    void setCarrier(unsigned char nr, nofCarrier* c);
     /// haben wir den Carrier "nr"?
     bool hasCarrier(unsigned char nr) const { return (carriers_[nr] != nullptr); }
     /// Braucht die Straße einen Esel? Nur wenn sie auch einen Träger schon hat!
     bool NeedDonkey() const { return (rt == RT_DONKEY && carriers_[0] && !carriers_[1]); }
     /// Hat einen Esel als Arbeiter dazubekommen.
-    void GotDonkey(nofCarrier* donkey)
-    {
-        RTTR_Assert(!carriers_[1]);
-        carriers_[1] = donkey;
-    }
+    void GotDonkey(nofCarrier* donkey);
 
     /// haben wir überhaupt Carrier?
     bool isOccupied() const { return (carriers_[0] || carriers_[1]); }
@@ -39,6 +39,8 @@ public:
     virtual std::string GetSignature() const = 0;
     /// Return the file format version
     virtual uint16_t GetVersion() const = 0;
+    /// Return the oldest file format version that can still be read
+    virtual uint16_t GetMinVersion() const { return GetVersion(); }
 
     /// Schreibt Signatur und Version der Datei
     void WriteFileHeader(BinaryFile& file);
@@ -80,6 +82,8 @@ public:
 protected:
     /// Last error message during loading
     std::string lastErrorMsg;
+    /// Format version of the file read last
+    uint16_t readVersion;
 
 private:
     std::vector<BasePlayerInfo> players;
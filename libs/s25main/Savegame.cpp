@@ -18,6 +18,64 @@
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "Savegame.h"
 #include "s25util/BinaryFile.h"
+#include <boost/format.hpp>
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+/// First version with the game data split into compressed blocks
+constexpr uint16_t FIRST_COMPRESSED_VERSION = 5;
+/// Larger sections get split into blocks of at most this size to allow parallel decompression
+constexpr unsigned MAX_BLOCK_SIZE = 1024 * 1024;
+
+enum class BlockMethod : uint8_t
+{
+    Stored,
+    Deflate
+};
+/// Fastest zlib level. Much faster to write and read than bzip2 at a slightly worse ratio
+constexpr int COMPRESSION_LEVEL = 1;
+
+struct CompressedBlock
+{
+    unsigned offset, length;
+    std::vector<char> data;
+};
+
+/// Decompress all blocks into the buffer in parallel. Return the zlib error code of a failing block or Z_OK
+int DecompressBlocks(std::vector<CompressedBlock>& blocks, char* buffer)
+{
+    std::atomic<unsigned> nextBlock(0);
+    std::atomic<int> error(Z_OK);
+    const auto decompress = [&]() {
+        for(unsigned i = nextBlock++; i < blocks.size() && error == Z_OK; i = nextBlock++)
+        {
+            CompressedBlock& block = blocks[i];
+            uLongf outLength = block.length;
+            int err = uncompress(reinterpret_cast<Bytef*>(&buffer[block.offset]), &outLength,
+                                 reinterpret_cast<const Bytef*>(block.data.data()), block.data.size());
+            if(err == Z_OK && outLength != block.length)
+                err = Z_DATA_ERROR;
+            if(err != Z_OK)
+                error = err;
+            // Free the compressed data early
+            block.data = std::vector<char>();
+        }
+    };
+    const unsigned numThreads = std::min<unsigned>(std::max(1u, std::thread::hardware_concurrency()), blocks.size());
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < numThreads; i++)
+        threads.emplace_back(decompress);
+    decompress();
+    for(std::thread& thread : threads)
+        thread.join();
+    return error;
+}
+} // namespace
 
 std::string Savegame::GetSignature() const
 {
@@ -27,12 +85,19 @@ std::string Savegame::GetSignature() const
 uint16_t Savegame::GetVersion() const
 {
     // Note: If you increase the version, reset currentGameDataVersion in SerializedGameData.cpp (see note there)
-    return 4; // SaveGameVersion -- Updater signature, do NOT remove
+    // unless older versions can still be read (see GetMinVersion)
+    return 5; // SaveGameVersion -- Updater signature, do NOT remove
+}
+
+uint16_t Savegame::GetMinVersion() const
+{
+    // Version 4 only differs in the uncompressed game data
+    return 4;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Savegame::Savegame() : start_gf(0) {}
+Savegame::Savegame() : start_gf(0), compressGameData(true) {}
 
 Savegame::~Savegame() = default;
 
@@ -66,6 +131,7 @@ bool Savegame::Load(BinaryFile& file, bool loadSettings, bool loadGameData)
     {
         ClearPlayers();
         sgd.Clear();
+        compressedBlocks_.clear();
         if(!ReadAllHeaderData(file))
             return false;
 
@@ -100,13 +166,129 @@ bool Savegame::ReadExtHeader(BinaryFile& file)
     return true;
 }
 
+void Savegame::CompressGameData()
+{
+    const std::vector<unsigned> blockStarts = GetGameDataBlockStarts();
+    compressedBlocks_.clear();
+    compressedBlocks_.reserve(blockStarts.size() - 1);
+    for(unsigned i = 0; i + 1 < blockStarts.size(); i++)
+    {
+        GameDataBlock block;
+        block.length = blockStarts[i + 1] - blockStarts[i];
+        block.isCompressed = CompressBlock(reinterpret_cast<const char*>(sgd.GetData()) + blockStarts[i], block.length, block.data);
+        if(!block.isCompressed)
+            block.data = std::vector<char>();
+        compressedBlocks_.push_back(std::move(block));
+    }
+}
+
+std::vector<unsigned> Savegame::GetGameDataBlockStarts() const
+{
+    // Split the data at the section boundaries and large sections into blocks
+    const unsigned length = sgd.GetLength();
+    std::vector<unsigned> blockStarts;
+    std::vector<unsigned> sectionEnds(sgd.GetSectionOffsets());
+    sectionEnds.push_back(length);
+    unsigned curPos = 0;
+    for(unsigned sectionEnd : sectionEnds)
+    {
+        for(; curPos < std::min(sectionEnd, length); curPos += std::min(sectionEnd - curPos, MAX_BLOCK_SIZE))
+            blockStarts.push_back(curPos);
+    }
+    blockStarts.push_back(length);
+    return blockStarts;
+}
+
+bool Savegame::CompressBlock(const char* data, unsigned length, std::vector<char>& compressed) const
+{
+    if(!compressGameData)
+        return false;
+    // Blocks which don't get smaller are stored as-is
+    compressed.resize(length);
+    uLongf outLength = compressed.size();
+    const int err =
+      compress2(reinterpret_cast<Bytef*>(compressed.data()), &outLength, reinterpret_cast<const Bytef*>(data), length, COMPRESSION_LEVEL);
+    if(err == Z_BUF_ERROR || (err == Z_OK && outLength >= length))
+        return false;
+    if(err != Z_OK)
+        throw std::runtime_error((boost::format("Compressing game data failed with error %1%") % err).str());
+    compressed.resize(outLength);
+    return true;
+}
+
 void Savegame::WriteGameData(BinaryFile& file)
 {
-    sgd.WriteToFile(file);
+    const std::vector<unsigned> blockStarts = GetGameDataBlockStarts();
+    RTTR_Assert(compressedBlocks_.empty() || compressedBlocks_.size() + 1 == blockStarts.size());
+    file.WriteUnsignedInt(sgd.GetLength());
+    file.WriteUnsignedInt(blockStarts.size() - 1);
+    // Compress and write each block directly (unless done already) so only one compressed block is kept in memory
+    std::vector<char> compressed;
+    for(unsigned i = 0; i + 1 < blockStarts.size(); i++)
+    {
+        const unsigned blockLength = blockStarts[i + 1] - blockStarts[i];
+        const char* blockData = reinterpret_cast<const char*>(sgd.GetData()) + blockStarts[i];
+        bool isCompressed;
+        const std::vector<char>* compressedData = &compressed;
+        if(compressedBlocks_.empty())
+            isCompressed = CompressBlock(blockData, blockLength, compressed);
+        else
+        {
+            isCompressed = compressedBlocks_[i].isCompressed;
+            compressedData = &compressedBlocks_[i].data;
+        }
+        file.WriteUnsignedChar(static_cast<uint8_t>(isCompressed ? BlockMethod::Deflate : BlockMethod::Stored));
+        file.WriteUnsignedInt(blockLength);
+        if(isCompressed)
+        {
+            file.WriteUnsignedInt(compressedData->size());
+            file.WriteRawData(compressedData->data(), compressedData->size());
+        } else
+        {
+            file.WriteUnsignedInt(blockLength);
+            file.WriteRawData(blockData, blockLength);
+        }
+    }
 }
 
 bool Savegame::ReadGameData(BinaryFile& file)
 {
-    sgd.ReadFromFile(file);
+    if(readVersion < FIRST_COMPRESSED_VERSION)
+    {
+        sgd.ReadFromFile(file);
+        return true;
+    }
+    const unsigned length = file.ReadUnsignedInt();
+    const unsigned numBlocks = file.ReadUnsignedInt();
+    // Read and decompress directly into the game data buffer
+    sgd.Clear();
+    char* buffer = reinterpret_cast<char*>(sgd.GetDataWritable(length));
+    std::vector<CompressedBlock> blocks;
+    unsigned curPos = 0;
+    for(unsigned i = 0; i < numBlocks; i++)
+    {
+        const auto method = static_cast<BlockMethod>(file.ReadUnsignedChar());
+        if(method != BlockMethod::Stored && method != BlockMethod::Deflate)
+            throw std::runtime_error("Invalid game data compression method");
+        const unsigned blockLength = file.ReadUnsignedInt();
+        const unsigned dataLength = file.ReadUnsignedInt();
+        if(blockLength > length - curPos || (method == BlockMethod::Stored && dataLength != blockLength))
+            throw std::runtime_error("Invalid game data block size");
+        if(method == BlockMethod::Stored)
+            file.ReadRawData(buffer + curPos, blockLength);
+        else
+        {
+            blocks.push_back(CompressedBlock{curPos, blockLength, std::vector<char>(dataLength)});
+            file.ReadRawData(blocks.back().data.data(), dataLength);
+        }
+        curPos += blockLength;
+    }
+    if(curPos != length)
+        throw std::runtime_error("Game data size mismatch");
+
+    int err = DecompressBlocks(blocks, buffer);
+    if(err != Z_OK)
+        throw std::runtime_error((boost::format("Decompressing game data failed with error %1%") % err).str());
+    sgd.SetLength(length);
     return true;
 }
@@ -21,6 +21,7 @@
 
 #include "SavedFile.h"
 #include "SerializedGameData.h"
+#include <vector>
 class BinaryFile;
 
 class Savegame : public SavedFile
@@ -31,10 +32,13 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinVersion() const override;
 
     /// Schreibst Savegame oder Teile davon
     bool Save(const std::string& filename, const std::string& mapName);
     bool Save(BinaryFile& file, const std::string& mapName);
+    /// Compress the game data now so Save only writes it. The game data must not be changed afterwards
+    void CompressGameData();
 
     /// Lädt Savegame oder Teile davon
     bool Load(const std::string& filePath, bool loadSettings, bool loadGameData);
@@ -47,10 +51,28 @@ public:
     unsigned start_gf;
     /// Serialisierte Spieldaten
     SerializedGameData sgd;
+    /// Whether the game data is compressed when saving (faster to write if not)
+    bool compressGameData;
 
 protected:
     void WriteGameData(BinaryFile& file);
     bool ReadGameData(BinaryFile& file);
+
+private:
+    struct GameDataBlock
+    {
+        unsigned length;
+        bool isCompressed;
+        /// Compressed data, empty if the block is stored as-is
+        std::vector<char> data;
+    };
+    /// Blocks compressed by CompressGameData
+    std::vector<GameDataBlock> compressedBlocks_;
+
+    /// Return the offsets of the blocks the game data is split into followed by its length
+    std::vector<unsigned> GetGameDataBlockStarts() const;
+    /// Compress the block into the buffer. Return false if it should be stored uncompressed instead
+    bool CompressBlock(const char* data, unsigned length, std::vector<char>& compressed) const;
 };
 
 #endif //! GAMESAVEGAME_H_INCLUDED
@@ -69,7 +69,6 @@
 #include "figures/nofWarehouseWorker.h"
 #include "figures/nofWellguy.h"
 #include "figures/nofWoodcutter.h"
-#include "helpers/containerUtils.h"
 #include "helpers/toString.h"
 #include "world/GameWorld.h"
 #include "nodeObjs/noAnimal.h"
@@ -206,6 +205,8 @@ void SerializedGameData::Prepare(bool reading)
     }
     writtenObjIds.clear();
     readObjects.clear();
+    if(!reading)
+        writtenObjIds.reserve(GameObject::GetObjIDCounter() + 1);
     expectedNumObjects = 0;
     isReading = reading;
 }
@@ -216,18 +217,24 @@ void SerializedGameData::MakeSnapshot(const std::shared_ptr<Game>& game)
 
     GameWorld& gw = game->world_;
     writeEm = &gw.GetEvMgr();
+    writtenEventIds.reserve(writeEm->GetEventInstanceCtr());
+    sectionOffsets.clear();
+    sectionOffsets.push_back(0);
 
     // Anzahl Objekte reinschreiben (used for safety checks only)
     expectedNumObjects = GameObject::GetNumObjs();
     PushUnsignedInt(expectedNumObjects);
 
     // World and objects
+    sectionOffsets.push_back(GetLength());
     gw.Serialize(*this);
     // EventManager
+    sectionOffsets.push_back(GetLength());
     writeEm->Serialize(*this);
     // Spieler serialisieren
     for(unsigned i = 0; i < gw.GetNumPlayers(); ++i)
     {
+        sectionOffsets.push_back(GetLength());
         if(debugMode)
             LOG.write("Start serializing player %1% at %2%\n") % i % GetLength();
         gw.GetPlayer(i).Serialize(*this);
@@ -316,7 +323,7 @@ void SerializedGameData::PushObject_(const GameObject* go, const bool known)
         LOG.write("Saving objId %u, obj#=%u\n") % objId % writtenObjIds.size();
 
     // Objekt merken
-    writtenObjIds.insert(objId);
+    writtenObjIds.insert(objId, true);
 
     RTTR_Assert(writtenObjIds.size() < GameObject::GetNumObjs());
 
@@ -347,7 +354,7 @@ void SerializedGameData::PushEvent(const GameEvent* event)
     PushUnsignedInt(instanceId);
     if(IsEventSerialized(instanceId))
         return;
-    writtenEventIds.insert(instanceId);
+    writtenEventIds.insert(instanceId, true);
     if(debugMode)
         LOG.write("Start serializing event %1% at %2%\n") % instanceId % GetLength();
     event->Serialize(*this);
@@ -363,19 +370,20 @@ const GameEvent* SerializedGameData::PopEvent()
         return nullptr;
 
     // Note: em->GetEventInstanceCtr() might not be set yet
-    const auto foundObj = readEvents.find(instanceId);
-    if(foundObj != readEvents.end())
-        return foundObj->second;
-    std::unique_ptr<GameEvent> ev = std::make_unique<GameEvent>(*this, instanceId);
+    if(const GameEvent* foundEv = readEvents.get(instanceId))
+        return foundEv;
+    RTTR_Assert(em);
+    GameEvent* ev = em->MakeEvent(*this, instanceId);
 
     unsigned short safety_code = PopUnsignedShort();
 
     if(safety_code != GetSafetyCode(*ev))
     {
         LOG.write("SerializedGameData::PopEvent: ERROR: After loading Event(instanceId = %1%); Code is wrong!\n") % instanceId;
+        em->FreeEvent(ev);
         throw Error("Invalid safety code after PopEvent");
     }
-    return ev.release();
+    return ev;
 }
 
 /// FoW-Objekt
@@ -459,16 +467,16 @@ unsigned short SerializedGameData::GetSafetyCode(const GameEvent& ev)
 void SerializedGameData::AddObject(GameObject* go)
 {
     RTTR_Assert(isReading);
-    RTTR_Assert(!readObjects[go->GetObjId()]); // Do not call this multiple times per GameObject
-    readObjects[go->GetObjId()] = go;
+    RTTR_Assert(!readObjects.contains(go->GetObjId())); // Do not call this multiple times per GameObject
+    readObjects.insert(go->GetObjId(), go);
     RTTR_Assert(readObjects.size() < expectedNumObjects);
 }
 
 unsigned SerializedGameData::AddEvent(unsigned instanceId, GameEvent* ev)
 {
     RTTR_Assert(isReading);
-    RTTR_Assert(!readEvents[instanceId]); // Do not call this multiple times per GameObject
-    readEvents[instanceId] = ev;
+    RTTR_Assert(!readEvents.contains(instanceId)); // Do not call this multiple times per GameObject
+    readEvents.insert(instanceId, ev);
     return instanceId;
 }
 
@@ -476,23 +484,19 @@ bool SerializedGameData::IsObjectSerialized(unsigned obj_id) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(obj_id <= GameObject::GetObjIDCounter());
-    return helpers::contains(writtenObjIds, obj_id);
+    return writtenObjIds.contains(obj_id);
 }
 
 bool SerializedGameData::IsEventSerialized(unsigned evInstanceid) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(evInstanceid < writeEm->GetEventInstanceCtr());
-    return helpers::contains(writtenEventIds, evInstanceid);
+    return writtenEventIds.contains(evInstanceid);
 }
 
 GameObject* SerializedGameData::GetReadGameObject(const unsigned obj_id) const
 {
     RTTR_Assert(isReading);
     RTTR_Assert(obj_id <= GameObject::GetObjIDCounter());
-    auto foundObj = readObjects.find(obj_id);
-    if(foundObj == readObjects.end())
-        return nullptr;
-    else
-        return foundObj->second;
+    return readObjects.get(obj_id);
 }
@@ -21,6 +21,7 @@
 
 #include "FOWObjects.h"
 #include "helpers/GetInsertIterator.hpp"
+#include "helpers/IdTable.h"
 #include "helpers/ReserveElements.hpp"
 #include "gameTypes/GO_Type.h"
 #include "gameTypes/MapCoordinates.h"
@@ -31,6 +32,7 @@
 #include <set>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 class GameObject;
 class EventManager;
@@ -57,6 +59,9 @@ public:
     void ReadSnapshot(const std::shared_ptr<Game>& game);
 
     unsigned GetGameDataVersion() const { return gameDataVersion; }
+    /// Offsets where the sections (header, world, events, players) of the last snapshot start.
+    /// Only usable as split points for the data, the sections are not independent
+    const std::vector<unsigned>& GetSectionOffsets() const { return sectionOffsets; }
 
     //////////////////////////////////////////////////////////////////////////
     // Write methods
@@ -142,14 +147,16 @@ private:
     unsigned gameDataVersion;
 
     /// Stores the ids of all written objects (-> only valid during writing)
-    std::set<unsigned> writtenObjIds;
-    std::set<unsigned> writtenEventIds;
+    helpers::IdTable<bool> writtenObjIds;
+    helpers::IdTable<bool> writtenEventIds;
     /// Maps already read object ids to GameObjects (-> only valid during reading)
-    std::map<unsigned, GameObject*> readObjects;
-    std::map<unsigned, GameEvent*> readEvents;
+    helpers::IdTable<GameObject*> readObjects;
+    helpers::IdTable<GameEvent*> readEvents;
 
     /// Expected number of objects to be read/written
     unsigned expectedNumObjects;
+    /// Start of each section written by MakeSnapshot
+    std::vector<unsigned> sectionOffsets;
 
     /// EventManager, used during deserialization to add events, nullptr otherwise
     EventManager* em;
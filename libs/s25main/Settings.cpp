@@ -32,7 +32,7 @@
 #include "s25util/error.h"
 #include <boost/filesystem/operations.hpp>
 
-const int Settings::VERSION = 13;
+const int Settings::VERSION = 14;
 const std::array<std::string, 11> Settings::SECTION_NAMES = {
   {"global", "video", "language", "driver", "sound", "lobby", "server", "proxy", "interface", "ingame", "addons"}};
 
@@ -130,7 +130,9 @@ void Settings::LoadDefaults()
     // interface
     // {
     interface.autosave_interval = 0;
+    interface.replay_keyframe_interval = 10000;
     interface.revert_mouse = false;
+    interface.compress_savegames = true;
     // }
 
     // ingame
@@ -270,7 +272,9 @@ void Settings::Load()
         // interface
         // {
         interface.autosave_interval = iniInterface->getValueI("autosave_interval");
+        interface.replay_keyframe_interval = iniInterface->getValueI("replay_keyframe_interval");
         interface.revert_mouse = (iniInterface->getValueI("revert_mouse") != 0);
+        interface.compress_savegames = (iniInterface->getValueI("compress_savegames") != 0);
         // }
 
         // ingame
@@ -389,7 +393,9 @@ void Settings::Save()
     // interface
     // {
     iniInterface->setValue("autosave_interval", interface.autosave_interval);
+    iniInterface->setValue("replay_keyframe_interval", interface.replay_keyframe_interval);
     iniInterface->setValue("revert_mouse", (interface.revert_mouse ? 1 : 0));
+    iniInterface->setValue("compress_savegames", (interface.compress_savegames ? 1 : 0));
     // }
 
     // ingame
@@ -105,7 +105,11 @@ public:
     struct
     {
         unsigned autosave_interval;
+        /// GFs between keyframes in recorded replays (0 = none)
+        unsigned replay_keyframe_interval;
         bool revert_mouse;
+        /// Compress the game data of savegames, autosaves and replay keyframes
+        bool compress_savegames;
     } interface;
 
     struct
@@ -0,0 +1,72 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef StateHash_h__
+#define StateHash_h__
+
+#include <cstdint>
+
+/// Hash over a set of (key, value) pairs which does not depend on the order of the pairs.
+/// It is updated when a value changes instead of being recalculated over the whole state.
+/// A value of 0 counts as not present, so an empty or default initialized state has the same hash.
+class StateHash
+{
+public:
+    StateHash() : hash_(0) {}
+
+    void Clear() { hash_ = 0; }
+    void Add(uint64_t key, uint64_t value)
+    {
+        if(value)
+            hash_ += Mix(key, value);
+    }
+    void Remove(uint64_t key, uint64_t value)
+    {
+        if(value)
+            hash_ -= Mix(key, value);
+    }
+    void Change(uint64_t key, uint64_t oldValue, uint64_t newValue)
+    {
+        Remove(key, oldValue);
+        Add(key, newValue);
+    }
+    /// Return the hash folded to 32 bits. Never 0, so 0 can be used for "no hash available"
+    unsigned Get() const
+    {
+        const auto result = static_cast<unsigned>(hash_ ^ (hash_ >> 32));
+        return result ? result : 1u;
+    }
+
+    bool operator==(const StateHash& rhs) const { return hash_ == rhs.hash_; }
+    bool operator!=(const StateHash& rhs) const { return hash_ != rhs.hash_; }
+
+private:
+    /// Finalizer of SplitMix64, spreads every input bit over the whole result
+    static uint64_t Finalize(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    static uint64_t Mix(uint64_t key, uint64_t value) { return Finalize(Finalize(key + 0x9E3779B97F4A7C15ull) ^ value); }
+
+    uint64_t hash_;
+};
+
+#endif // StateHash_h__
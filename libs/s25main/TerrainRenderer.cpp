@@ -54,6 +54,8 @@
  *
  * Drawing then binds a texture and draws all adjacent vertices with the same texture in one call by
  * providing an index and a count into the above arrays.
+ * Those index ranges are precomputed for chunks of CHUNK_SIZE x CHUNK_SIZE nodes, so a frame only needs to
+ * find the visible chunks and issue one glMultiDrawArrays per texture and chunk.
  */
 
 glArchivItem_Bitmap* new_clone(const glArchivItem_Bitmap& bmp)
@@ -61,7 +63,9 @@ glArchivItem_Bitmap* new_clone(const glArchivItem_Bitmap& bmp)
     return dynamic_cast<glArchivItem_Bitmap*>(bmp.clone());
 }
 
-TerrainRenderer::TerrainRenderer() : size_(0, 0) {}
+constexpr unsigned TerrainRenderer::CHUNK_SIZE;
+
+TerrainRenderer::TerrainRenderer() : size_(0, 0), numChunks_(0, 0) {}
 TerrainRenderer::~TerrainRenderer() = default;
 
 TerrainRenderer::PointF TerrainRenderer::GetNeighbourVertexPos(MapPoint pt, const unsigned dir) const
@@ -274,6 +278,10 @@ void TerrainRenderer::Init(const MapExtent& size)
     gl_vertices.resize(vertices.size() * 2);
     gl_texcoords.resize(gl_vertices.size());
     gl_colors.resize(gl_vertices.size());
+
+    numChunks_ = MapExtent((size_.x + CHUNK_SIZE - 1) / CHUNK_SIZE, (size_.y + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    chunks_.clear();
+    chunks_.resize(numChunks_.x * numChunks_.y);
 }
 
 /// Gets the edge type that t1 draws over t2. 0 = None, else edgeType + 1
@@ -343,6 +351,8 @@ void TerrainRenderer::GenerateOpenGL(const GameWorldViewer& gwv)
         UpdateBorderTriangleTerrain(pt, false);
     }
 
+    GenerateChunks(desc);
+
     if(SETTINGS.video.vbo)
     {
         // Create and fill the 3 VBOs for vertices, texCoords and colors
@@ -663,111 +673,127 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
     }
 }
 
-/**
- *  zeichnet den Kartenausschnitt.
- */
-void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, const GameWorldViewer& gwv, unsigned* water) const
+void TerrainRenderer::TriangleRanges::Add(unsigned triangleIdx)
 {
-    RTTR_Assert(!gl_vertices.empty());
-    RTTR_Assert(!borders.empty());
-
-    // nach Texture in Listen sortieren
-    std::vector<std::vector<MapTile>> sorted_textures(terrainTextures.size());
-    std::vector<std::vector<BorderTile>> sorted_borders(edgeTextures.size());
-    PreparedRoads sorted_roads(roadTextures.size());
-
-    Position lastOffset(0, 0);
-
-    // Beim zeichnen immer nur beginnen, wo man auch was sieht
-    for(int y = firstPt.y; y <= lastPt.y; ++y)
+    // Arguments are in elements. 1 triangle has 3 values
+    const auto first = static_cast<GLint>(triangleIdx * 3);
+    if(!firsts.empty() && firsts.back() + counts.back() == first)
+        counts.back() += 3;
+    else
     {
-        unsigned char lastTerrain = 255;
-        unsigned char lastBorder = 255;
+        firsts.push_back(first);
+        counts.push_back(3);
+    }
+}
 
-        for(int x = firstPt.x; x <= lastPt.x; ++x)
+void TerrainRenderer::GenerateChunks(const WorldDescription& desc)
+{
+    for(Chunk& chunk : chunks_)
+    {
+        chunk.terrain.clear();
+        chunk.terrain.resize(terrainTextures.size());
+        chunk.borders.clear();
+        chunk.borders.resize(edgeTextures.size());
+        chunk.roads.clear();
+        chunk.roads.resize(roadTextures.size());
+        chunk.roadsValid = false;
+    }
+    // Go row by row so adjacent triangles with the same texture end up in the same range
+    RTTR_FOREACH_PT(MapPoint, size_)
+    {
+        Chunk& chunk = chunks_[GetChunkIdx(pt)];
+        const unsigned idx = GetVertexIdx(pt);
+        for(unsigned i = 0; i < 2; ++i)
         {
-            Position posOffset;
-            MapPoint tP = ConvertCoords(Position(x, y), &posOffset);
-
-            unsigned char t = terrain[GetVertexIdx(tP)][0].value;
-            if(posOffset != lastOffset)
-                lastTerrain = 255;
-
-            if(t == lastTerrain && tP != MapPoint(0, 0))
-                ++sorted_textures[t].back().count;
-            else
-            {
-                MapTile tmp(GetTriangleIdx(tP), posOffset);
-                sorted_textures[t].push_back(tmp);
-                lastTerrain = t;
-            }
-
-            t = terrain[GetVertexIdx(tP)][1].value;
-
-            if(t == lastTerrain)
-                ++sorted_textures[t].back().count;
-            else
-            {
-                MapTile tmp(GetTriangleIdx(tP) + 1, posOffset);
-                sorted_textures[t].push_back(tmp);
-            }
-
-            lastTerrain = t;
-
-            const Borders& curBorders = borders[GetVertexIdx(tP)];
-            std::array<unsigned char, 6> tiles = {{curBorders.left_right[0], curBorders.left_right[1], curBorders.right_left[0],
-                                                   curBorders.right_left[1], curBorders.top_down[0], curBorders.top_down[1]}};
-
-            // Offsets into gl_* arrays
-            std::array<unsigned, 6> offsets = {{curBorders.left_right_offset[0], curBorders.left_right_offset[1],
-                                                curBorders.right_left_offset[0], curBorders.right_left_offset[1],
-                                                curBorders.top_down_offset[0], curBorders.top_down_offset[1]}};
+            const DescIdx<TerrainDesc> t = terrain[idx][i];
+            chunk.terrain[t.value].Add(GetTriangleIdx(pt) + i);
+            ++chunk.numTriangles;
+            if(desc.get(t).kind == TerrainKind::WATER)
+                ++chunk.numWaterTriangles;
+        }
 
-            for(unsigned char i = 0; i < 6; ++i)
-            {
-                if(!tiles[i])
-                    continue;
-                if(tiles[i] == lastBorder)
-                {
-                    BorderTile& curTile = sorted_borders[lastBorder - 1].back();
-                    // Check that we did not wrap around the map and the expected offset matches
-                    if(curTile.tileOffset + curTile.count == offsets[i])
-                    {
-                        ++curTile.count;
-                        continue;
-                    }
-                }
-                lastBorder = tiles[i];
-                BorderTile tmp(offsets[i], posOffset);
-                sorted_borders[lastBorder - 1].push_back(tmp);
-            }
+        const Borders& curBorders = borders[idx];
+        for(unsigned i = 0; i < 2; ++i)
+        {
+            if(curBorders.left_right[i])
+                chunk.borders[curBorders.left_right[i] - 1].Add(curBorders.left_right_offset[i]);
+            if(curBorders.right_left[i])
+                chunk.borders[curBorders.right_left[i] - 1].Add(curBorders.right_left_offset[i]);
+            if(curBorders.top_down[i])
+                chunk.borders[curBorders.top_down[i] - 1].Add(curBorders.top_down_offset[i]);
+        }
+    }
+}
 
-            PrepareWaysPoint(sorted_roads, gwv, tP, posOffset);
+void TerrainRenderer::InvalidateRoads(const MapPoint pt, unsigned radius)
+{
+    if(chunks_.empty())
+        return;
+    RTTR_Assert(radius < CHUNK_SIZE);
+    // The chunks are bigger than the radius, so checking the corners and edge centers covers all affected chunks
+    const int r = static_cast<int>(radius);
+    for(int dy = -r; dy <= r; dy += std::max(r, 1))
+    {
+        for(int dx = -r; dx <= r; dx += std::max(r, 1))
+            chunks_[GetChunkIdx(MakeMapPoint(Position(pt) + Position(dx, dy), size_))].roadsValid = false;
+    }
+}
 
-            lastOffset = posOffset;
-        }
+void TerrainRenderer::UpdateChunkRoads(Chunk& chunk, unsigned chunkIdx, const GameWorldViewer& gwv) const
+{
+    PreparedRoads sorted_roads(roadTextures.size());
+    const MapPoint chunkStart((chunkIdx % numChunks_.x) * CHUNK_SIZE, (chunkIdx / numChunks_.x) * CHUNK_SIZE);
+    const MapPoint chunkEnd(std::min<unsigned>(chunkStart.x + CHUNK_SIZE, size_.x), std::min<unsigned>(chunkStart.y + CHUNK_SIZE, size_.y));
+    for(MapPoint pt(0, chunkStart.y); pt.y < chunkEnd.y; ++pt.y)
+    {
+        for(pt.x = chunkStart.x; pt.x < chunkEnd.x; ++pt.x)
+            PrepareWaysPoint(sorted_roads, gwv, pt, Position(0, 0));
     }
+    CreateRoadQuads(sorted_roads, chunk.roads);
+    chunk.roadsValid = true;
+}
 
-    if(water)
+/**
+ *  zeichnet den Kartenausschnitt.
+ */
+void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, const GameWorldViewer& gwv, unsigned* water) const
+{
+    RTTR_Assert(!gl_vertices.empty());
+    RTTR_Assert(!borders.empty());
+
+    // Find all chunks in the visible area together with the offset they need to be drawn at (due to wrapping around the map)
+    struct VisibleChunk
     {
-        unsigned water_count = 0;
-        const WorldDescription& desc = gwv.GetWorld().GetDescription();
-        for(DescIdx<TerrainDesc> t(0); t.value < sorted_textures.size(); ++t.value)
+        const Chunk* chunk;
+        Position offset;
+    };
+    std::vector<VisibleChunk> visibleChunks;
+    unsigned numTriangles = 0, numWaterTriangles = 0;
+    const Position mapSize(size_);
+    const auto chunkSize = static_cast<int>(CHUNK_SIZE);
+    for(int y = firstPt.y; y <= lastPt.y;)
+    {
+        const int mapY = ((y % mapSize.y) + mapSize.y) % mapSize.y;
+        const int chunkY = mapY / chunkSize;
+        for(int x = firstPt.x; x <= lastPt.x;)
         {
-            if(desc.get(t).kind != TerrainKind::WATER)
-                continue;
-            for(const MapTile& tile : sorted_textures[t.value])
-                water_count += tile.count;
+            const int mapX = ((x % mapSize.x) + mapSize.x) % mapSize.x;
+            const int chunkX = mapX / chunkSize;
+            const unsigned chunkIdx = chunkY * numChunks_.x + chunkX;
+            Chunk& chunk = chunks_[chunkIdx];
+            if(!chunk.roadsValid)
+                UpdateChunkRoads(chunk, chunkIdx, gwv);
+            visibleChunks.push_back(VisibleChunk{&chunk, Position(x - mapX, y - mapY) * Extent(TR_W, TR_H)});
+            numTriangles += chunk.numTriangles;
+            numWaterTriangles += chunk.numWaterTriangles;
+            // Continue at the first point of the next chunk
+            x += std::min((chunkX + 1) * chunkSize, mapSize.x) - mapX;
         }
-
-        Position diff = lastPt - firstPt;
-        if(diff.x && diff.y)
-            *water = 50 * water_count / (diff.x * diff.y);
-        else
-            *water = 0;
+        y += std::min((chunkY + 1) * chunkSize, mapSize.y) - mapY;
     }
 
-    lastOffset = Position(0, 0);
+    if(water)
+        *water = numTriangles ? 100 * numWaterTriangles / numTriangles : 0;
 
     // Arrays aktivieren
     glEnableClientState(GL_COLOR_ARRAY);
@@ -796,10 +822,29 @@ void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, cons
     // Alphablending aus
     glDisable(GL_BLEND);
 
-    glPushMatrix();
-    for(unsigned t = 0; t < sorted_textures.size(); ++t)
+    // Draws the ranges selected from each chunk with the currently bound texture
+    const auto drawChunks = [&visibleChunks](const auto& getRanges) {
+        Position lastOffset(0, 0);
+        glPushMatrix();
+        for(const VisibleChunk& visibleChunk : visibleChunks)
+        {
+            const TriangleRanges& ranges = getRanges(*visibleChunk.chunk);
+            if(ranges.empty())
+                continue;
+            if(visibleChunk.offset != lastOffset)
+            {
+                Position trans = visibleChunk.offset - lastOffset;
+                glTranslatef(float(trans.x), float(trans.y), 0.0f);
+                lastOffset = visibleChunk.offset;
+            }
+            glMultiDrawArrays(GL_TRIANGLES, ranges.firsts.data(), ranges.counts.data(), static_cast<GLsizei>(ranges.firsts.size()));
+        }
+        glPopMatrix();
+    };
+
+    for(unsigned t = 0; t < terrainTextures.size(); ++t)
     {
-        if(sorted_textures[t].empty())
+        if(!helpers::contains_if(visibleChunks, [t](const VisibleChunk& c) { return !c.chunk->terrain[t].empty(); }))
             continue;
         unsigned animationFrame;
         unsigned numFrames = terrainTextures[t].textures.size();
@@ -809,51 +854,56 @@ void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, cons
             animationFrame = 0;
 
         VIDEODRIVER.BindTexture(terrainTextures[t].textures[animationFrame].GetTextureNoCreate());
-
-        for(const auto& texture : sorted_textures[t])
-        {
-            if(texture.posOffset != lastOffset)
-            {
-                Position trans = texture.posOffset - lastOffset;
-                glTranslatef(float(trans.x), float(trans.y), 0.0f);
-                lastOffset = texture.posOffset;
-            }
-
-            RTTR_Assert(texture.tileOffset + texture.count <= size_.x * size_.y * 2u);
-            glDrawArrays(GL_TRIANGLES, texture.tileOffset * 3, texture.count * 3); // Arguments are in Elements. 1 triangle has 3 values
-        }
+        drawChunks([t](const Chunk& chunk) -> const TriangleRanges& { return chunk.terrain[t]; });
     }
-    glPopMatrix();
 
     glEnable(GL_BLEND);
 
-    lastOffset = Position(0, 0);
-    glPushMatrix();
-    for(unsigned i = 0; i < sorted_borders.size(); ++i)
+    for(unsigned i = 0; i < edgeTextures.size(); ++i)
     {
-        if(sorted_borders[i].empty())
+        if(!helpers::contains_if(visibleChunks, [i](const VisibleChunk& c) { return !c.chunk->borders[i].empty(); }))
             continue;
         VIDEODRIVER.BindTexture(edgeTextures[i]->GetTextureNoCreate());
+        drawChunks([i](const Chunk& chunk) -> const TriangleRanges& { return chunk.borders[i]; });
+    }
 
-        for(const auto& texture : sorted_borders[i])
+    // unbind VBO
+    if(vbo_vertices.isValid())
+        vbo_vertices.unbind();
+
+    // Roads
+    // These should still be enabled
+    RTTR_Assert(glIsEnabled(GL_VERTEX_ARRAY));
+    RTTR_Assert(glIsEnabled(GL_TEXTURE_COORD_ARRAY));
+    RTTR_Assert(glIsEnabled(GL_COLOR_ARRAY));
+    for(unsigned i = 0; i < roadTextures.size(); ++i)
+    {
+        bool textureBound = false;
+        Position lastOffset(0, 0);
+        glPushMatrix();
+        for(const VisibleChunk& visibleChunk : visibleChunks)
         {
-            if(texture.posOffset != lastOffset)
+            const std::vector<Tex2C3Ver2>& quads = visibleChunk.chunk->roads[i];
+            if(quads.empty())
+                continue;
+            if(!textureBound)
+            {
+                VIDEODRIVER.BindTexture(roadTextures[i]->GetTextureNoCreate());
+                textureBound = true;
+            }
+            if(visibleChunk.offset != lastOffset)
             {
-                Position trans = texture.posOffset - lastOffset;
+                Position trans = visibleChunk.offset - lastOffset;
                 glTranslatef(float(trans.x), float(trans.y), 0.0f);
-                lastOffset = texture.posOffset;
+                lastOffset = visibleChunk.offset;
             }
-            RTTR_Assert(texture.tileOffset + texture.count <= gl_vertices.size());
-            glDrawArrays(GL_TRIANGLES, texture.tileOffset * 3, texture.count * 3); // Arguments are in Elements. 1 triangle has 3 values
+            glVertexPointer(2, GL_FLOAT, sizeof(Tex2C3Ver2), &quads[0].x);
+            glTexCoordPointer(2, GL_FLOAT, sizeof(Tex2C3Ver2), &quads[0].tx);
+            glColorPointer(3, GL_FLOAT, sizeof(Tex2C3Ver2), &quads[0].r);
+            glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(quads.size()));
         }
+        glPopMatrix();
     }
-    glPopMatrix();
-
-    // unbind VBO
-    if(vbo_vertices.isValid())
-        vbo_vertices.unbind();
-
-    DrawWays(sorted_roads);
 
     glDisableClientState(GL_COLOR_ARRAY);
     // Wieder zurück ins normale modulate
@@ -943,87 +993,61 @@ void TerrainRenderer::PrepareWaysPoint(PreparedRoads& sorted_roads, const GameWo
     }
 }
 
-struct Tex2C3Ver2
-{
-    GLfloat tx, ty;
-    GLfloat r, g, b;
-    GLfloat x, y;
-};
-
-void TerrainRenderer::DrawWays(const PreparedRoads& sorted_roads) const
+void TerrainRenderer::CreateRoadQuads(const PreparedRoads& sorted_roads, std::vector<std::vector<Tex2C3Ver2>>& quads) const
 {
     // 2D Array: [3][4]
     static const std::array<Position, 12> begin_end_coords = {{Position(0, -3), Position(0, 3), Position(3, 3), Position(3, -3),
                                                                Position(2, -4), Position(-4, 2), Position(0, 6), Position(6, 0),
                                                                Position(4, 2), Position(-2, -4), Position(-6, 0), Position(0, 6)}};
 
-    size_t maxSize = 0;
-    for(const std::vector<PreparedRoad>& sorted_road : sorted_roads)
-        maxSize = std::max(maxSize, sorted_road.size());
-
-    if(maxSize == 0)
-        return;
-
-    auto vertexData = std::unique_ptr<Tex2C3Ver2[]>(new Tex2C3Ver2[maxSize * 4]);
-    // These should still be enabled
-    RTTR_Assert(glIsEnabled(GL_VERTEX_ARRAY));
-    RTTR_Assert(glIsEnabled(GL_TEXTURE_COORD_ARRAY));
-    RTTR_Assert(glIsEnabled(GL_COLOR_ARRAY));
-    glVertexPointer(2, GL_FLOAT, sizeof(Tex2C3Ver2), &vertexData[0].x);
-    glTexCoordPointer(2, GL_FLOAT, sizeof(Tex2C3Ver2), &vertexData[0].tx);
-    glColorPointer(3, GL_FLOAT, sizeof(Tex2C3Ver2), &vertexData[0].r);
-
+    RTTR_Assert(quads.size() == sorted_roads.size());
     for(const auto itRoad : sorted_roads | boost::adaptors::indexed())
     {
+        std::vector<Tex2C3Ver2>& vertexData = quads[itRoad.index()];
+        vertexData.clear();
         if(itRoad.value().empty())
             continue;
-        Tex2C3Ver2* curVertexData = vertexData.get();
+        vertexData.reserve(itRoad.value().size() * 4);
         const glArchivItem_Bitmap& texture = *roadTextures[itRoad.index()];
         PointF scaledTexSize = texture.GetSize() / PointF(texture.GetTexSize());
 
         for(const auto& it : itRoad.value())
         {
             RTTR_Assert(it.dir < 3); // begin_end_coords has 3 dir entries
-            curVertexData->tx = 0.0f;
-            curVertexData->ty = 0.0f;
-            curVertexData->r = curVertexData->g = curVertexData->b = it.color1;
+            Tex2C3Ver2 curVertexData;
+            curVertexData.tx = 0.0f;
+            curVertexData.ty = 0.0f;
+            curVertexData.r = curVertexData.g = curVertexData.b = it.color1;
             Position tmpP = it.pos + begin_end_coords[it.dir * 4];
-            curVertexData->x = GLfloat(tmpP.x);
-            curVertexData->y = GLfloat(tmpP.y);
+            curVertexData.x = GLfloat(tmpP.x);
+            curVertexData.y = GLfloat(tmpP.y);
+            vertexData.push_back(curVertexData);
 
-            curVertexData++;
-
-            curVertexData->tx = 0.0f;
-            curVertexData->ty = scaledTexSize.y;
-            curVertexData->r = curVertexData->g = curVertexData->b = it.color1;
+            curVertexData.tx = 0.0f;
+            curVertexData.ty = scaledTexSize.y;
+            curVertexData.r = curVertexData.g = curVertexData.b = it.color1;
             tmpP = it.pos + begin_end_coords[it.dir * 4 + 1];
-            curVertexData->x = GLfloat(tmpP.x);
-            curVertexData->y = GLfloat(tmpP.y);
-
-            curVertexData++;
+            curVertexData.x = GLfloat(tmpP.x);
+            curVertexData.y = GLfloat(tmpP.y);
+            vertexData.push_back(curVertexData);
 
-            curVertexData->tx = scaledTexSize.x;
-            curVertexData->ty = scaledTexSize.y;
-            curVertexData->r = curVertexData->g = curVertexData->b = it.color2;
+            curVertexData.tx = scaledTexSize.x;
+            curVertexData.ty = scaledTexSize.y;
+            curVertexData.r = curVertexData.g = curVertexData.b = it.color2;
             tmpP = it.pos2 + begin_end_coords[it.dir * 4 + 2];
-            curVertexData->x = GLfloat(tmpP.x);
-            curVertexData->y = GLfloat(tmpP.y);
+            curVertexData.x = GLfloat(tmpP.x);
+            curVertexData.y = GLfloat(tmpP.y);
+            vertexData.push_back(curVertexData);
 
-            curVertexData++;
-            curVertexData->tx = scaledTexSize.x;
-            curVertexData->ty = 0.0f;
-            curVertexData->r = curVertexData->g = curVertexData->b = it.color2;
+            curVertexData.tx = scaledTexSize.x;
+            curVertexData.ty = 0.0f;
+            curVertexData.r = curVertexData.g = curVertexData.b = it.color2;
             tmpP = it.pos2 + begin_end_coords[it.dir * 4 + 3];
-            curVertexData->x = GLfloat(tmpP.x);
-            curVertexData->y = GLfloat(tmpP.y);
-
-            curVertexData++;
+            curVertexData.x = GLfloat(tmpP.x);
+            curVertexData.y = GLfloat(tmpP.y);
+            vertexData.push_back(curVertexData);
         }
-
-        VIDEODRIVER.BindTexture(texture.GetTextureNoCreate());
-        glDrawArrays(GL_QUADS, 0, itRoad.value().size() * 4);
     }
-    // Note: No glDisableClientState as we did not enable it
 }
 
 void TerrainRenderer::AltitudeChanged(const MapPoint pt, const GameWorldViewer& gwv)
@@ -1068,6 +1092,9 @@ void TerrainRenderer::AltitudeChanged(const MapPoint pt, const GameWorldViewer&
 
     for(unsigned i = 0; i < 12; ++i)
         UpdateBorderTriangleColor(gwv.GetWorld().GetNeighbour2(pt, i), true);
+
+    // Roads use the position and color of their end points
+    InvalidateRoads(pt, 2);
 }
 
 void TerrainRenderer::VisibilityChanged(const MapPoint pt, const GameWorldViewer& gwv)
@@ -1094,6 +1121,14 @@ void TerrainRenderer::VisibilityChanged(const MapPoint pt, const GameWorldViewer
     UpdateBorderTriangleColor(pt, true);
     for(unsigned i = 0; i < 6; ++i)
         UpdateBorderTriangleColor(gwv.GetNeighbour(pt, Direction::fromInt(i)), true);
+
+    // Visible roads and their colors might have changed
+    InvalidateRoads(pt, 2);
+}
+
+void TerrainRenderer::RoadChanged(const MapPoint pt)
+{
+    InvalidateRoads(pt, 0);
 }
 
 void TerrainRenderer::UpdateAllColors(const GameWorldViewer& gwv)
@@ -1115,6 +1150,9 @@ void TerrainRenderer::UpdateAllColors(const GameWorldViewer& gwv)
         vbo_colors.update(gl_colors);
         vbo_colors.unbind();
     }
+
+    for(Chunk& chunk : chunks_)
+        chunk.roadsValid = false;
 }
 
 MapPoint TerrainRenderer::GetNeighbour(const MapPoint& pt, const Direction dir) const
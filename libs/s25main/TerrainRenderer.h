@@ -21,6 +21,7 @@
 #include "ogl/VBO.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameData/DescIdx.h"
+#include <glad/glad.h>
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <array>
@@ -64,25 +65,44 @@ public:
     void AltitudeChanged(MapPoint pt, const GameWorldViewer& gwv);
     /// Callback function for visibility changes
     void VisibilityChanged(MapPoint pt, const GameWorldViewer& gwv);
+    /// Callback function for changes of the (visible) roads starting at the given point
+    void RoadChanged(MapPoint pt);
 
     /// Recalculates all colors on the map
     void UpdateAllColors(const GameWorldViewer& gwv);
 
 private:
-    struct MapTile
+    /// Side length of a chunk in nodes
+    static constexpr unsigned CHUNK_SIZE = 16;
+
+    /// Triangles drawn with the same texture in the format for glMultiDrawArrays
+    struct TriangleRanges
     {
-        unsigned tileOffset;
-        unsigned count;
-        Position posOffset;
-        MapTile(unsigned tileOffset, Position posOffset) : tileOffset(tileOffset), count(1), posOffset(posOffset) {}
+        std::vector<GLint> firsts;
+        std::vector<GLsizei> counts;
+        /// Add the triangle, extending the last range if possible
+        void Add(unsigned triangleIdx);
+        bool empty() const { return firsts.empty(); }
     };
 
-    struct BorderTile
+    struct Tex2C3Ver2
     {
-        unsigned tileOffset;
-        unsigned count;
-        Position posOffset;
-        BorderTile(unsigned tileOffset, Position posOffset) : tileOffset(tileOffset), count(1), posOffset(posOffset) {}
+        GLfloat tx, ty;
+        GLfloat r, g, b;
+        GLfloat x, y;
+    };
+
+    /// Draw lists for a rectangular part of the map so they don't need to be recreated every frame
+    struct Chunk
+    {
+        /// Ranges per terrain texture
+        std::vector<TriangleRanges> terrain;
+        /// Ranges per edge texture
+        std::vector<TriangleRanges> borders;
+        unsigned numTriangles = 0, numWaterTriangles = 0;
+        /// Quads per road texture. Depend on roads, visibility and altitude, so they are recreated on demand
+        std::vector<std::vector<Tex2C3Ver2>> roads;
+        bool roadsValid = false;
     };
 
     struct PreparedRoad
@@ -134,6 +154,10 @@ private:
 
     /// Size of the map
     MapExtent size_;
+    /// Number of chunks in x and y direction
+    MapExtent numChunks_;
+    /// Chunk data which is mutable as the roads are updated lazily when drawing
+    mutable std::vector<Chunk> chunks_;
     /// Map sized array of vertex related data
     std::vector<Vertex> vertices;
     /// Map sized array with terrain indices/textures (bottom, bottom right of node)
@@ -198,10 +222,19 @@ private:
     /// liefert den Rand-Vertex-Farbwert an der Stelle X,Y
     float GetBorderColor(const MapPoint pt, unsigned char triangle) const { return GetVertex(pt).borderColor[triangle]; }
 
+    /// Returns the index of the chunk containing the point
+    unsigned GetChunkIdx(const MapPoint pt) const { return (pt.y / CHUNK_SIZE) * numChunks_.x + pt.x / CHUNK_SIZE; }
+    /// Creates the terrain and border draw lists of all chunks
+    void GenerateChunks(const WorldDescription& desc);
+    /// Marks the roads of all chunks within the given radius around the point as outdated
+    void InvalidateRoads(MapPoint pt, unsigned radius);
+    /// Recreates the road quads of the chunk
+    void UpdateChunkRoads(Chunk& chunk, unsigned chunkIdx, const GameWorldViewer& gwv) const;
+
     /// Adds possible roads from the given point to the prepared data struct
     void PrepareWaysPoint(PreparedRoads& sorted_roads, const GameWorldViewer& gwViewer, MapPoint pt, const Position& offset) const;
-    /// Draw the prepared roads
-    void DrawWays(const PreparedRoads& sorted_roads) const;
+    /// Converts the prepared roads into quads
+    void CreateRoadQuads(const PreparedRoads& sorted_roads, std::vector<std::vector<Tex2C3Ver2>>& quads) const;
 };
 
 #endif
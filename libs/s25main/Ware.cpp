@@ -25,6 +25,7 @@
 #include "buildings/noBuilding.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "buildings/nobHarborBuilding.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorldGame.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noRoadNode.h"
@@ -87,13 +88,21 @@ void Ware::SetGoal(noBaseBuilding* newGoal)
         goal->TakeWare(this);
 }
 
+void Ware::SetNextDir(const unsigned char newnextdir)
+{
+    // The number of wares at a flag going in a direction changes the costs of the roads for other wares
+    if(state == STATE_WAITATFLAG && newnextdir != next_dir)
+        gwg->GetRoadPathFinder().InvalidateWarePaths(location->GetPlayer());
+    next_dir = newnextdir;
+}
+
 void Ware::RecalcRoute()
 {
     // Nächste Richtung nehmen
     if(location && goal)
-        next_dir = gwg->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor);
+        SetNextDir(gwg->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor));
     else
-        next_dir = INVALID_DIR;
+        SetNextDir(INVALID_DIR);
 
     // Evtl gibts keinen Weg mehr? Dann wieder zurück ins Lagerhaus (wenns vorher überhaupt zu nem Ziel ging)
     if(next_dir == INVALID_DIR && goal)
@@ -170,7 +179,7 @@ void Ware::GoalDestroyed()
             } else // at the goal (which was just destroyed) and get carried out right now? -> we are about to get destroyed...
             {
                 goal = nullptr;
-                next_dir = INVALID_DIR;
+                SetNextDir(INVALID_DIR);
             }
         }
         // Wenn sie an einer Flagge liegt, muss der Weg neu berechnet werden und dem Träger Bescheid gesagt werden
@@ -248,7 +257,7 @@ void Ware::NotifyGoalAboutLostWare()
     {
         goal->WareLost(this);
         goal = nullptr;
-        next_dir = INVALID_DIR;
+        SetNextDir(INVALID_DIR);
     }
 }
 
@@ -307,15 +316,15 @@ bool Ware::FindRouteToWarehouse()
         if(state != STATE_CARRIED)
         {
             if(location == goal)
-                next_dir = INVALID_DIR; // Warehouse will detect this
+                SetNextDir(INVALID_DIR); // Warehouse will detect this
             else
             {
-                next_dir = gwg->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor);
+                SetNextDir(gwg->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor));
                 RTTR_Assert(next_dir != INVALID_DIR);
             }
         }
     } else
-        next_dir = INVALID_DIR; // Make sure we are not going anywhere
+        SetNextDir(INVALID_DIR); // Make sure we are not going anywhere
     return goal != nullptr;
 }
 
@@ -374,7 +383,7 @@ void Ware::SetNewGoalForLostWare(noBaseBuilding* newgoal)
         }
         // at this point there either is a road to the goal or if we are at the flag of the goal we have a road to a different flag to
         // bounce off of to get to the goal
-        next_dir = possibledir;
+        SetNextDir(possibledir);
         SetGoal(newgoal);
         CallCarrier();
     }
@@ -83,7 +83,7 @@ public:
     /// Berechnet den Weg neu zu ihrem Ziel
     void RecalcRoute();
     /// set new next dir
-    void SetNextDir(unsigned char newnextdir) { next_dir = newnextdir; }
+    void SetNextDir(unsigned char newnextdir);
     /// Wird aufgerufen, wenn es das Ziel der Ware nicht mehr gibt und sie wieder "nach Hause" getragen werden muss
     void GoalDestroyed();
     /// Changes the state of the ware
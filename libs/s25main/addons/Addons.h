@@ -70,5 +70,6 @@
 #include "addons/AddonCoinsCapturedBld.h"
 #include "addons/AddonDemolishBldWORes.h"
 #include "addons/AddonFrontierDistanceReachable.h"
+#include "addons/AddonHierarchicalPathfinding.h"
 
 #endif // !ADDONS_H_INCLUDED
@@ -21,6 +21,12 @@
 
 #include "AIInterface.h"
 #include "GameCommand.h"
+#include "random/Random.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
 
 class GameWorldBase;
 class GamePlayer;
@@ -30,15 +36,37 @@ class GlobalGameSettings;
 class AIPlayer
 {
 public:
+    /// Time spent in RunGF
+    struct RunTimes
+    {
+        std::chrono::microseconds last, max, total;
+        unsigned numRuns;
+        RunTimes() : last(0), max(0), total(0), numRuns(0) {}
+    };
+
     AIPlayer(unsigned char playerId, const GameWorldBase& gwb, const AI::Level level)
-        : playerId(playerId), player(gwb.GetPlayer(playerId)), gwb(gwb), ggs(gwb.GetGGS()), level(level), aii(gwb, gcs, playerId)
+        : playerId(playerId), player(gwb.GetPlayer(playerId)), gwb(gwb), ggs(gwb.GetGGS()), level(level), aii(gwb, gcs, playerId),
+          rng(RANDOM.GetChecksum() + playerId)
     {}
 
     virtual ~AIPlayer() = default;
 
-    /// Called for every GF
+    /// Called for every GF. May run concurrently with other AIs (see AIRunner), so the world must only be read
+    /// and all actions have to be queued as game commands or chat messages
     virtual void RunGF(unsigned gf, bool gfisnwf) = 0;
 
+    /// Call RunGF and record the time it took
+    void RunGFTimed(unsigned gf, bool gfisnwf)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        RunGF(gf, gfisnwf);
+        runTimes.last = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        runTimes.max = std::max(runTimes.max, runTimes.last);
+        runTimes.total += runTimes.last;
+        runTimes.numRuns++;
+    }
+    const RunTimes& GetRunTimes() const { return runTimes; }
+
     const std::string& GetPlayerName() const { return player.name; }
     unsigned char GetPlayerId() const { return playerId; }
 
@@ -50,6 +78,14 @@ public:
         return tmp;
     }
 
+    /// Get the chat messages written since the last call
+    std::vector<std::string> FetchChatMessages()
+    {
+        std::vector<std::string> tmp;
+        std::swap(tmp, chatMsgs);
+        return tmp;
+    }
+
     // access to ais CommandFactory
     const AIInterface& getAIInterface() const { return aii; }
     AIInterface& getAIInterface() { return aii; }
@@ -71,6 +107,13 @@ protected:
     const AI::Level level;
     /// Abstrahiertes Interfaces, leitet Befehle weiter an
     AIInterface aii;
+    /// Chat messages to all players which are sent after the AIs ran
+    std::vector<std::string> chatMsgs;
+    /// Random numbers for decisions of this AI. Independent of other AIs so the result doesn't depend on the order they run in
+    std::mt19937 rng;
+
+private:
+    RunTimes runTimes;
 };
 
 #endif //! AIPLAYER_H_INCLUDED
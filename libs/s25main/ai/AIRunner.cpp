@@ -0,0 +1,106 @@
+// Copyright (c) 2005 - 2017 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "AIRunner.h"
+#include "ai/AIPlayer.h"
+#include <algorithm>
+
+AIRunner::AIRunner(unsigned maxThreads)
+    : maxThreads_(maxThreads ? maxThreads : std::max(1u, std::thread::hardware_concurrency())), jobId_(0), numBusyWorkers_(0),
+      stop_(false), ais_(nullptr), gf_(0), isNWF_(false), nextAI_(0)
+{}
+
+AIRunner::~AIRunner()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    startCond_.notify_all();
+    for(std::thread& worker : workers_)
+        worker.join();
+}
+
+void AIRunner::RunGF(boost::ptr_vector<AIPlayer>& ais, unsigned gf, bool isNWF)
+{
+    const unsigned numThreads = std::min<unsigned>(maxThreads_, ais.size());
+    if(numThreads <= 1)
+    {
+        for(AIPlayer& ai : ais)
+            ai.RunGFTimed(gf, isNWF);
+        return;
+    }
+    // Workers start waiting for the job after the current one
+    while(workers_.size() + 1 < numThreads)
+        workers_.emplace_back(&AIRunner::WorkerLoop, this, jobId_);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ais_ = &ais;
+        gf_ = gf;
+        isNWF_ = isNWF;
+        nextAI_ = 0;
+        numBusyWorkers_ = workers_.size();
+        ++jobId_;
+    }
+    startCond_.notify_all();
+    RunAIs();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCond_.wait(lock, [this]() { return numBusyWorkers_ == 0; });
+    ais_ = nullptr;
+    if(error_)
+    {
+        std::exception_ptr error;
+        std::swap(error, error_);
+        std::rethrow_exception(error);
+    }
+}
+
+void AIRunner::WorkerLoop(unsigned lastJobId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(true)
+    {
+        startCond_.wait(lock, [this, lastJobId]() { return stop_ || jobId_ != lastJobId; });
+        if(stop_)
+            return;
+        lastJobId = jobId_;
+        lock.unlock();
+        RunAIs();
+        lock.lock();
+        if(--numBusyWorkers_ == 0)
+            doneCond_.notify_one();
+    }
+}
+
+void AIRunner::RunAIs()
+{
+    for(unsigned i = nextAI_++; i < ais_->size(); i = nextAI_++)
+    {
+        try
+        {
+            (*ais_)[i].RunGFTimed(gf_, isNWF_);
+        } catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(!error_)
+                error_ = std::current_exception();
+        }
+    }
+}
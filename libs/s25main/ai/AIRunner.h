@@ -0,0 +1,70 @@
+// Copyright (c) 2005 - 2017 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AIRunner_h__
+#define AIRunner_h__
+
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class AIPlayer;
+
+/// Runs the AI players for a GF on a pool of worker threads.
+/// The AIs only read the world during AIPlayer::RunGF and queue their commands, so they can plan at the same time.
+/// The commands are fetched afterwards in the fixed order of the AI players which keeps the result deterministic.
+/// All public functions must be called from the same (game) thread
+class AIRunner
+{
+public:
+    /// Use at most maxThreads threads including the calling one. 0 uses the number of hardware threads
+    explicit AIRunner(unsigned maxThreads = 0);
+    ~AIRunner();
+
+    /// Run all AIs for the given GF and return when all are finished. An exception thrown by an AI is rethrown here
+    void RunGF(boost::ptr_vector<AIPlayer>& ais, unsigned gf, bool isNWF);
+    /// Number of worker threads started so far
+    unsigned GetNumWorkers() const { return workers_.size(); }
+
+private:
+    void WorkerLoop(unsigned lastJobId);
+    /// Run the AIs of the current job until none are left
+    void RunAIs();
+
+    unsigned maxThreads_;
+    std::mutex mutex_;
+    std::condition_variable startCond_, doneCond_;
+    std::vector<std::thread> workers_;
+    /// Incremented for every GF so the workers know there is a new job
+    unsigned jobId_;
+    /// Workers still running AIs of the current job
+    unsigned numBusyWorkers_;
+    bool stop_;
+
+    /// Current job
+    boost::ptr_vector<AIPlayer>* ais_;
+    unsigned gf_;
+    bool isNWF_;
+    std::atomic<unsigned> nextAI_;
+    std::exception_ptr error_;
+};
+
+#endif // AIRunner_h__
@@ -42,9 +42,9 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <algorithm>
 #include <array>
-#include <cstdlib>
 #include <limits>
 #include <list>
+#include <random>
 
 namespace AIJH {
 
@@ -491,10 +491,11 @@ BuildingType AIConstruction::ChooseMilitaryBuilding(const MapPoint pt)
     const BuildingType biggestBld = GetBiggestAllowedMilBuilding();
 
     const Inventory& inventory = aii.GetInventory();
-    if(((rand() % 3) == 0 || inventory.people[JOB_PRIVATE] < 15)
+    std::mt19937& rng = aijh.GetRNG();
+    if(((rng() % 3) == 0 || inventory.people[JOB_PRIVATE] < 15)
        && (inventory.goods[GD_STONES] > 6 || bldPlanner.GetNumBuildings(BLD_QUARRY) > 0))
         bld = BLD_GUARDHOUSE;
-    if(aijh.HarborPosClose(pt, 20) && rand() % 10 != 0 && aijh.ggs.getSelection(AddonId::SEA_ATTACK) != 2)
+    if(aijh.HarborPosClose(pt, 20) && rng() % 10 != 0 && aijh.ggs.getSelection(AddonId::SEA_ATTACK) != 2)
     {
         if(aii.CanBuildBuildingtype(BLD_WATCHTOWER))
             return BLD_WATCHTOWER;
@@ -503,7 +504,7 @@ BuildingType AIConstruction::ChooseMilitaryBuilding(const MapPoint pt)
     if(biggestBld == BLD_WATCHTOWER || biggestBld == BLD_FORTRESS)
     {
         if(aijh.UpdateUpgradeBuilding() < 0 && bldPlanner.GetNumBuildingSites(biggestBld) < 1
-           && (inventory.goods[GD_STONES] > 20 || bldPlanner.GetNumBuildings(BLD_QUARRY) > 0) && rand() % 10 != 0)
+           && (inventory.goods[GD_STONES] > 20 || bldPlanner.GetNumBuildings(BLD_QUARRY) > 0) && rng() % 10 != 0)
         {
             return biggestBld;
         }
@@ -518,7 +519,7 @@ BuildingType AIConstruction::ChooseMilitaryBuilding(const MapPoint pt)
         // Prüfen ob Feind in der Nähe
         if(milBld->GetPlayer() != playerId && distance < 35)
         {
-            int randmil = rand();
+            unsigned randmil = rng();
             bool buildCatapult = randmil % 8 == 0 && aii.CanBuildCatapult() && bldPlanner.GetNumAdditionalBuildingsWanted(BLD_CATAPULT) > 0;
             // another catapult within "min" radius? ->dont build here!
             const unsigned min = 16;
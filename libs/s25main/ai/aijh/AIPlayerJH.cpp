@@ -21,6 +21,7 @@
 #include "BuildingPlanner.h"
 #include "FindWhConditions.h"
 #include "GamePlayer.h"
+#include "GlobalGameSettings.h"
 #include "Jobs.h"
 #include "addons/const_addons.h"
 #include "ai/AIEvents.h"
@@ -30,8 +31,6 @@
 #include "buildings/nobMilitary.h"
 #include "buildings/nobUsual.h"
 #include "helpers/containerUtils.h"
-#include "network/GameClient.h"
-#include "network/GameMessages.h"
 #include "notifications/BuildingNote.h"
 #include "notifications/ExpeditionNote.h"
 #include "notifications/NodeNote.h"
@@ -283,7 +282,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
         DistributeGoodsByBlocking(GD_BOARDS, 30);
         DistributeGoodsByBlocking(GD_STONES, 50);
         // go to the picked random warehouse and try to build around it
-        int randomStore = rand() % (storehouses.size());
+        int randomStore = rng() % storehouses.size();
         auto it = storehouses.begin();
         std::advance(it, randomStore);
         const MapPoint whPos = (*it)->GetPos();
@@ -304,7 +303,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
     const std::list<nobMilitary*>& militaryBuildings = aii.GetMilitaryBuildings();
     if(militaryBuildings.empty())
         return;
-    int randomMiliBld = rand() % (militaryBuildings.size());
+    int randomMiliBld = rng() % militaryBuildings.size();
     auto it2 = militaryBuildings.begin();
     std::advance(it2, randomMiliBld);
     MapPoint bldPos = (*it2)->GetPos();
@@ -1307,7 +1306,7 @@ void AIPlayerJH::HandleExpedition(const noShip* ship)
         aii.FoundColony(ship);
     else
     {
-        unsigned char start = rand() % ShipDirection::COUNT;
+        unsigned char start = rng() % ShipDirection::COUNT;
         for(unsigned char i = start; i < start + ShipDirection::COUNT; ++i)
         {
             if(aii.IsExplorationDirectionPossible(ship->GetPos(), ship->GetCurrentHarbor(), ShipDirection(i)))
@@ -1353,7 +1352,7 @@ void AIPlayerJH::HandleTreeChopped(const MapPoint pt)
 
     UpdateNodesAround(pt, 3);
 
-    int random = rand();
+    unsigned random = rng();
 
     if(random % 2 == 0)
         AddBuildJob(construction->ChooseMilitaryBuilding(pt), pt);
@@ -1544,7 +1543,7 @@ void AIPlayerJH::MilUpgradeOptim()
 
 void AIPlayerJH::Chat(const std::string& message)
 {
-    GAMECLIENT.GetMainPlayer().sendMsgAsync(new GameMessage_Chat(playerId, CD_ALL, message));
+    chatMsgs.push_back(message);
 }
 
 bool AIPlayerJH::HasFrontierBuildings()
@@ -1620,7 +1619,7 @@ void AIPlayerJH::TryToAttack()
         // We skip the current building with a probability of limit/numMilBlds
         // -> For twice the number of blds as the limit we will most likely skip every 2nd building
         // This way we check roughly (at most) limit buildings but avoid any preference for one building over an other
-        if(rand() % numMilBlds > limit)
+        if(rng() % numMilBlds > limit)
             continue;
 
         if(milBld->GetFrontierDistance() == 0) // inland building? -> skip it
@@ -1651,7 +1650,7 @@ void AIPlayerJH::TryToAttack()
     }
 
     // shuffle everything but headquarters and harbors without any troops in them
-    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(), std::mt19937(std::random_device()()));
+    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(), rng);
 
     // check for each potential attacking target the number of available attacking soldiers
     for(const nobBaseMilitary* target : potentialTargets)
@@ -1762,11 +1761,10 @@ void AIPlayerJH::TrySeaAttack()
             // \n",gwb.GetHarborPoint(i).x,gwb.GetHarborPoint(i).y);
         }
     }
-    auto prng = std::mt19937(std::random_device()());
     // any undefendedTargets? -> pick one by random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers = gwb.GetSoldiersForSeaAttack(playerId, targetMilBld->GetPos());
@@ -1781,7 +1779,7 @@ void AIPlayerJH::TrySeaAttack()
     unsigned limit = 15;
     unsigned skip = 0;
     if(searcharoundharborspots.size() > 15)
-        skip = max<int>(rand() % (searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
+        skip = max<int>(rng() % (searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
     for(unsigned i = skip; i < searcharoundharborspots.size() && limit > 0; i++)
     {
         limit--;
@@ -1816,7 +1814,7 @@ void AIPlayerJH::TrySeaAttack()
     // one we can attack("should" be the first we check...)  any undefendedTargets? -> pick one by random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers = gwb.GetSoldiersForSeaAttack(playerId, targetMilBld->GetPos());
@@ -1827,7 +1825,7 @@ void AIPlayerJH::TrySeaAttack()
             }
         }
     }
-    std::shuffle(potentialTargets.begin(), potentialTargets.end(), prng);
+    std::shuffle(potentialTargets.begin(), potentialTargets.end(), rng);
     for(const nobBaseMilitary* ship : potentialTargets)
     {
         // TODO: decide if it is worth attacking the target and not just "possible"
@@ -183,6 +183,8 @@ public:
     void HandleLostLand(MapPoint pt);
     /// Sends a chat messsage to all players
     void Chat(const std::string& message);
+    /// Random number generator of this AI
+    std::mt19937& GetRNG() { return rng; }
     /// check expeditions (order new / cancel)
     void CheckExpeditions();
     /// if we have 1 complete forester but less than 1 military building and less than 2 buildingsites stop production
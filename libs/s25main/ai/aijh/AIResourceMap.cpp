@@ -22,6 +22,7 @@
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobUsual.h"
 #include "gameData/TerrainDesc.h"
+#include <cstdlib>
 
 namespace AIJH {
 
@@ -36,18 +37,20 @@ void AIResourceMap::Init()
     const MapExtent mapSize = aiMap.GetSize();
 
     map.Resize(mapSize);
+    std::vector<MapPoint> resPts;
     RTTR_FOREACH_PT(MapPoint, mapSize)
     {
         const Node& node = aiMap[pt];
         if(res == AIResource::FISH && node.res == res)
-            Change(pt, 1);
+            resPts.push_back(pt);
         else if(aii.gwb.GetDescription().get(aii.gwb.GetNode(pt).t1).Is(ETerrain::Walkable))
         {
             if((res != AIResource::BORDERLAND && node.res == res) || (res == AIResource::BORDERLAND && aii.IsBorder(pt))
                || (node.res == AIResource::MULTIPLE && (aii.GetSubsurfaceResource(pt) == res || aii.GetSurfaceResource(pt) == res)))
-                Change(pt, 1);
+                resPts.push_back(pt);
         }
     }
+    ChangeAll(map, resPts, resRadius, 1);
 }
 
 void AIResourceMap::Recalc()
@@ -100,6 +103,63 @@ void AIResourceMap::Change(const MapPoint pt, unsigned radius, int value)
     aii.gwb.CheckPointsInRadius(pt, radius, ValueAdjuster(map, radius, value), true);
 }
 
+void AIResourceMap::ChangeAll(NodeMapBase<int>& map, const std::vector<MapPoint>& pts, unsigned radius, int value)
+{
+    if(pts.empty() || radius == 0u)
+        return;
+
+    // In a row with distance k from pt the nodes in a range of k+1 nodes have the distance k, the distance of the others increases
+    // by 1 per node. So the added values of a row form a trapezoid, which can be stored as 4 changes of its slope.
+    // Rows have a margin so the trapezoids don't need to wrap, the margins are folded back into the map afterwards.
+    // As the map height is even the shift of the rows continues over the map border
+    const MapExtent size = map.GetSize();
+    const int r = radius;
+    const int width = size.x;
+    const int height = size.y;
+    const int margin = r + 1;
+    const int stride = width + 2 * margin;
+    std::vector<int> slopeChanges(static_cast<size_t>(stride) * height);
+    for(const MapPoint pt : pts)
+    {
+        for(int dy = 1 - r; dy < r; ++dy)
+        {
+            const int k = std::abs(dy);
+            const int y = pt.y + dy;
+            const int rowY = (y % height + height) % height;
+            // Difference of the shifts of the rows, has the same parity as k
+            const int shiftDiff = (y & 1) - (pt.y & 1);
+            // First and last node with distance k
+            const int first = pt.x + (-k - shiftDiff) / 2;
+            const int last = pt.x + (k - shiftDiff) / 2;
+            // Value added at the nodes with distance k and number of nodes with a lower value on each side
+            const int maxValue = r - k;
+            int* row = &slopeChanges[static_cast<size_t>(rowY) * stride + margin];
+            row[first - maxValue + 1] += value;
+            row[first + 1] -= value;
+            row[last + 1] -= value;
+            row[last + maxValue + 1] += value;
+        }
+    }
+
+    // x coordinate of the first entry of a row
+    const int startX = ((-margin) % width + width) % width;
+    for(int y = 0; y < height; ++y)
+    {
+        const int* row = &slopeChanges[static_cast<size_t>(y) * stride];
+        const unsigned rowIdx = y * width;
+        int slope = 0;
+        int curValue = 0;
+        for(int i = 0, x = startX; i < stride; ++i)
+        {
+            slope += row[i];
+            curValue += slope;
+            map[rowIdx + x] += curValue;
+            if(++x == width)
+                x = 0;
+        }
+    }
+}
+
 MapPoint AIResourceMap::FindGoodPosition(const MapPoint& pt, int threshold, BuildingQuality size, int radius, bool inTerritory) const
 {
     RTTR_Assert(pt.x < map.GetWidth() && pt.y < map.GetHeight());
@@ -108,20 +168,19 @@ MapPoint AIResourceMap::FindGoodPosition(const MapPoint& pt, int threshold, Buil
     if(radius == -1)
         radius = 30;
 
-    std::vector<MapPoint> pts = aii.gwb.GetPointsInRadiusWithCenter(pt, radius);
-    for(const MapPoint& curPt : pts)
-    {
+    MapPoint result = MapPoint::Invalid();
+    const auto isGoodPos = [&](const MapPoint curPt, unsigned /*distance*/) {
         const unsigned idx = map.GetIdx(curPt);
-        if(map[idx] >= threshold)
-        {
-            if((inTerritory && !aiMap[idx].owned) || aiMap[idx].farmed)
-                continue;
-            RTTR_Assert(aii.GetBuildingQuality(curPt) == aiMap[curPt].bq);
-            if(canUseBq(aii.GetBuildingQuality(curPt), size)) //(*nodes)[idx].bq; TODO: Update nodes BQ and use that
-                return curPt;
-        }
-    }
-    return MapPoint::Invalid();
+        if(map[idx] < threshold || (inTerritory && !aiMap[idx].owned) || aiMap[idx].farmed)
+            return false;
+        RTTR_Assert(aii.GetBuildingQuality(curPt) == aiMap[curPt].bq);
+        if(!canUseBq(aii.GetBuildingQuality(curPt), size)) //(*nodes)[idx].bq; TODO: Update nodes BQ and use that
+            return false;
+        result = curPt;
+        return true;
+    };
+    aii.gwb.CheckPointsInRadius(pt, radius, isGoodPos, true);
+    return result;
 }
 
 MapPoint AIResourceMap::FindBestPosition(const MapPoint& pt, BuildingQuality size, int minimum, int radius, bool inTerritory) const
@@ -135,14 +194,12 @@ MapPoint AIResourceMap::FindBestPosition(const MapPoint& pt, BuildingQuality siz
     MapPoint best = MapPoint::Invalid();
     int best_value = (minimum == std::numeric_limits<int>::min()) ? minimum : minimum - 1;
 
-    std::vector<MapPoint> pts = aii.gwb.GetPointsInRadiusWithCenter(pt, radius);
-    for(const MapPoint& curPt : pts)
-    {
+    const auto checkPos = [&](const MapPoint curPt, unsigned /*distance*/) {
         const unsigned idx = map.GetIdx(curPt);
         if(map[idx] > best_value)
         {
             if(!aiMap[idx].reachable || (inTerritory && !aiMap[idx].owned) || aiMap[idx].farmed)
-                continue;
+                return false;
             RTTR_Assert(aii.GetBuildingQuality(curPt) == aiMap[curPt].bq);
             if(canUseBq(aii.GetBuildingQuality(curPt), size)) //(*nodes)[idx].bq; TODO: Update nodes BQ and use that
             {
@@ -150,7 +207,9 @@ MapPoint AIResourceMap::FindBestPosition(const MapPoint& pt, BuildingQuality siz
                 best_value = map[idx];
             }
         }
-    }
+        return false; // Check all points
+    };
+    aii.gwb.CheckPointsInRadius(pt, radius, checkPos, true);
 
     return best;
 }
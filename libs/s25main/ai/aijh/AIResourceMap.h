@@ -23,6 +23,7 @@
 #include "world/NodeMapBase.h"
 #include "gameTypes/BuildingQuality.h"
 #include "gameTypes/BuildingType.h"
+#include <vector>
 
 class AIInterface;
 namespace AIJH {
@@ -54,6 +55,10 @@ public:
     int& operator[](const MapPoint& pt) { return map[pt]; }
     int operator[](const MapPoint& pt) const { return map[pt]; }
 
+    /// Same as calling Change for each of the points but with one pass over the affected rows instead of visiting every node
+    /// in the radius of each point: O(radius) per point plus O(size of the map)
+    static void ChangeAll(NodeMapBase<int>& map, const std::vector<MapPoint>& pts, unsigned radius, int value);
+
 private:
     void AdjustRatingForBlds(BuildingType bld, unsigned radius, int value);
     /// Which resource is stored in the map and radius of affected nodes
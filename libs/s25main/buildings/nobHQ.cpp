@@ -333,6 +333,7 @@ nobHQ::nobHQ(const MapPoint pos, const unsigned char player, const Nation nation
 
     // ins Militärquadrat einfügen
     gwg->GetMilitarySquares().Add(this);
+    gwg->AddViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
     gwg->RecalcTerritory(*this, TerritoryChangeReason::Build);
 }
 
@@ -341,6 +342,7 @@ void nobHQ::DestroyBuilding()
     nobBaseWarehouse::DestroyBuilding();
     // Wieder aus dem Militärquadrat rauswerfen
     gwg->GetMilitarySquares().Remove(this);
+    gwg->RemoveViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
     // Recalc territory. AFTER calling base destroy as otherwise figures might get stuck here
     gwg->RecalcTerritory(*this, TerritoryChangeReason::Destroyed);
 }
@@ -69,6 +69,7 @@ nobHarborBuilding::nobHarborBuilding(const MapPoint pos, const unsigned char pla
 {
     // ins Militärquadrat einfügen
     gwg->GetMilitarySquares().Add(this);
+    gwg->AddViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
     gwg->RecalcTerritory(*this, TerritoryChangeReason::Build);
 
     // Alle Waren 0
@@ -93,6 +94,13 @@ nobHarborBuilding::nobHarborBuilding(const MapPoint pos, const unsigned char pla
                     new PostMsgWithBuilding(GetEvMgr().GetCurrentGF(), _("New harbor building finished"), PostCategory::Economy, *this));
 }
 
+void nobHarborBuilding::Destroy()
+{
+    // From now on the harbor has no ship connections (see IsBeingDestroyedNow), so cached ware paths must not use them
+    gwg->GetRoadPathFinder().InvalidateWarePaths(player);
+    noBuilding::Destroy();
+}
+
 void nobHarborBuilding::DestroyBuilding()
 {
     GetEvMgr().RemoveEvent(orderware_ev);
@@ -159,6 +167,7 @@ void nobHarborBuilding::DestroyBuilding()
     nobBaseWarehouse::DestroyBuilding();
 
     gwg->GetMilitarySquares().Remove(this);
+    gwg->RemoveViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
     // Recalc territory. AFTER calling base destroy as otherwise figures might get stuck here
     gwg->RecalcTerritory(*this, TerritoryChangeReason::Destroyed);
 }
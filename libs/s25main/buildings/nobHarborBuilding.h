@@ -116,6 +116,7 @@ protected:
     void DestroyBuilding() override;
 
 public:
+    void Destroy() override;
     unsigned GetMilitaryRadius() const override { return HARBOR_RADIUS; }
 
     /// Serialisierung
@@ -102,6 +102,8 @@ void nobMilitary::DestroyBuilding()
 {
     // Remove from military square and buildings first, to avoid e.g. sending canceled soldiers back to this building
     gwg->GetMilitarySquares().Remove(this);
+    if(!new_built)
+        gwg->RemoveViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
 
     // Bestellungen stornieren
     CancelOrders();
@@ -684,6 +686,7 @@ void nobMilitary::AddPassiveSoldier(nofPassiveSoldier* soldier)
                                                         *this, SoundEffect::Fanfare));
         // Ist nun besetzt
         new_built = false;
+        gwg->AddViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
         // Landgrenzen verschieben
         gwg->RecalcTerritory(*this, TerritoryChangeReason::Build);
         // Tür zumachen
@@ -921,8 +924,13 @@ void nobMilitary::Capture(const unsigned char new_owner)
     // Alten Besitzer merken
     unsigned char old_player = player;
     gwg->GetPlayer(old_player).RemoveBuilding(this, bldType_);
+    // The military squares store the owner
+    gwg->GetMilitarySquares().Remove(this);
     // neuer Spieler
     player = new_owner;
+    gwg->GetMilitarySquares().Add(this);
+    gwg->RemoveViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, old_player);
+    gwg->AddViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, player);
     // In der Wirtschaftsverwaltung dieses Gebäude jetzt zum neuen Spieler zählen und beim alten raushauen
     gwg->GetPlayer(new_owner).AddBuilding(this, bldType_);
 
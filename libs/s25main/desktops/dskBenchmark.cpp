@@ -33,6 +33,7 @@
 #include "lua/GameDataLoader.h"
 #include "ogl/FontStyle.h"
 #include "ogl/IRenderer.h"
+#include "ogl/SpriteBatch.h"
 #include "random/Random.h"
 #include "world/GameWorld.h"
 #include "world/GameWorldView.h"
@@ -43,6 +44,7 @@
 #include "s25util/Log.h"
 #include "s25util/strFuncs.h"
 #include <helpers/chronoIO.h>
+#include <boost/format.hpp>
 #include <memory>
 #include <random>
 
@@ -51,6 +53,7 @@ enum
 {
     ID_txtHelp = dskMenuBase::ID_FIRST_FREE,
     ID_txtAmount,
+    ID_txtStats,
     ID_first
 };
 }
@@ -75,6 +78,7 @@ dskBenchmark::dskBenchmark() : curTest_(TEST_NONE), runAll_(false), numInstances
     AddText(ID_txtHelp, DrawPoint(5, 5), "Use F1-F5 to start benchmark, F10 for all, NUM_n to set amount of instances", COLOR_YELLOW,
             FontStyle::LEFT, LargeFont);
     AddText(ID_txtAmount, DrawPoint(795, 5), "Instances: default", COLOR_YELLOW, FontStyle::RIGHT, LargeFont);
+    AddText(ID_txtStats, DrawPoint(5, 25), "", COLOR_YELLOW, FontStyle::LEFT, NormalFont);
     for(std::chrono::milliseconds& t : testDurations_)
         t = std::chrono::milliseconds::zero();
 }
@@ -104,7 +108,12 @@ bool dskBenchmark::Msg_KeyDown(const KeyEvent& ke)
             startTest(TEST_TEXT);
             break;
         case KT_CHAR:
-            if(ke.c >= '0' && ke.c <= '9')
+            if(ke.c == 'b')
+            {
+                SpriteBatch& spriteBatch = VIDEODRIVER.GetSpriteBatch();
+                spriteBatch.SetEnabled(!spriteBatch.IsEnabled());
+                break;
+            } else if(ke.c >= '0' && ke.c <= '9')
             {
                 numInstances_ = (ke.c - '0') * 100;
                 if(numInstances_ == 0)
@@ -130,6 +139,12 @@ void dskBenchmark::Msg_PaintAfter()
         roadState.mode = RM_DISABLED;
         gameView_->view.Draw(roadState, MapPoint::Invalid(), false);
     }
+    const SpriteBatch& spriteBatch = VIDEODRIVER.GetSpriteBatch();
+    const SpriteBatch::Statistics& stats = spriteBatch.GetLastFrameStatistics();
+    GetCtrl<ctrlText>(ID_txtStats)
+      ->SetText((boost::format("Batching (B): %1%, Draw calls: %2%, Quads: %3%, Flushes: %4%") % (spriteBatch.IsEnabled() ? "on" : "off")
+                 % stats.numDrawCalls % stats.numQuads % stats.numFlushes)
+                  .str());
     if(curTest_ != TEST_NONE)
     {
         if(frameCtr_.getCurNumFrames() + 1u >= numTestFrames)
@@ -290,6 +305,8 @@ void dskBenchmark::finishTest()
     using namespace std::chrono;
     LOG.write("Benchmark #%1% took %2%. -> %3%m/frame\n") % curTest_ % duration_cast<duration<float>>(frameCtr_.getCurIntervalLength())
       % duration_cast<milliseconds>(frameCtr_.getCurIntervalLength() / frameCtr_.getCurNumFrames());
+    const SpriteBatch::Statistics& stats = VIDEODRIVER.GetSpriteBatch().GetLastFrameStatistics();
+    LOG.write("Last frame: %1% draw calls, %2% quads, %3% flushes\n") % stats.numDrawCalls % stats.numQuads % stats.numFlushes;
     if(testDurations_[curTest_] == milliseconds::zero())
         testDurations_[curTest_] = duration_cast<milliseconds>(frameCtr_.getCurIntervalLength());
     else
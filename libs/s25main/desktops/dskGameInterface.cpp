@@ -1095,6 +1095,15 @@ void dskGameInterface::CI_PlayerLeft(const unsigned playerId)
     messenger.AddMessage("", 0, CD_SYSTEM, text, COLOR_GREEN);
 }
 
+void dskGameInterface::CI_GameRestored(const std::shared_ptr<Game>& game)
+{
+    // Everything here refers to the old game, so replace this desktop but keep the view
+    auto newInterface = std::make_unique<dskGameInterface>(game, nwfInfo_, worldViewer.GetPlayerId());
+    newInterface->gwv.MoveTo(gwv.GetOffset(), true);
+    GAMECLIENT.SetInterface(newInterface.get());
+    WINDOWMANAGER.Switch(std::move(newInterface));
+}
+
 void dskGameInterface::CI_GGSChanged(const GlobalGameSettings& /*ggs*/)
 {
     // TODO: print what has changed
@@ -1124,6 +1133,11 @@ void dskGameInterface::CI_ReplayEndReached(const std::string& msg)
     messenger.AddMessage("", 0, CD_SYSTEM, msg, COLOR_BLUE);
 }
 
+void dskGameInterface::CI_AutosaveFailed(const std::string& filePath, const std::string& error)
+{
+    messenger.AddMessage("", 0, CD_SYSTEM, helpers::format(_("Auto-save to \"%s\" failed: %s"), filePath, error), COLOR_RED);
+}
+
 void dskGameInterface::CI_GamePaused()
 {
     messenger.AddMessage(_("SYSTEM"), COLOR_GREY, CD_SYSTEM, _("Game was paused."));
@@ -62,11 +62,13 @@ public:
     RoadBuildMode GetRoadMode() const { return road.mode; }
 
     void CI_PlayerLeft(unsigned playerId) override;
+    void CI_GameRestored(const std::shared_ptr<Game>& game) override;
     void CI_GGSChanged(const GlobalGameSettings& ggs) override;
     void CI_Chat(unsigned playerId, ChatDestination cd, const std::string& msg) override;
     void CI_Async(const std::string& checksums_list) override;
     void CI_ReplayAsync(const std::string& msg) override;
     void CI_ReplayEndReached(const std::string& msg) override;
+    void CI_AutosaveFailed(const std::string& filePath, const std::string& error) override;
     void CI_GamePaused() override;
     void CI_GameResumed() override;
     void CI_Error(ClientError ce) override;
@@ -52,6 +52,9 @@
 #include "libsiedler2/prototypen.h"
 #include "s25util/utf8.h"
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <utility>
 //#include <boost/thread.hpp>
 
@@ -63,7 +66,8 @@
  *  @param[in] pass Server-Passwort
  */
 dskSelectMap::dskSelectMap(CreateServerInfo csi)
-    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr)
+    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr),
+      mapCatalogue(RTTRCONFIG.ExpandPath(FILE_PATHS[97]) + "/maps.dat"), abortMapScan(false)
 {
     WorldDescription desc;
     GameDataLoader gdLoader(desc);
@@ -134,6 +138,8 @@ dskSelectMap::dskSelectMap(CreateServerInfo csi)
     AddText(12, DrawPoint(260, 470), _("Map: "), COLOR_YELLOW, FontStyle::LEFT, NormalFont);
     AddText(13, DrawPoint(260, 490), _("Mapfile: "), COLOR_YELLOW, FontStyle::LEFT, NormalFont);
 
+    mapCatalogue.Load();
+
     // "Eigene" auswählen
     optiongroup->SetSelection(5, true);
 
@@ -145,6 +151,8 @@ dskSelectMap::~dskSelectMap()
 {
     // if(mapGenThread)
     //    mapGenThread->join();
+    // Don't wait for a scan of all remaining maps
+    abortMapScan = true;
     LOBBYCLIENT.RemoveListener(this);
     GAMECLIENT.RemoveInterface(this);
 }
@@ -160,22 +168,34 @@ void dskSelectMap::Msg_OptionGroupChange(const unsigned /*ctrl_id*/, unsigned se
     static const std::array<unsigned, 9> ids = {{39, 40, 41, 42, 43, 52, 91, 93, 48}};
 
     const std::string mapPath = RTTRCONFIG.ExpandPath(FILE_PATHS[ids[selection]]);
-    FillTable(ListDir(mapPath, "swd"));
-    FillTable(ListDir(mapPath, "wld"));
+    std::vector<std::string> folders{mapPath};
     // For own maps (WORLDS folder) also use the one in the installation folder as S2 does
     if(bfs::path(mapPath).filename() == "WORLDS")
+        folders.push_back(RTTRCONFIG.ExpandPath("WORLDS"));
+    StartMapScan(folders);
+}
+
+void dskSelectMap::StartMapScan(const std::vector<std::string>& folders)
+{
+    if(mapScan.valid())
     {
-        const std::string worldsPath = RTTRCONFIG.ExpandPath("WORLDS");
-        FillTable(ListDir(worldsPath, "swd"));
-        FillTable(ListDir(worldsPath, "wld"));
+        abortMapScan = true;
+        mapScan.wait();
     }
-
-    // Dann noch sortieren
-    bool sortAsc = true;
-    table->SortRows(0, &sortAsc);
-
-    // und Auswahl zurücksetzen
-    table->SetSelection(0);
+    abortMapScan = false;
+    mapScan = std::async(std::launch::async, [this, folders]() {
+        std::vector<std::string> files;
+        for(const std::string& folder : folders)
+        {
+            files = ListDir(folder, "swd", false, &files);
+            files = ListDir(folder, "wld", false, &files);
+        }
+        std::vector<MapCatalogue::Entry> maps = mapCatalogue.Update(files, 0, &abortMapScan);
+        if(!abortMapScan)
+            mapCatalogue.RemoveMissing(folders, files);
+        mapCatalogue.Save();
+        return maps;
+    });
 }
 
 /**
@@ -200,24 +220,15 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const int selecti
     // is the selection valid?
     if(!path.empty())
     {
-        libsiedler2::Archiv ai;
-        // load map data
-        int ec = libsiedler2::loader::LoadMAP(path, ai);
-        if(ec || !dynamic_cast<glArchivItem_Map*>(ai[0]))
-            MarkMapAsBroken(selection, libsiedler2::getErrorString(ec));
-        else
-        {
-            const glArchivItem_Map* map = static_cast<glArchivItem_Map*>(ai[0]);
-            if(map->getHeader().getWidth() > MAX_MAP_SIZE || map->getHeader().getHeight() > MAX_MAP_SIZE)
-                MarkMapAsBroken(selection, "Map is bigger than allowed size of " + std::to_string(MAX_MAP_SIZE) + " nodes");
-            else
-            {
-                preview.SetMap(map);
-                txtMapName.SetText(s25util::ansiToUTF8(map->getHeader().getName()));
-                txtMapPath.SetText(path);
-                btContinue.SetEnabled(true);
-            }
-        }
+        // Load the map data in the background, replacing the result of a previous selection.
+        // A still running load is kept until finished as destroying its future would block
+        if(previewLoad.valid())
+            stalePreviewLoads.push_back(std::move(previewLoad));
+        previewLoad = std::async(std::launch::async, [path]() {
+            LoadedMap map{path, 0, std::make_unique<libsiedler2::Archiv>()};
+            map.errorCode = libsiedler2::loader::LoadMAP(path, *map.archiv);
+            return map;
+        });
     }
     DrawPoint txtPos = txtMapName.GetPos();
     txtPos.x = preview.GetPos().x + preview.GetSize().x + 10;
@@ -227,6 +238,31 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const int selecti
     txtMapPath.SetPos(txtPos);
 }
 
+void dskSelectMap::ShowPreview(const LoadedMap& map)
+{
+    ctrlTable& table = *GetCtrl<ctrlTable>(1);
+    const int selection = table.GetSelection();
+    if(selection < 0 || table.GetItemText(selection, 5) != map.filePath)
+        return;
+
+    libsiedler2::Archiv& ai = *map.archiv;
+    if(map.errorCode || !dynamic_cast<glArchivItem_Map*>(ai[0]))
+        MarkMapAsBroken(selection, libsiedler2::getErrorString(map.errorCode));
+    else
+    {
+        const glArchivItem_Map* s2map = static_cast<glArchivItem_Map*>(ai[0]);
+        if(s2map->getHeader().getWidth() > MAX_MAP_SIZE || s2map->getHeader().getHeight() > MAX_MAP_SIZE)
+            MarkMapAsBroken(selection, "Map is bigger than allowed size of " + std::to_string(MAX_MAP_SIZE) + " nodes");
+        else
+        {
+            GetCtrl<ctrlPreviewMinimap>(11)->SetMap(s2map);
+            GetCtrl<ctrlText>(12)->SetText(s25util::ansiToUTF8(s2map->getHeader().getName()));
+            GetCtrl<ctrlText>(13)->SetText(map.filePath);
+            GetCtrl<ctrlButton>(5)->SetEnabled(true);
+        }
+    }
+}
+
 void dskSelectMap::GoBack()
 {
     if(csi.type == ServerType::LOCAL)
@@ -291,7 +327,8 @@ void dskSelectMap::CreateRandomMap()
 
     try
     {
-        // create a random map and save filepath
+        // create a random map using all cores and save filepath
+        rndMapSettings.numThreads = std::max(1u, std::thread::hardware_concurrency());
         MapGenerator::Create(mapPath, rndMapSettings);
         newRandMapPath = mapPath;
     } catch(std::runtime_error& e)
@@ -307,22 +344,10 @@ void dskSelectMap::OnMapCreated(const std::string& mapPath)
         waitWnd->Close();
         waitWnd = nullptr;
     }
-    // select the "played maps" entry
+    // select the "played maps" entry and the random map in it when they are listed
+    mapToSelect = mapPath;
     auto* optionGroup = GetCtrl<ctrlOptionGroup>(10);
     optionGroup->SetSelection(8, true);
-
-    // search for the random map entry and select it in the table
-    auto* table = GetCtrl<ctrlTable>(1);
-    for(int i = 0; i < table->GetNumRows(); i++)
-    {
-        std::string entryPath = table->GetItemText(i, 5);
-
-        if(entryPath == mapPath)
-        {
-            table->SetSelection(i);
-            break;
-        }
-    }
 }
 
 /// Startet das Spiel mit einer bestimmten Auswahl in der Tabelle
@@ -410,41 +435,56 @@ void dskSelectMap::Draw_()
             OnMapCreated(newRandMapPath);
         newRandMapPath.clear();
     }
+    if(mapScan.valid() && mapScan.wait_for(std::chrono::seconds::zero()) == std::future_status::ready)
+        FillTable(mapScan.get());
+    if(previewLoad.valid() && previewLoad.wait_for(std::chrono::seconds::zero()) == std::future_status::ready)
+        ShowPreview(previewLoad.get());
+    helpers::remove_if(stalePreviewLoads, [](const std::future<LoadedMap>& load) {
+        return load.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    });
     Desktop::Draw_();
 }
 
-void dskSelectMap::FillTable(const std::vector<std::string>& files)
+void dskSelectMap::FillTable(const std::vector<MapCatalogue::Entry>& maps)
 {
     auto* table = GetCtrl<ctrlTable>(1);
 
-    for(const std::string& filePath : files)
+    for(const MapCatalogue::Entry& map : maps)
     {
-        if(helpers::contains(brokenMapPaths, filePath))
-            continue;
-        // Karteninformationen laden
-        libsiedler2::Archiv map;
-        if(libsiedler2::loader::LoadMAP(filePath, map, true) != 0)
-            continue;
-
-        const libsiedler2::ArchivItem_Map_Header& header = checkedCast<const glArchivItem_Map*>(map[0])->getHeader();
-
-        if(header.getNumPlayers() > MAX_PLAYERS)
+        if(!map.isValid || map.numPlayers > MAX_PLAYERS || helpers::contains(brokenMapPaths, map.filePath))
             continue;
 
-        const bfs::path luaFilepath = bfs::path(filePath).replace_extension("lua");
-        const bool hasLua = bfs::is_regular_file(luaFilepath);
-
         // Und Zeilen vorbereiten
-        std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(header.getNumPlayers())).str();
-        std::string size = helpers::toString(header.getWidth()) + "x" + helpers::toString(header.getHeight());
+        std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(map.numPlayers)).str();
+        std::string size = helpers::toString(map.width) + "x" + helpers::toString(map.height);
 
-        std::string name = s25util::ansiToUTF8(header.getName());
-        if(hasLua)
+        std::string name = s25util::ansiToUTF8(map.name);
+        if(map.hasLua)
             name += " (*)";
-        std::string author = s25util::ansiToUTF8(header.getAuthor());
+        std::string author = s25util::ansiToUTF8(map.author);
+
+        table->AddRow({name, author, players, landscapeNames[map.gfxSet], size, map.filePath});
+    }
+
+    // Dann noch sortieren
+    bool sortAsc = true;
+    table->SortRows(0, &sortAsc);
 
-        table->AddRow({name, author, players, landscapeNames[header.getGfxSet()], size, filePath});
+    // und Auswahl zurücksetzen
+    int selection = 0;
+    if(!mapToSelect.empty())
+    {
+        for(int i = 0; i < table->GetNumRows(); i++)
+        {
+            if(table->GetItemText(i, 5) == mapToSelect)
+            {
+                selection = i;
+                break;
+            }
+        }
+        mapToSelect.clear();
     }
+    table->SetSelection(selection);
 }
 
 void dskSelectMap::MarkMapAsBroken(const int tableIdx, const std::string& reason)
@@ -20,16 +20,23 @@
 #pragma once
 
 #include "Desktop.h"
+#include "MapCatalogue.h"
 #include "mapGenerator/MapSettings.h"
 #include "network/ClientInterface.h"
 #include "network/CreateServerInfo.h"
 #include "liblobby/LobbyInterface.h"
+#include <atomic>
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace boost {
 class thread;
 }
+namespace libsiedler2 {
+class Archiv;
+}
 
 class dskSelectMap final : public Desktop, public ClientInterface, public LobbyInterface
 {
@@ -40,7 +47,10 @@ public:
 private:
     void Draw_() override;
 
-    void FillTable(const std::vector<std::string>& files);
+    /// Fill the table with the scanned maps and select the first one or mapToSelect
+    void FillTable(const std::vector<MapCatalogue::Entry>& maps);
+    /// List the maps in the given folders in the background. A running scan gets aborted
+    void StartMapScan(const std::vector<std::string>& folders);
 
     void Msg_OptionGroupChange(unsigned ctrl_id, unsigned selection) override;
     void Msg_ButtonClick(unsigned ctrl_id) override;
@@ -71,6 +81,15 @@ private:
     void OnMapCreated(const std::string& mapPath);
     void MarkMapAsBroken(int tableIdx, const std::string& reason);
 
+    struct LoadedMap
+    {
+        std::string filePath;
+        int errorCode;
+        std::unique_ptr<libsiedler2::Archiv> archiv;
+    };
+    /// Show the preview of a map loaded in the background if it is still selected
+    void ShowPreview(const LoadedMap& map);
+
     CreateServerInfo csi;
     MapSettings rndMapSettings;
     boost::thread* mapGenThread;
@@ -80,6 +99,15 @@ private:
     std::map<uint8_t, std::string> landscapeNames;
     /// Maps that we already know are broken
     std::vector<std::string> brokenMapPaths;
+    /// Index of the map headers stored in the user folder
+    MapCatalogue mapCatalogue;
+    std::atomic<bool> abortMapScan;
+    std::future<std::vector<MapCatalogue::Entry>> mapScan;
+    /// Map to select when the running scan is finished
+    std::string mapToSelect;
+    std::future<LoadedMap> previewLoad;
+    /// Loads of previously selected maps which are still running
+    std::vector<std::future<LoadedMap>> stalePreviewLoads;
 };
 
 #endif //! dskSELECTMAP_H_INCLUDED
@@ -26,6 +26,7 @@
 #include "mygettext/mygettext.h"
 #include "ogl/DummyRenderer.h"
 #include "ogl/OpenGLRenderer.h"
+#include "ogl/SpriteBatch.h"
 #include "openglCfg.hpp"
 #include "s25util/Log.h"
 #include "s25util/error.h"
@@ -43,7 +44,9 @@ using SwapIntervalExt_t = int(int);
 
 SwapIntervalExt_t* wglSwapIntervalEXT = nullptr;
 
-VideoDriverWrapper::VideoDriverWrapper() : videodriver(nullptr, nullptr), renderer_(nullptr), enableMouseWarping(true), texture_current(0)
+VideoDriverWrapper::VideoDriverWrapper()
+    : videodriver(nullptr, nullptr), renderer_(nullptr), spriteBatch_(std::make_unique<SpriteBatch>()), enableMouseWarping(true),
+      texture_current(0)
 {}
 
 VideoDriverWrapper::~VideoDriverWrapper()
@@ -213,6 +216,7 @@ unsigned VideoDriverWrapper::GetFPS() const
  */
 void VideoDriverWrapper::CleanUp()
 {
+    spriteBatch_->ReleaseBuffer();
     if(!texture_list.empty())
     {
         glDeleteTextures(texture_list.size(), static_cast<const GLuint*>(texture_list.data()));
@@ -272,6 +276,7 @@ void VideoDriverWrapper::SwapBuffers()
         s25util::fatal_error("No video driver selected!\n");
         return;
     }
+    spriteBatch_->NextFrame();
     frameLimiter_->sleepTillNextFrame(FrameCounter::clock::now());
     videodriver->SwapBuffers();
     FrameCounter::clock::time_point now = FrameCounter::clock::now();
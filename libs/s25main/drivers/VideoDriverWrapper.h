@@ -29,6 +29,7 @@ class IVideoDriver;
 class IRenderer;
 class FrameCounter;
 class FrameLimiter;
+class SpriteBatch;
 
 ///////////////////////////////////////////////////////////////////////////////
 // DriverWrapper
@@ -63,6 +64,8 @@ public:
     void DeleteTexture(unsigned t);
 
     IRenderer* GetRenderer() { return renderer_.get(); }
+    /// Batch for drawing textured quads. Must be flushed before drawing anything else
+    SpriteBatch& GetSpriteBatch() { return *spriteBatch_; }
 
     /// Swapped den Buffer
     void SwapBuffers();
@@ -122,6 +125,7 @@ private:
     drivers::DriverWrapper driver_wrapper;
     Handle videodriver;
     std::unique_ptr<IRenderer> renderer_;
+    std::unique_ptr<SpriteBatch> spriteBatch_;
     std::unique_ptr<FrameCounter> frameCtr_;
     std::unique_ptr<FrameLimiter> frameLimiter_;
     bool enableMouseWarping;
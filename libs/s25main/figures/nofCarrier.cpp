@@ -30,6 +30,7 @@
 #include "ogl/glArchivItem_Bitmap_Player.h"
 #include "ogl/glSmartBitmap.h"
 #include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "random/Random.h"
 #include "world/GameWorldGame.h"
 #include "nodeObjs/noFlag.h"
@@ -564,6 +565,8 @@ void nofCarrier::GoalReached()
             rs_dir = rn != cur_rs->GetF1();
 
             state = CARRS_GOTOMIDDLEOFROAD;
+            // Road is not waiting for its carrier anymore
+            gwg->GetRoadPathFinder().InvalidateWarePaths(player);
 
             // Wenn hier schon Waren liegen, diese gleich transportieren
             if(workplace->AreWareJobs(rs_dir, ct, true))
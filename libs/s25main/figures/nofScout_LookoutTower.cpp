@@ -48,12 +48,16 @@ void nofScout_LookoutTower::HandleDerivedEvent(const unsigned /*id*/) {}
 
 void nofScout_LookoutTower::WorkAborted()
 {
+    gwg->RemoveViewer(workplace->GetPos(), VISUALRANGE_LOOKOUTTOWER, player);
+    gwg->GetMilitarySquares().RemoveLookoutTower(workplace);
     // Im enstprechenden Radius alles neu berechnen
     gwg->RecalcVisibilitiesAroundPoint(pos, VISUALRANGE_LOOKOUTTOWER, player, workplace);
 }
 
 void nofScout_LookoutTower::WorkplaceReached()
 {
+    gwg->AddViewer(workplace->GetPos(), VISUALRANGE_LOOKOUTTOWER, player);
+    gwg->GetMilitarySquares().AddLookoutTower(workplace);
     // Im enstprechenden Radius alles sichtbar machen
     gwg->MakeVisibleAroundPoint(pos, VISUALRANGE_LOOKOUTTOWER, player);
 
@@ -31,6 +31,8 @@
 #include "gameData/const_gui_ids.h"
 #include "s25util/colors.h"
 #include <array>
+#include <chrono>
+#include <iomanip>
 #include <sstream>
 
 namespace {
@@ -121,8 +123,8 @@ iwAIDebug::iwAIDebug(GameWorldView& gwv, const std::vector<const AIPlayer*>& ais
 
     text = AddText(ID_Text, DrawPoint(15, 120), "", COLOR_YELLOW, FontStyle::LEFT | FontStyle::TOP | FontStyle::NO_OUTLINE, NormalFont);
 
-    // Show 7 lines of text and 1 empty line
-    SetIwSize(Extent(GetIwSize().x, text->GetPos().y + 8 * text->GetFont()->getHeight()));
+    // Show 8 lines of text and 1 empty line
+    SetIwSize(Extent(GetIwSize().x, text->GetPos().y + 9 * text->GetFont()->getHeight()));
 
     players->SetSelection(0);
     overlays->SetSelection(0);
@@ -153,10 +155,16 @@ void iwAIDebug::Msg_PaintBefore()
     IngameWindow::Msg_PaintBefore();
     std::stringstream ss;
 
+    const AIPlayer::RunTimes& runTimes = printer->ai->GetRunTimes();
+    const auto toMs = [](std::chrono::microseconds time) { return time.count() / 1000.; };
+    ss << std::fixed << std::setprecision(2) << "Time: " << toMs(runTimes.last) << "ms (avg "
+       << (runTimes.numRuns ? toMs(runTimes.total) / runTimes.numRuns : 0.) << "ms, max " << toMs(runTimes.max) << "ms)" << std::endl;
+
     const AIJH::Job* currentJob = printer->ai->GetCurrentJob();
     if(!currentJob)
     {
-        text->SetText(_("No current job"));
+        ss << _("No current job");
+        text->SetText(ss.str());
         return;
     }
 
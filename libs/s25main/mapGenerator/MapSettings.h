@@ -32,7 +32,7 @@ struct MapSettings
 {
     MapSettings()
         : numPlayers(2), size(MapExtent::all(256)), ratioGold(9), ratioIron(36), ratioCoal(40), ratioGranite(15), minPlayerRadius(0.31),
-          maxPlayerRadius(0.51), type(0), style(MapStyle::Random)
+          maxPlayerRadius(0.51), type(0), style(MapStyle::Random), numThreads(0)
     {}
 
     void Validate();
@@ -88,6 +88,12 @@ struct MapSettings
      * Style of the map.
      */
     MapStyle style;
+
+    /**
+     * Number of threads used for the tiled generation. 0 uses the sequential generation.
+     * The tiled generation gives the same map for every number of threads but a different one than the sequential one.
+     */
+    unsigned numThreads;
 };
 
 #endif // MapSettings_h__
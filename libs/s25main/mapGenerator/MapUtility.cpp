@@ -28,22 +28,25 @@
 #include <algorithm>
 #include <cmath>
 #include <queue>
-#include <set>
 #include <vector>
 
 void MapUtility::SetHill(Map& map, const Position& center, int z)
 {
-    std::vector<int> neighbors = VertexUtility::GetNeighbors(center, map.size, z);
-    for(int& it : neighbors)
-    {
-        const Position neighbor = VertexUtility::GetPosition(it, map.size);
-        const double d = VertexUtility::Distance(center, neighbor, map.size);
-        map.z[it] = std::max((unsigned char)(z - d), (unsigned char)map.z[it]);
-    }
+    VertexUtility::VisitNeighbors(center, map.size, z, [&map, z](int index, double d) {
+        map.z[index] = std::max((unsigned char)(z - d), (unsigned char)map.z[index]);
+    });
 }
 
 unsigned MapUtility::GetBodySize(Map& map, const Position& p, unsigned max)
 {
+    std::vector<bool> visited(map.z.size(), false);
+    return GetBodySize(map, p, max, visited);
+}
+
+unsigned MapUtility::GetBodySize(const Map& map, const Position& p, unsigned max, std::vector<bool>& visited)
+{
+    RTTR_Assert(visited.size() == map.z.size());
+
     // compute index of the initial position
     int index = VertexUtility::GetIndexOf(p, map.size);
 
@@ -51,7 +54,7 @@ unsigned MapUtility::GetBodySize(Map& map, const Position& p, unsigned max)
     uint8_t type = map.textureRsu[index];
 
     std::queue<Position> searchSpace;
-    std::set<int> body;
+    std::vector<int> body;
 
     // put initial position to the search space
     searchSpace.push(p);
@@ -69,10 +72,11 @@ unsigned MapUtility::GetBodySize(Map& map, const Position& p, unsigned max)
 
         // check if the element has the right terrain and is not yet
         // part of the terrain body
-        if((map.textureRsu[index] == type || map.textureLsd[index] == type) && body.find(index) == body.end())
+        if((map.textureRsu[index] == type || map.textureLsd[index] == type) && !visited[index])
         {
             // add the current element to the body
-            body.insert(index);
+            visited[index] = true;
+            body.push_back(index);
 
             // push neighbor elements to the search space
             searchSpace.push(Position(pos.x + 1, pos.y));
@@ -82,6 +86,10 @@ unsigned MapUtility::GetBodySize(Map& map, const Position& p, unsigned max)
         }
     }
 
+    // Reset only the flags set here
+    for(int curIdx : body)
+        visited[curIdx] = false;
+
     return body.size();
 }
 
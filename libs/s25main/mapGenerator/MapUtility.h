@@ -20,6 +20,7 @@
 
 #include "ObjectGenerator.h"
 #include "Point.h"
+#include <vector>
 
 struct Map;
 
@@ -93,6 +94,12 @@ public:
      */
     static unsigned GetBodySize(Map& map, const Position& p, unsigned max);
 
+    /**
+     * Same as GetBodySize but uses the given flags (one per vertex, all false) to mark visited vertices.
+     * They are reset before returning, so the same buffer can be used for multiple calls.
+     */
+    static unsigned GetBodySize(const Map& map, const Position& p, unsigned max, std::vector<bool>& visited);
+
     /**
      * Computes a point on a circle. The circle has equally distributed points.
      * The specified index references one of those points.
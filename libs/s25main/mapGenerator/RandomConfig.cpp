@@ -282,10 +282,29 @@ int RandomConfig::Rand(const int max)
 }
 
 int RandomConfig::Rand(const int min, const int max)
+{
+    return Rand(rng_, min, max);
+}
+
+int RandomConfig::Rand(UsedRNG& rng, const int min, const int max)
 {
     RTTR_Assert(max > min);
     std::uniform_int_distribution<> distr(min, max - 1);
-    return distr(rng_);
+    return distr(rng);
+}
+
+uint64_t RandomConfig::CreateSeed()
+{
+    return rng_();
+}
+
+RandomConfig::UsedRNG RandomConfig::CreateRNG(uint64_t seed, unsigned part)
+{
+    // SplitMix64 step so consecutive parts get unrelated states
+    uint64_t state = seed + (part + 1u) * UINT64_C(0x9E3779B97F4A7C15);
+    state = (state ^ (state >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    state = (state ^ (state >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return UsedRNG(state ^ (state >> 31));
 }
 
 double RandomConfig::DRand(const double min, const double max)
@@ -33,6 +33,8 @@ struct LandscapeDesc;
 class RandomConfig
 {
 public:
+    using UsedRNG = XorShift;
+
     bool Init(MapStyle mapStyle, DescIdx<LandscapeDesc> landscape);
     bool Init(MapStyle mapStyle, DescIdx<LandscapeDesc> landscape, uint64_t seed);
 
@@ -75,6 +77,23 @@ public:
      */
     double DRand(double min, double max);
 
+    /**
+     * Generates a random number between min and max-1 with the given RNG.
+     */
+    static int Rand(UsedRNG& rng, int min, int max);
+
+    /**
+     * Draws a seed for independent RNGs created by CreateRNG.
+     */
+    uint64_t CreateSeed();
+
+    /**
+     * Creates a RNG for an independent part of the map (e.g. a tile). The sequence only depends on the seed and the part.
+     * @param seed seed drawn by CreateSeed
+     * @param part index of the part
+     */
+    static UsedRNG CreateRNG(uint64_t seed, unsigned part);
+
     const TerrainDesc& GetTerrainByS2Id(uint8_t s2Id) const;
 
     template<class T_Predicate>
@@ -96,7 +115,6 @@ private:
     void CreateContinent();
     void CreateRandom();
 
-    using UsedRNG = XorShift;
     UsedRNG rng_;
 };
 
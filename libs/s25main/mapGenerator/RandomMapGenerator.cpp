@@ -17,6 +17,7 @@
 
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "mapGenerator/RandomMapGenerator.h"
+#include "helpers/runParallel.h"
 #include "mapGenerator/MapSettings.h"
 #include "mapGenerator/ObjectGenerator.h"
 #include "mapGenerator/RandomConfig.h"
@@ -30,6 +31,11 @@
 #define MIN_HARBOR_DISTANCE 35.0
 #define MIN_HARBOR_WATER 200
 
+namespace {
+/// Size of the tiles for the tiled generation
+constexpr int TILE_SIZE = 32;
+} // namespace
+
 RandomMapGenerator::RandomMapGenerator(RandomConfig& config) : config(config), helper(config) {}
 
 unsigned RandomMapGenerator::GetMaxTerrainHeight(const DescIdx<TerrainDesc> terrain)
@@ -84,26 +90,41 @@ void RandomMapGenerator::PlacePlayerResources(const MapSettings& settings, Map&
     }
 }
 
+void RandomMapGenerator::CalcDistanceToPlayers(const MapSettings& settings, const Map& map)
+{
+    distanceToPlayer.resize(map.z.size());
+    helpers::runParallel(settings.numThreads, map.size.y, [this, &settings, &map](unsigned y) {
+        for(int x = 0; x < map.size.x; x++)
+        {
+            const Position pt(x, y);
+            auto distance = (double)(map.size.x + map.size.y);
+            for(unsigned i = 0; i < settings.numPlayers; i++)
+                distance = std::min(distance, VertexUtility::Distance(pt, Position(map.hqPositions[i]), map.size));
+            distanceToPlayer[VertexUtility::GetIndexOf(pt, map.size)] = distance;
+        }
+    });
+}
+
 void RandomMapGenerator::CreateHills(const MapSettings& settings, Map& map)
 {
-    const int players = settings.numPlayers;
+    if(settings.numThreads > 0)
+    {
+        CreateHillsTiled(settings, map);
+        return;
+    }
+
     std::vector<AreaDesc> areas = config.areas;
 
     for(int x = 0; x < map.size.x; x++)
     {
         for(int y = 0; y < map.size.y; y++)
         {
-            auto distanceToPlayer = (double)(map.size.x + map.size.y);
             Position tile(x, y);
-
-            for(int i = 0; i < players; i++)
-            {
-                distanceToPlayer = std::min(distanceToPlayer, VertexUtility::Distance(tile, Position(map.hqPositions[i]), map.size));
-            }
+            const double distance = distanceToPlayer[VertexUtility::GetIndexOf(tile, map.size)];
 
             for(auto& area : areas)
             {
-                if(area.IsInArea(tile, distanceToPlayer, map.size))
+                if(area.IsInArea(tile, distance, map.size))
                 {
                     const auto pr = (int)area.likelyhoodHill;
                     const int maxZ = area.maxElevation;
@@ -119,9 +140,76 @@ void RandomMapGenerator::CreateHills(const MapSettings& settings, Map& map)
     }
 }
 
-void RandomMapGenerator::FillRemainingTerrain(const MapSettings& settings, Map& map)
+void RandomMapGenerator::CreateHillsTiled(const MapSettings& settings, Map& map)
+{
+    struct Hill
+    {
+        Position center;
+        int z;
+    };
+
+    std::vector<AreaDesc> areas = config.areas;
+    const Position numTiles((map.size.x + TILE_SIZE - 1) / TILE_SIZE, (map.size.y + TILE_SIZE - 1) / TILE_SIZE);
+    const uint64_t seed = config.CreateSeed();
+
+    // Choose the hills of each tile with its own RNG
+    std::vector<std::vector<Hill>> tileHills(numTiles.x * numTiles.y);
+    helpers::runParallel(settings.numThreads, tileHills.size(), [&](unsigned tileIdx) {
+        RandomConfig::UsedRNG rng = RandomConfig::CreateRNG(seed, tileIdx);
+        const Position tileStart = Position(tileIdx % numTiles.x, tileIdx / numTiles.x) * TILE_SIZE;
+        const Position tileEnd = elMin(tileStart + Position::all(TILE_SIZE), Position(map.size));
+        for(int x = tileStart.x; x < tileEnd.x; x++)
+        {
+            for(int y = tileStart.y; y < tileEnd.y; y++)
+            {
+                const Position tile(x, y);
+                const double distance = distanceToPlayer[VertexUtility::GetIndexOf(tile, map.size)];
+                for(auto& area : areas)
+                {
+                    const int maxZ = area.maxElevation;
+                    if(maxZ > 0 && area.IsInArea(tile, distance, map.size)
+                       && RandomConfig::Rand(rng, 0, 101) <= static_cast<int>(area.likelyhoodHill))
+                    {
+                        const Hill hill = {tile, RandomConfig::Rand(rng, area.minElevation, maxZ + 1)};
+                        tileHills[tileIdx].push_back(hill);
+                    }
+                }
+            }
+        }
+    });
+
+    // Sort the hills into bands of rows they reach into
+    std::vector<std::vector<const Hill*>> bandHills(numTiles.y);
+    for(const std::vector<Hill>& hills : tileHills)
+    {
+        for(const Hill& hill : hills)
+        {
+            for(int y = hill.center.y - hill.z; y <= hill.center.y + hill.z; y++)
+            {
+                const int row = VertexUtility::GetIndexOf(Position(0, y), map.size) / map.size.x;
+                std::vector<const Hill*>& curBandHills = bandHills[row / TILE_SIZE];
+                if(curBandHills.empty() || curBandHills.back() != &hill)
+                    curBandHills.push_back(&hill);
+            }
+        }
+    }
+
+    // Each band only changes its own rows. The result does not depend on the order as the highest elevation is used
+    helpers::runParallel(settings.numThreads, bandHills.size(), [&map, &bandHills](unsigned band) {
+        const int firstIdx = band * TILE_SIZE * map.size.x;
+        const int endIdx = std::min<int>(firstIdx + TILE_SIZE * map.size.x, map.z.size());
+        for(const Hill* hill : bandHills[band])
+        {
+            VertexUtility::VisitNeighbors(hill->center, map.size, hill->z, [&map, hill, firstIdx, endIdx](int index, double d) {
+                if(index >= firstIdx && index < endIdx)
+                    map.z[index] = std::max((unsigned char)(hill->z - d), (unsigned char)map.z[index]);
+            });
+        }
+    });
+}
+
+void RandomMapGenerator::FillRemainingTerrain(const MapSettings&, Map& map)
 {
-    const int players = settings.numPlayers;
     std::vector<AreaDesc> areas = config.areas;
     std::vector<DescIdx<TerrainDesc>> textures = config.textures;
 
@@ -133,14 +221,9 @@ void RandomMapGenerator::FillRemainingTerrain(const MapSettings& settings, Map&
         // create texture for current height value
         helper.objGen.CreateTexture(map, index, textures[level]);
 
-        auto distanceToPlayer = (double)(map.size.x + map.size.y);
-
-        for(int i = 0; i < players; i++)
-            distanceToPlayer = std::min(distanceToPlayer, VertexUtility::Distance(pt, Position(map.hqPositions[i]), map.size));
-
         for(auto& area : areas)
         {
-            if(area.IsInArea(pt, distanceToPlayer, map.size))
+            if(area.IsInArea(pt, distanceToPlayer[index], map.size))
             {
                 if(static_cast<unsigned>(config.Rand(0, 100)) < area.likelyhoodTree)
                     helper.SetTree(map, pt);
@@ -161,16 +244,11 @@ void RandomMapGenerator::FillRemainingTerrain(const MapSettings& settings, Map&
             map.animal[index] = static_cast<uint8_t>(helper.objGen.CreateDuck(3));
         } else if(t.humidity > 0 && t.IsUsableByAnimals())
         {
-            std::vector<int> positions = VertexUtility::GetNeighbors(pt, map.size, 1);
             bool treeFound = false;
-            for(int curIdx : positions)
-            {
+            VertexUtility::VisitNeighbors(pt, map.size, 1, [&map, &treeFound](int curIdx, double) {
                 if(ObjectGenerator::IsTree(map, curIdx))
-                {
                     treeFound = true;
-                    break;
-                }
-            }
+            });
             map.animal[index] = static_cast<uint8_t>(treeFound ? helper.objGen.CreateRandomForestAnimal(4) : helper.objGen.CreateSheep(4));
         }
     }
@@ -179,6 +257,7 @@ void RandomMapGenerator::FillRemainingTerrain(const MapSettings& settings, Map&
     /// Harbour placement
     ///////
     std::vector<Position> harbors;
+    std::vector<bool> visited(map.z.size(), false);
     int maxWaterIndex = -1;
     for(unsigned i = 0; i < textures.size(); i++)
     {
@@ -224,7 +303,7 @@ void RandomMapGenerator::FillRemainingTerrain(const MapSettings& settings, Map&
                 continue;
 
             // setup harbor position
-            if(MapUtility::GetBodySize(map, water, MIN_HARBOR_WATER) >= MIN_HARBOR_WATER)
+            if(MapUtility::GetBodySize(map, water, MIN_HARBOR_WATER, visited) >= MIN_HARBOR_WATER)
             {
                 helper.SetHarbour(map, pt, maxWaterIndex);
                 harbors.push_back(pt);
@@ -286,12 +365,26 @@ Map RandomMapGenerator::Create(MapSettings settings)
     map.numPlayers = settings.numPlayers;
 
     // the actual map generation
+    phaseTimings.clear();
+    Timer timer(true);
+    const auto finishPhase = [this, &timer](const char* name) {
+        phaseTimings.emplace_back(name, timer.getElapsed());
+        timer.restart();
+    };
     PlacePlayers(settings, map);
+    finishPhase("PlacePlayers");
     PlacePlayerResources(settings, map);
+    finishPhase("PlacePlayerResources");
+    CalcDistanceToPlayers(settings, map);
+    finishPhase("CalcDistanceToPlayers");
     CreateHills(settings, map);
+    finishPhase("CreateHills");
     FillRemainingTerrain(settings, map);
+    finishPhase("FillRemainingTerrain");
     helper.Smooth(map);
+    finishPhase("Smooth");
     SetResources(settings, map);
+    finishPhase("SetResources");
 
     return map;
 }
@@ -18,7 +18,11 @@
 #ifndef RandomMapGenerator_h__
 #define RandomMapGenerator_h__
 
+#include "Timer.h"
 #include "mapGenerator/MapUtility.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 class RandomConfig;
 struct TerrainDesc;
@@ -45,12 +49,23 @@ public:
      */
     Map Create(MapSettings settings);
 
+    /// Duration of each phase of the last Create call in the order they were run
+    using PhaseTimings = std::vector<std::pair<std::string, Timer::duration>>;
+    const PhaseTimings& GetPhaseTimings() const { return phaseTimings; }
+
 private:
     /**
      * Helper to generate random maps (tree placement, water, coastlines, ...).
      */
     MapUtility helper;
 
+    PhaseTimings phaseTimings;
+
+    /**
+     * Distance of each vertex to the closest headquarter.
+     */
+    std::vector<double> distanceToPlayer;
+
     /**
      * Gets the highest possible elevation (height value) for the specified terrain.
      * @param terrain terrain type to evaluate the maximum height for
@@ -81,6 +96,13 @@ private:
      */
     void PlacePlayerResources(const MapSettings& settings, Map& map);
 
+    /**
+     * Computes the distance of each vertex to the closest headquarter.
+     * @param settings settings used for map generation
+     * @param map map with placed players
+     */
+    void CalcDistanceToPlayers(const MapSettings& settings, const Map& map);
+
     /**
      * Create a elevation (hills) for the specified map.
      * @param settings settings used for map generation
@@ -89,6 +111,14 @@ private:
      */
     void CreateHills(const MapSettings& settings, Map& map);
 
+    /**
+     * Same as CreateHills but splits the map into tiles which get their own random number generator. Tiles are created
+     * in parallel and the result only depends on the seed of the configuration, not on the number of threads.
+     * @param settings settings used for map generation
+     * @param map map to modify
+     */
+    void CreateHillsTiled(const MapSettings& settings, Map& map);
+
     /**
      * Fill the remaining terrain (apart from the player positions) according to the generated hills.
      * @param settings settings used for map generation
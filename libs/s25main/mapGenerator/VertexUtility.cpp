@@ -39,19 +39,7 @@ int VertexUtility::GetIndexOf(Position p, const MapExtent& size)
 std::vector<int> VertexUtility::GetNeighbors(const Position& p, const MapExtent& size, int radius)
 {
     std::vector<int> neighbors;
-
-    for(int nx = p.x - radius; nx <= p.x + radius; nx++)
-    {
-        for(int ny = p.y - radius; ny <= p.y + radius; ny++)
-        {
-            const Position neighbor(nx, ny);
-            if(VertexUtility::Distance(p, neighbor, size) <= radius)
-            {
-                neighbors.push_back(VertexUtility::GetIndexOf(neighbor, size));
-            }
-        }
-    }
-
+    VisitNeighbors(p, size, radius, [&neighbors](int index, double) { neighbors.push_back(index); });
     return neighbors;
 }
 
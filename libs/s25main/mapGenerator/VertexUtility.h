@@ -50,6 +50,16 @@ public:
      */
     static std::vector<int> GetNeighbors(const Position& p, const MapExtent& size, int radius);
 
+    /**
+     * Calls the functor with the index and the distance of all vertices returned by GetNeighbors without allocating them.
+     * @param p center position to visit neighboring vertices around
+     * @param size of the map
+     * @param radius radius for visiting neighbor vertices
+     * @param functor called as functor(index, distance)
+     */
+    template<class T_Functor>
+    static void VisitNeighbors(const Position& p, const MapExtent& size, int radius, T_Functor&& functor);
+
     /**
      * Computes the distance between two vertices.
      * @param p1 position of the first vertex
@@ -60,4 +70,19 @@ public:
     static double Distance(const Position& p1, const Position& p2, const MapExtent& size);
 };
 
+template<class T_Functor>
+inline void VertexUtility::VisitNeighbors(const Position& p, const MapExtent& size, int radius, T_Functor&& functor)
+{
+    for(int nx = p.x - radius; nx <= p.x + radius; nx++)
+    {
+        for(int ny = p.y - radius; ny <= p.y + radius; ny++)
+        {
+            const Position neighbor(nx, ny);
+            const double distance = Distance(p, neighbor, size);
+            if(distance <= radius)
+                functor(GetIndexOf(neighbor, size), distance);
+        }
+    }
+}
+
 #endif // VertexUtility_h__
@@ -55,6 +55,8 @@ public:
     virtual void CI_GameLoading(const std::shared_ptr<Game>&) {}
     /// Game is started and running
     virtual void CI_GameStarted(const std::shared_ptr<Game>&) {}
+    /// Running game was replaced by one restored from a saved state (e.g. replay keyframe)
+    virtual void CI_GameRestored(const std::shared_ptr<Game>&) {}
 
     virtual void CI_PlayerDataChanged(unsigned /*playerId*/) {}
     virtual void CI_PingChanged(unsigned /*playerId*/, unsigned short /*ping*/) {}
@@ -69,6 +71,8 @@ public:
     virtual void CI_Async(const std::string& /*checksums_list*/) {}
     virtual void CI_ReplayAsync(const std::string& /*msg*/) {}
     virtual void CI_ReplayEndReached(const std::string& /*msg*/) {}
+    /// Writing an autosave failed or had to be skipped
+    virtual void CI_AutosaveFailed(const std::string& /*filePath*/, const std::string& /*error*/) {}
     virtual void CI_GamePaused() {}
     virtual void CI_GameResumed() {}
 };
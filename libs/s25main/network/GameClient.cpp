@@ -17,6 +17,7 @@
 
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "GameClient.h"
+#include "AsyncSavegameWriter.h"
 #include "CreateServerInfo.h"
 #include "EventManager.h"
 #include "Game.h"
@@ -36,6 +37,7 @@
 #include "Settings.h"
 #include "addons/const_addons.h"
 #include "ai/AIPlayer.h"
+#include "ai/AIRunner.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "factories/AIFactory.h"
 #include "files.h"
@@ -64,6 +66,7 @@
 #include "s25util/utf8.h"
 #include <boost/filesystem.hpp>
 #include <helpers/chronoIO.h>
+#include <chrono>
 #include <memory>
 
 void GameClient::ClientConfig::Clear()
@@ -179,7 +182,12 @@ void GameClient::Run()
         if(nwfInfo->isReady())
             OnGameStart();
     } else if(state == CS_GAME)
+    {
+        // Done here as the current desktop gets replaced
+        if(replayinfo && replayinfo->seekGF)
+            SeekReplay();
         ExecuteGameFrame();
+    }
 
     // maximal 10 Pakete verschicken
     mainPlayer.sendMsgs(10);
@@ -301,29 +309,11 @@ void GameClient::StartGame(const unsigned random_init)
     else
     {
         RTTR_Assert(mapinfo.type != MAPTYPE_SAVEGAME);
-        /// Startbündnisse setzen
-        for(unsigned i = 0; i < gameWorld.GetNumPlayers(); ++i)
-            gameWorld.GetPlayer(i).MakeStartPacts();
-
-        if(!gameWorld.LoadMap(game, mapinfo.filepath, mapinfo.luaFilepath))
+        if(!gameWorld.SetupNewGame(game, mapinfo.filepath, mapinfo.luaFilepath))
         {
             OnError(CE_INVALID_MAP);
             return;
         }
-
-        /// Evtl. Goldvorkommen ändern
-        Resource::Type target; // löschen
-        switch(game->ggs_.getSelection(AddonId::CHANGE_GOLD_DEPOSITS))
-        {
-            case 0:
-            default: target = Resource::Gold; break;
-            case 1: target = Resource::Nothing; break;
-            case 2: target = Resource::Iron; break;
-            case 3: target = Resource::Coal; break;
-            case 4: target = Resource::Granite; break;
-        }
-        gameWorld.ConvertMineResourceTypes(Resource::Gold, target);
-        gameWorld.PlaceAndFixWater();
     }
     gameWorld.InitAfterLoad();
 
@@ -369,6 +359,21 @@ void GameClient::GameLoaded()
 void GameClient::ExitGame()
 {
     RTTR_Assert(state == CS_GAME || state == CS_LOADED || state == CS_LOADING);
+    if(autosaveWriter)
+    {
+        // Don't lose autosaves still being written
+        autosaveWriter->WaitForCompletion();
+        HandleAutosaveResults();
+        autosaveWriter.reset();
+    }
+    if(keyframeWriter)
+    {
+        // Keyframes must be complete before the replay gets closed
+        keyframeWriter->WaitForCompletion();
+        HandleReplayKeyframeResults();
+        keyframeWriter.reset();
+    }
+    aiRunner.reset();
     game.reset();
     nwfInfo.reset();
     // Clear remaining commands
@@ -1201,6 +1206,9 @@ bool GameClient::OnGameMessage(const GameMessage_GetAsyncLog& /*msg*/)
 /// testet ob ein Netwerkframe abgelaufen ist und führt dann ggf die Befehle aus
 void GameClient::ExecuteGameFrame()
 {
+    HandleAutosaveResults();
+    HandleReplayKeyframeResults();
+
     if(framesinfo.isPaused)
         return; // Pause
 
@@ -1262,7 +1270,10 @@ void GameClient::ExecuteGameFrame()
 
                 // GF-Ende im Replay aktualisieren
                 if(replayinfo && replayinfo->replay.IsRecording())
+                {
                     replayinfo->replay.UpdateLastGF(curGF);
+                    HandleReplayKeyframe();
+                }
             }
 
             // Store this timestamp
@@ -1310,15 +1321,105 @@ void GameClient::HandleAutosave()
             tmp += ").sav";
         }
 
-        SaveToFile(tmp);
+        if(!autosaveWriter)
+            autosaveWriter = std::make_unique<AsyncSavegameWriter>();
+        if(autosaveWriter->IsFull())
+        {
+            // Disk is slower than the autosave interval. Skip this one instead of stalling the game
+            LOG.write("Autosave skipped at GF %1%: Previous autosaves are still being written\n") % GetGFNumber();
+            if(ci)
+                ci->CI_AutosaveFailed(tmp, _("Previous auto-save is still being written"));
+            return;
+        }
+
+        mainPlayer.sendMsg(GameMessage_Chat(0xFF, CD_SYSTEM, "Saving game..."));
+
+        const auto startTime = std::chrono::steady_clock::now();
+        auto save = std::make_unique<Savegame>();
+        if(!MakeSavegame(*save))
+            return;
+        const auto snapshotTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        LOG.write("Autosave: Snapshot at GF %1% took %2%ms\n") % GetGFNumber() % snapshotTime.count();
+
+        // Cannot fail as we checked for a full queue above and are the only producer
+        autosaveWriter->Push(std::move(save), tmp, mapinfo.title);
+    }
+}
+
+void GameClient::HandleReplayKeyframe()
+{
+    const unsigned interval = SETTINGS.interface.replay_keyframe_interval;
+    // We are at the start of the next GF, its commands were not yet executed
+    const unsigned gf = GetGFNumber();
+    if(!interval || gf % interval != 0)
+        return;
+
+    if(!keyframeWriter)
+        keyframeWriter = std::make_unique<AsyncSavegameWriter>();
+    if(keyframeWriter->IsFull())
+    {
+        LOG.write("Replay keyframe skipped at GF %1%: Previous keyframes are still being written\n") % gf;
+        return;
+    }
+
+    // Only take the snapshot and mark the position in the commands here.
+    // Compressing and writing the data is done in the background
+    auto save = std::make_unique<Savegame>();
+    if(!MakeSavegame(*save))
+        return;
+    Replay& replay = replayinfo->replay;
+    replay.AddKeyframe(gf);
+    const UsedPRNG rngState = RANDOM.GetCurrentState();
+    // Cannot fail as we checked for a full queue above and are the only producer
+    keyframeWriter->Push(std::move(save), replayinfo->fileName, [&replay, gf, rngState](Savegame& keyframe) {
+        keyframe.CompressGameData();
+        replay.AddKeyframeData(gf, keyframe, rngState);
+        return true;
+    });
+}
+
+void GameClient::HandleReplayKeyframeResults()
+{
+    if(!keyframeWriter)
+        return;
+    for(const AsyncSavegameWriter::Result& result : keyframeWriter->PopResults())
+    {
+        if(!result.success)
+            LOG.write("Writing replay keyframe to \"%1%\" failed: %2%\n") % result.filePath % result.errorMsg;
+    }
+}
+
+void GameClient::HandleAutosaveResults()
+{
+    if(!autosaveWriter)
+        return;
+    for(const AsyncSavegameWriter::Result& result : autosaveWriter->PopResults())
+    {
+        if(result.success)
+        {
+            LOG.write("Autosave: Writing \"%1%\" took %2%ms\n") % result.filePath % result.writeTime.count();
+        } else
+        {
+            LOG.write("Autosave: Writing \"%1%\" failed after %2%ms: %3%\n") % result.filePath % result.writeTime.count()
+              % result.errorMsg;
+            if(ci)
+                ci->CI_AutosaveFailed(result.filePath, result.errorMsg);
+        }
     }
 }
 
 /// Führt notwendige Dinge für nächsten GF aus
 void GameClient::NextGF(bool wasNWF)
 {
+    if(!aiRunner)
+        aiRunner = std::make_unique<AIRunner>();
+    aiRunner->RunGF(game->aiPlayers_, GetGFNumber(), wasNWF);
+    // Send the chat messages in player order after all AIs are done
     for(AIPlayer& ai : game->aiPlayers_)
-        ai.RunGF(GetGFNumber(), wasNWF);
+    {
+        for(const std::string& msg : ai.FetchChatMessages())
+            mainPlayer.sendMsgAsync(new GameMessage_Chat(ai.GetPlayerId(), CD_ALL, msg));
+    }
     game->RunGF();
 }
 
@@ -1535,6 +1636,17 @@ void GameClient::ServerLost()
  */
 void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
 {
+    if(replayMode)
+    {
+        // Restoring a keyframe is faster than simulating all GFs and also allows going back
+        const Replay::Keyframe* keyframe = replayinfo->replay.FindKeyframe(gf);
+        if(keyframe && (gf < GetGFNumber() || keyframe->gf > GetGFNumber()))
+        {
+            replayinfo->seekGF = gf;
+            return;
+        }
+    }
+
     if(gf <= GetGFNumber())
         return;
 
@@ -1580,6 +1692,66 @@ void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
     SetPause(true);
 }
 
+void GameClient::SeekReplay()
+{
+    const unsigned targetGF = replayinfo->seekGF;
+    replayinfo->seekGF = 0;
+    const Replay::Keyframe* keyframe = replayinfo->replay.FindKeyframe(targetGF);
+    if(!keyframe)
+        return;
+
+    unsigned start_ticks = VIDEODRIVER.GetTickCount();
+
+    Savegame save;
+    UsedPRNG rngState;
+    if(!replayinfo->replay.ReadKeyframe(*keyframe, save, rngState))
+    {
+        LOG.write(_("Could not read replay keyframe at GF %1%: %2%\n")) % keyframe->gf % replayinfo->replay.GetLastErrorMsg();
+        return;
+    }
+
+    const GlobalGameSettings ggs = game->ggs_;
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < replayinfo->replay.GetNumPlayers(); ++i)
+        players.push_back(PlayerInfo(replayinfo->replay.GetPlayer(i)));
+    // The object counters are global, so the objects of the old game must be gone before the new one is loaded.
+    // The game itself stays alive until the desktop referencing it is replaced
+    game->world_.Unload();
+    game = std::make_shared<Game>(ggs, save.start_gf, players);
+    try
+    {
+        save.sgd.ReadSnapshot(game);
+    } catch(SerializedGameData::Error& error)
+    {
+        LOG.write(_("Error when loading game from replay: %s\n")) % error.what();
+        OnError(CE_INVALID_MAP);
+        return;
+    }
+    game->world_.InitAfterLoad();
+    game->SetStarted();
+    RANDOM.ResetState(rngState);
+    ResetVisualSettings();
+
+    replayinfo->end = false;
+    replayinfo->replay.ReadGF(&replayinfo->next_gf);
+
+    if(ci)
+        ci->CI_GameRestored(game);
+
+    // Simulate the GFs after the keyframe
+    SetPause(false);
+    skiptogf = targetGF;
+    for(unsigned i = GetGFNumber(); i < skiptogf; ++i)
+        ExecuteGameFrame();
+    skiptogf = 0;
+
+    unsigned ticks = VIDEODRIVER.GetTickCount() - start_ticks;
+    boost::format text(_("Jump finished (%1$.3g seconds)."));
+    text % (ticks / 1000.0);
+    SystemChat(text.str());
+    SetPause(true);
+}
+
 void GameClient::SystemChat(const std::string& text, unsigned char player)
 {
     if(!ci)
@@ -1600,13 +1772,29 @@ bool GameClient::SaveToFile(const std::string& filename)
     VIDEODRIVER.SwapBuffers();
 
     Savegame save;
+    if(!MakeSavegame(save))
+        return false;
 
+    try
+    {
+        // Und alles speichern
+        return save.Save(filename, mapinfo.title);
+    } catch(std::exception& e)
+    {
+        OnGameMessage(GameMessage_Chat(0xFF, CD_SYSTEM, std::string("Error during saving: ") + e.what()));
+        return false;
+    }
+}
+
+bool GameClient::MakeSavegame(Savegame& save)
+{
     WritePlayerInfo(save);
 
     // GGS-Daten
     save.ggs = game->ggs_;
 
     save.start_gf = GetGFNumber();
+    save.compressGameData = SETTINGS.interface.compress_savegames;
 
     // Enable/Disable debugging of savegames
     save.sgd.debugMode = SETTINGS.global.debugMode;
@@ -1615,8 +1803,7 @@ bool GameClient::SaveToFile(const std::string& filename)
     {
         // Spiel serialisieren
         save.sgd.MakeSnapshot(game);
-        // Und alles speichern
-        return save.Save(filename, mapinfo.title);
+        return true;
     } catch(std::exception& e)
     {
         OnGameMessage(GameMessage_Chat(0xFF, CD_SYSTEM, std::string("Error during saving: ") + e.what()));
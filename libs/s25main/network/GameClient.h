@@ -38,8 +38,11 @@ struct Info;
 }
 
 class AIPlayer;
+class AIRunner;
+class AsyncSavegameWriter;
 class ClientInterface;
 class SavedFile;
+class Savegame;
 class GamePlayer;
 class GameEvent;
 class GameLobby;
@@ -201,6 +204,16 @@ private:
     void NextGF(bool wasNWF);
     /// Checks if its time for autosaving (if enabled) and does it
     void HandleAutosave();
+    /// Reports autosaves finished by the background writer
+    void HandleAutosaveResults();
+    /// Adds a keyframe to the recorded replay if it is time for it
+    void HandleReplayKeyframe();
+    /// Reports replay keyframes the background writer failed to write
+    void HandleReplayKeyframeResults();
+    /// Restores the replay keyframe before the requested GF and simulates the remaining GFs
+    void SeekReplay();
+    /// Fills the savegame with the current game state. Return false and report the error on failure
+    bool MakeSavegame(Savegame& save);
 
     //  Netzwerknachrichten
     RTTR_IGNORE_OVERLOADED_VIRTUAL
@@ -300,6 +313,13 @@ private:
 
     std::unique_ptr<ReplayInfo> replayinfo;
     bool replayMode;
+
+    /// Writes autosaves to disk without blocking the game loop
+    std::unique_ptr<AsyncSavegameWriter> autosaveWriter;
+    /// Compresses and writes the replay keyframes in the background
+    std::unique_ptr<AsyncSavegameWriter> keyframeWriter;
+    /// Runs the AI players in parallel
+    std::unique_ptr<AIRunner> aiRunner;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -59,7 +59,8 @@ void GameClient::ExecuteGameFrame_Replay()
             AsyncChecksum& msgChecksum = msg.checksum;
 
             // Check for async if checksum data is valid
-            if(msgChecksum.randChecksum != 0 && msgChecksum != checksum)
+            const std::string divergentParts = msgChecksum.randChecksum != 0 ? msgChecksum.getDivergentParts(checksum) : "";
+            if(!divergentParts.empty())
             {
                 // Show message if this is the first async GF
                 if(replayinfo->async == 0)
@@ -70,8 +71,9 @@ void GameClient::ExecuteGameFrame_Replay()
                           helpers::format(_("Warning: The played replay is not in sync with the original match. (GF: %u)"), curGF));
                     }
 
-                    LOG.write("Async at GF %u: Checksum %i:%i ObjCt %u:%u ObjIdCt %u:%u\n") % curGF % msgChecksum.randChecksum
-                      % checksum.randChecksum % msgChecksum.objCt % checksum.objCt % msgChecksum.objIdCt % checksum.objIdCt;
+                    LOG.write("Async at GF %u in %s: Checksum %i:%i ObjCt %u:%u ObjIdCt %u:%u\n") % curGF % divergentParts
+                      % msgChecksum.randChecksum % checksum.randChecksum % msgChecksum.objCt % checksum.objCt % msgChecksum.objIdCt
+                      % checksum.objIdCt;
 
                     // and pause the game for further investigation
                     framesinfo.isPaused = true;
@@ -81,6 +83,10 @@ void GameClient::ExecuteGameFrame_Replay()
 
                 replayinfo->async++;
             }
+        } else if(rc == Replay::RC_KEYFRAME || rc == Replay::RC_KEYFRAMEDATA)
+        {
+            // Only used for seeking
+            replayinfo->replay.SkipKeyframe();
         }
         // Read GF of next command
         replayinfo->replay.ReadGF(&replayinfo->next_gf);
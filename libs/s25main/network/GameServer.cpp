@@ -51,7 +51,8 @@
 inline std::ostream& operator<<(std::ostream& os, const AsyncChecksum& checksum)
 {
     return os << "RandCS = " << checksum.randChecksum << ",\tobjects/ID = " << checksum.objCt << "/" << checksum.objIdCt
-              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt;
+              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt
+              << ",\tmap/players/event queue = " << checksum.mapHash << "/" << checksum.playerHash << "/" << checksum.eventQueueHash;
 }
 
 struct GameServer::AsyncLog
@@ -678,8 +679,8 @@ bool GameServer::CheckForAsync()
         // Checksummen nicht gleich?
         if(curChecksum != refChecksum)
         {
-            LOG.write(_("Async at GF %1% of player %2% vs %3%. Checksums:\n%4%\n%5%\n\n")) % currentGF % player.playerId
-              % networkPlayers.front().playerId % curChecksum % refChecksum;
+            LOG.write(_("Async at GF %1% of player %2% vs %3% in %4%. Checksums:\n%5%\n%6%\n\n")) % currentGF % player.playerId
+              % networkPlayers.front().playerId % curChecksum.getDivergentParts(refChecksum) % curChecksum % refChecksum;
             isAsync = true;
         }
     }
@@ -28,9 +28,9 @@ void PlayerGameCommands::Serialize(Serializer& ser) const
         gc->Serialize(ser);
 }
 
-void PlayerGameCommands::Deserialize(Serializer& ser)
+void PlayerGameCommands::Deserialize(Serializer& ser, bool withStateHashes)
 {
-    checksum.Deserialize(ser);
+    checksum.Deserialize(ser, withStateHashes);
 
     gcs.resize(ser.PopUnsignedInt());
     for(gc::GameCommandPtr& gc : gcs)
@@ -36,7 +36,8 @@ struct PlayerGameCommands
     PlayerGameCommands() = default;
     PlayerGameCommands(const AsyncChecksum& checksum, std::vector<gc::GameCommandPtr> gcs) : checksum(checksum), gcs(std::move(gcs)) {}
     void Serialize(Serializer& ser) const;
-    void Deserialize(Serializer& ser);
+    /// Read the commands. withStateHashes is false for data written before the checksum contained the state hashes
+    void Deserialize(Serializer& ser, bool withStateHashes = true);
 };
 
 #endif // PlayerGameCommands_h__
@@ -28,6 +28,7 @@
 #include "network/GameClient.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glSmartBitmap.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorldGame.h"
 #include "gameData/TerrainDesc.h"
 
@@ -93,6 +94,7 @@ void noFlag::Destroy_noFlag()
             ware->WareLost(player);
             ware->Destroy();
             deletePtr(ware);
+            gwg->GetRoadPathFinder().InvalidateWarePaths(player);
         }
     }
 
@@ -156,6 +158,8 @@ void noFlag::AddWare(Ware*& ware)
             continue;
 
         i = ware;
+        // Wares waiting at the flag make the roads more expensive
+        gwg->GetRoadPathFinder().InvalidateWarePaths(player);
         // Träger Bescheid sagen
         if(ware->GetNextDir() != 0xFF)
             routes[ware->GetNextDir()]->AddWareJob(this);
@@ -216,7 +220,10 @@ Ware* noFlag::SelectWare(const Direction roadDir, const bool swap_wares, const n
 
     // Ware von der Flagge entfernen
     if(best_ware)
+    {
         wares[best_ware_index] = nullptr;
+        gwg->GetRoadPathFinder().InvalidateWarePaths(player);
+    }
 
     // ggf. anderen Trägern Bescheid sagen, aber nicht dem, der die Ware aufgehoben hat!
     GetRoute(roadDir)->WareJobRemoved(carrier);
@@ -333,10 +340,12 @@ void noFlag::Capture(const unsigned char new_owner)
             ware->WareLost(player);
             ware->Destroy();
             deletePtr(ware);
+            gwg->GetRoadPathFinder().InvalidateWarePaths(player);
         }
     }
 
     this->player = new_owner;
+    gwg->GetRoadPathFinder().InvalidateWarePaths(new_owner);
 }
 
 /**
@@ -21,6 +21,7 @@
 #include "GamePlayer.h"
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorldGame.h"
 
 noRoadNode::noRoadNode(const NodalObjectType nop, const MapPoint pos, const unsigned char player) : noCoordBase(nop, pos), player(player)
@@ -32,6 +33,12 @@ noRoadNode::noRoadNode(const NodalObjectType nop, const MapPoint pos, const unsi
 
 noRoadNode::~noRoadNode() = default;
 
+void noRoadNode::SetRoute(const Direction dir, RoadSegment* route)
+{
+    routes[dir.toUInt()] = route;
+    gwg->GetRoadPathFinder().InvalidateWarePaths(player);
+}
+
 void noRoadNode::Destroy_noRoadNode()
 {
     DestroyAllRoads();
@@ -104,7 +111,7 @@ void noRoadNode::DestroyRoad(const Direction dir)
     {
         if(oflag->routes[z] == route)
         {
-            oflag->routes[z] = nullptr;
+            oflag->SetRoute(Direction::fromInt(z), nullptr);
             break;
         } else
             RTTR_Assert(z < 5); // Need to find it before last iteration
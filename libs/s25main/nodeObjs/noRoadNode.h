@@ -65,7 +65,7 @@ public:
     void Serialize(SerializedGameData& sgd) const override { Serialize_noRoadNode(sgd); }
 
     RoadSegment* GetRoute(const Direction dir) const { return routes[dir.toUInt()]; }
-    void SetRoute(const Direction dir, RoadSegment* route) { routes[dir.toUInt()] = route; }
+    void SetRoute(Direction dir, RoadSegment* route);
     noRoadNode* GetNeighbour(Direction dir) const;
 
     void DestroyRoad(Direction dir);
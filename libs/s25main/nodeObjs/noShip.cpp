@@ -117,6 +117,8 @@ noShip::noShip(SerializedGameData& sgd, const unsigned obj_id)
         i = Direction::fromInt(sgd.PopUnsignedChar());
     sgd.PopObjectContainer(figures, GOT_UNKNOWN);
     sgd.PopObjectContainer(wares, GOT_WARE);
+    // The figures of the nodes are loaded without notifying the world
+    gwg->GetMilitarySquares().AddShip(this, pos);
 }
 
 void noShip::Destroy()
@@ -989,7 +991,7 @@ void noShip::StartDrivingToHarborPlace()
         {
             // Use the maximum distance between the harbors plus 6 fields
             unsigned maxDistance = gwg->CalcHarborDistance(home_harbor, goal_harborId) + 6;
-            routeFound = gwg->FindShipPath(pos, coastalPos, maxDistance, &route_, nullptr);
+            routeFound = gwg->FindShipPathToHarbor(pos, goal_harborId, seaId_, &route_, nullptr, maxDistance);
         } else
             routeFound = gwg->FindShipPathToHarbor(pos, goal_harborId, seaId_, &route_, nullptr);
         if(!routeFound)
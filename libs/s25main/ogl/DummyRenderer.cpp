@@ -38,6 +38,18 @@ void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
 void APIENTRY glTexCoordPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
 void APIENTRY glColor4ub(GLubyte, GLubyte, GLubyte, GLubyte) {}
 void APIENTRY glDrawArrays(GLenum, GLint, GLsizei) {}
+void APIENTRY glColorPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
+void APIENTRY glEnableClientState(GLenum) {}
+void APIENTRY glDisableClientState(GLenum) {}
+void APIENTRY glGenBuffers(GLsizei n, GLuint* buffers)
+{
+    static GLuint cur = 0;
+    for(; n > 0; --n)
+        *(buffers++) = ++cur;
+}
+void APIENTRY glDeleteBuffers(GLsizei, const GLuint*) {}
+void APIENTRY glBindBuffer(GLenum, GLuint) {}
+void APIENTRY glBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
 void APIENTRY glGetTexLevelParameteriv(GLenum, GLint, GLenum, GLint* params)
 {
     *params = 1;
@@ -60,6 +72,13 @@ bool DummyRenderer::initOpenGL(OpenGL_Loader_Proc)
     MOCK(glTexCoordPointer);
     MOCK(glColor4ub);
     MOCK(glDrawArrays);
+    MOCK(glColorPointer);
+    MOCK(glEnableClientState);
+    MOCK(glDisableClientState);
+    MOCK(glGenBuffers);
+    MOCK(glDeleteBuffers);
+    MOCK(glBindBuffer);
+    MOCK(glBufferData);
     MOCK(glGetTexLevelParameteriv);
     return true;
 }
@@ -18,6 +18,8 @@
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "OpenGLRenderer.h"
 #include "DrawPoint.h"
+#include "SpriteBatch.h"
+#include "drivers/VideoDriverWrapper.h"
 #include "glArchivItem_Bitmap.h"
 #include "openglCfg.hpp"
 #include <glad/glad.h>
@@ -51,6 +53,7 @@ void OpenGLRenderer::Draw3DBorder(const Rect& rect, bool elevated, glArchivItem_
     texture.DrawPart(Rect(vertImgBorderPos, Extent(2, rectSize.y)));
 
     // Draw black borders over the img borders
+    VIDEODRIVER.GetSpriteBatch().Flush();
     glDisable(GL_TEXTURE_2D);
     glColor3f(0.0f, 0.0f, 0.0f);
     glBegin(GL_TRIANGLE_STRIP);
@@ -81,9 +84,11 @@ void OpenGLRenderer::Draw3DBorder(const Rect& rect, bool elevated, glArchivItem_
 
 void OpenGLRenderer::Draw3DContent(const Rect& rect, bool elevated, glArchivItem_Bitmap& texture, bool illuminated, unsigned color)
 {
+    SpriteBatch& batch = VIDEODRIVER.GetSpriteBatch();
     if(illuminated)
     {
         // Modulate2x anmachen
+        batch.Flush();
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
         glTexEnvf(GL_TEXTURE_ENV, GL_RGB_SCALE, 2.0f);
     }
@@ -99,12 +104,14 @@ void OpenGLRenderer::Draw3DContent(const Rect& rect, bool elevated, glArchivItem
     if(illuminated)
     {
         // Modulate2x wieder ausmachen
+        batch.Flush();
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
     }
 }
 
 void OpenGLRenderer::DrawRect(const Rect& rect, unsigned color)
 {
+    VIDEODRIVER.GetSpriteBatch().Flush();
     glDisable(GL_TEXTURE_2D);
 
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
@@ -121,6 +128,7 @@ void OpenGLRenderer::DrawRect(const Rect& rect, unsigned color)
 
 void OpenGLRenderer::DrawLine(DrawPoint pt1, DrawPoint pt2, unsigned width, unsigned color)
 {
+    VIDEODRIVER.GetSpriteBatch().Flush();
     glDisable(GL_TEXTURE_2D);
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
 
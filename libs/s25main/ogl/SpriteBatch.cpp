@@ -0,0 +1,110 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "SpriteBatch.h"
+#include "Settings.h"
+#include "drivers/VideoDriverWrapper.h"
+#include "s25util/colors.h"
+#include <glad/glad.h>
+#include <cstddef>
+
+namespace {
+/// Minimum number of quads drawn from the VBO. Uploading fewer (e.g. single GUI images drawn without batching)
+/// into a buffer costs more than drawing them from client memory
+const unsigned MIN_QUADS_FOR_VBO = 16;
+} // namespace
+
+SpriteBatch::SpriteBatch() : isEnabled_(true), isActive_(false), texture_(0) {}
+
+SpriteBatch::~SpriteBatch() = default;
+
+void SpriteBatch::Begin()
+{
+    RTTR_Assert(vertices_.empty());
+    isActive_ = isEnabled_;
+}
+
+void SpriteBatch::End()
+{
+    Flush();
+    isActive_ = false;
+}
+
+void SpriteBatch::AddQuad(unsigned texture, const Quad& vertices, const Quad& texCoords, unsigned color)
+{
+    if(texture != texture_)
+    {
+        Flush();
+        texture_ = texture;
+    }
+    const Color vertexColor = {static_cast<uint8_t>(GetRed(color)), static_cast<uint8_t>(GetGreen(color)),
+                               static_cast<uint8_t>(GetBlue(color)), static_cast<uint8_t>(GetAlpha(color))};
+    for(unsigned i = 0; i < vertices.size(); i++)
+    {
+        const Vertex vertex = {vertices[i], texCoords[i], vertexColor};
+        vertices_.push_back(vertex);
+    }
+    curStats_.numQuads++;
+    if(!isActive_)
+        Flush();
+}
+
+void SpriteBatch::Flush()
+{
+    if(vertices_.empty())
+        return;
+
+    VIDEODRIVER.BindTexture(texture_);
+    const Vertex* data = vertices_.data();
+    const bool useVBO = SETTINGS.video.vbo && vertices_.size() >= MIN_QUADS_FOR_VBO * 4u;
+    if(useVBO)
+    {
+        // Reuse the buffer for every flush. Filling it with new data lets the driver orphan the old one
+        if(!vbo_.isValid())
+            vbo_ = ogl::VBO<Vertex>(ogl::Target::Array);
+        vbo_.fill(vertices_, ogl::Usage::Stream);
+        data = nullptr;
+    }
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const char*>(data) + offsetof(Vertex, pos));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const char*>(data) + offsetof(Vertex, texCoord));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const char*>(data) + offsetof(Vertex, color));
+    glEnableClientState(GL_COLOR_ARRAY);
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(vertices_.size()));
+    glDisableClientState(GL_COLOR_ARRAY);
+    // Unbind VBO to not interfere with other program parts
+    if(useVBO)
+        vbo_.unbind();
+
+    curStats_.numDrawCalls++;
+    if(isActive_)
+        curStats_.numFlushes++;
+    vertices_.clear();
+}
+
+void SpriteBatch::ReleaseBuffer()
+{
+    vertices_.clear();
+    vbo_ = ogl::VBO<Vertex>();
+}
+
+void SpriteBatch::NextFrame()
+{
+    Flush();
+    lastFrameStats_ = curStats_;
+    curStats_ = Statistics();
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SpriteBatch_h__
+#define SpriteBatch_h__
+
+#include "Point.h"
+#include "ogl/VBO.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// Collects textured quads and draws consecutive quads with the same texture in a single draw call.
+/// Quads are only collected between Begin and End, otherwise each one is drawn directly.
+/// Everything drawing without the batch has to call Flush first to keep the drawing order.
+class SpriteBatch
+{
+public:
+    using Quad = std::array<Point<float>, 4>;
+    struct Statistics
+    {
+        /// Number of draw calls issued (batched or not)
+        unsigned numDrawCalls;
+        /// Number of quads drawn
+        unsigned numQuads;
+        /// Number of draw calls of collected quads
+        unsigned numFlushes;
+
+        Statistics() : numDrawCalls(0), numQuads(0), numFlushes(0) {}
+    };
+
+    SpriteBatch();
+    ~SpriteBatch();
+
+    /// Start collecting quads (if enabled)
+    void Begin();
+    /// Draw the collected quads and stop collecting
+    void End();
+    bool IsActive() const { return isActive_; }
+    /// Allow or disallow collecting quads. Used to compare both variants
+    void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+    bool IsEnabled() const { return isEnabled_; }
+
+    /// Add a quad with the given vertices and texture coordinates which is drawn with the given color
+    void AddQuad(unsigned texture, const Quad& vertices, const Quad& texCoords, unsigned color);
+    /// Draw all collected quads
+    void Flush();
+    /// Release the GL buffer, e.g. before the context is destroyed
+    void ReleaseBuffer();
+
+    /// Start a new frame. Keeps the statistics of the finished frame
+    void NextFrame();
+    const Statistics& GetLastFrameStatistics() const { return lastFrameStats_; }
+
+private:
+    struct Color
+    {
+        uint8_t r, g, b, a;
+    };
+    struct Vertex
+    {
+        Point<float> pos, texCoord;
+        Color color;
+    };
+
+    bool isEnabled_, isActive_;
+    /// Texture of the collected quads
+    unsigned texture_;
+    std::vector<Vertex> vertices_;
+    /// Buffer used for uploading the vertices of big batches (if VBOs are enabled)
+    ogl::VBO<Vertex> vbo_;
+    Statistics curStats_, lastFrameStats_;
+};
+
+#endif // SpriteBatch_h__
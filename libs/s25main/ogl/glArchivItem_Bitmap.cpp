@@ -19,6 +19,7 @@
 #include "glArchivItem_Bitmap.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
@@ -54,7 +55,7 @@ void glArchivItem_Bitmap::Draw(Rect dstArea, Rect srcArea, unsigned color /*= CO
 
     RTTR_Assert(getBobType() != libsiedler2::BobType::BitmapPlayer);
 
-    std::array<Point<GLfloat>, 4> texCoords, vertices;
+    SpriteBatch::Quad texCoords, vertices;
 
     dstArea.move(-GetOrigin());
 
@@ -70,11 +71,7 @@ void glArchivItem_Bitmap::Draw(Rect dstArea, Rect srcArea, unsigned color /*= CO
     texCoords[0].y = texCoords[3].y = srcOrig.y;
     texCoords[1].y = texCoords[2].y = srcEndPt.y;
 
-    glVertexPointer(2, GL_FLOAT, 0, vertices.data());
-    glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
-    VIDEODRIVER.BindTexture(GetTexture());
-    glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
-    glDrawArrays(GL_QUADS, 0, 4);
+    VIDEODRIVER.GetSpriteBatch().AddQuad(GetTexture(), vertices, texCoords, color);
 }
 
 void glArchivItem_Bitmap::DrawFull(const Rect& destArea, unsigned color)
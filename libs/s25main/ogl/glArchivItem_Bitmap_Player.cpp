@@ -20,16 +20,10 @@
 #include "Loader.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
-namespace {
-struct GL_RGBAColor
-{
-    GLbyte r, g, b, a;
-};
-} // namespace
-
 Extent glArchivItem_Bitmap_Player::CalcTextureSize() const
 {
     // We have the texture 2 times: one with non-player colors and one with them
@@ -67,7 +61,7 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
         dstSize.y = srcSize.y;
     dstArea.setSize(dstSize);
 
-    std::array<Point<GLfloat>, 8> texCoords, vertices;
+    SpriteBatch::Quad texCoords, vertices;
 
     dstArea.move(-GetOrigin());
 
@@ -83,34 +77,14 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
     texCoords[0].y = texCoords[3].y = srcOrig.y;
     texCoords[1].y = texCoords[2].y = srcEndPt.y;
 
-    std::copy(vertices.begin(), vertices.begin() + 4, vertices.begin() + 4);
-    std::copy(texCoords.begin(), texCoords.begin() + 4, texCoords.begin() + 4);
-
-    texCoords[4].x += 0.5f;
-    texCoords[5].x += 0.5f;
-    texCoords[6].x += 0.5f;
-    texCoords[7].x += 0.5f;
-
-    std::array<GL_RGBAColor, 8> colors;
-    colors[0].r = GetRed(color);
-    colors[0].g = GetGreen(color);
-    colors[0].b = GetBlue(color);
-    colors[0].a = GetAlpha(color);
-    colors[3] = colors[2] = colors[1] = colors[0];
-
-    colors[4].r = GetRed(player_color);
-    colors[4].g = GetGreen(player_color);
-    colors[4].b = GetBlue(player_color);
-    colors[4].a = GetAlpha(player_color);
-    colors[7] = colors[6] = colors[5] = colors[4];
-
-    glEnableClientState(GL_COLOR_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 0, vertices.data());
-    glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
-    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
-    VIDEODRIVER.BindTexture(GetTexture());
-    glDrawArrays(GL_QUADS, 0, 8);
-    glDisableClientState(GL_COLOR_ARRAY);
+    // The player colored part is in the right half of the texture
+    SpriteBatch::Quad playerTexCoords = texCoords;
+    for(Point<float>& texCoord : playerTexCoords)
+        texCoord.x += 0.5f;
+
+    SpriteBatch& batch = VIDEODRIVER.GetSpriteBatch();
+    batch.AddQuad(GetTexture(), vertices, texCoords, color);
+    batch.AddQuad(GetTexture(), vertices, playerTexCoords, player_color);
 }
 
 void glArchivItem_Bitmap_Player::FillTexture()
@@ -21,6 +21,7 @@
 #include "drivers/VideoDriverWrapper.h"
 #include "glArchivItem_Bitmap.h"
 #include "helpers/containerUtils.h"
+#include "ogl/SpriteBatch.h"
 #include "libsiedler2/ArchivItem_Bitmap_Player.h"
 #include "libsiedler2/ArchivItem_Font.h"
 #include "libsiedler2/IAllocator.h"
@@ -263,6 +264,7 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
     for(GlPoint& pt : texList.texCoords)
         pt /= texSize;
 
+    VIDEODRIVER.GetSpriteBatch().Flush();
     glVertexPointer(2, GL_FLOAT, 0, &texList.vertices[0]);
     glTexCoordPointer(2, GL_FLOAT, 0, &texList.texCoords[0]);
     VIDEODRIVER.BindTexture(texture);
@@ -19,6 +19,7 @@
 #include "glSmartBitmap.h"
 #include "Loader.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "ogl/glBitmapItem.h"
 #include "libsiedler2/ArchivItem_Bitmap.h"
 #include "libsiedler2/ArchivItem_Bitmap_Player.h"
@@ -27,13 +28,6 @@
 #include <glad/glad.h>
 #include <limits>
 
-namespace {
-struct GL_RGBAColor
-{
-    GLbyte r, g, b, a;
-};
-} // namespace
-
 glSmartBitmap::glSmartBitmap() : origin_(0, 0), size_(0, 0), sharedTexture(false), texture(0), hasPlayer(false) {}
 
 glSmartBitmap::~glSmartBitmap()
@@ -266,8 +260,7 @@ void glSmartBitmap::drawPercent(DrawPoint drawPt, unsigned percent, unsigned col
     RTTR_Assert(percent <= 100);
 
     const float partDrawn = percent / 100.f;
-    std::array<Point<GLfloat>, 8> vertices, curTexCoords;
-    std::array<GL_RGBAColor, 8> colors;
+    SpriteBatch::Quad vertices, curTexCoords;
 
     drawPt -= origin_;
     vertices[2] = Point<GLfloat>(drawPt) + size_;
@@ -278,44 +271,23 @@ void glSmartBitmap::drawPercent(DrawPoint drawPt, unsigned percent, unsigned col
     vertices[0].y = vertices[3].y = GLfloat(drawPt.y + size_.y * (1.f - partDrawn));
     vertices[1].y = vertices[2].y;
 
-    colors[0].r = GetRed(color);
-    colors[0].g = GetGreen(color);
-    colors[0].b = GetBlue(color);
-    colors[0].a = GetAlpha(color);
-    colors[3] = colors[2] = colors[1] = colors[0];
-
     curTexCoords[0] = texCoords[0];
     curTexCoords[1] = texCoords[1];
     curTexCoords[2] = texCoords[2];
     curTexCoords[3] = texCoords[3];
     curTexCoords[0].y = curTexCoords[3].y = curTexCoords[1].y - (curTexCoords[1].y - curTexCoords[0].y) * partDrawn;
 
-    int numQuads;
+    SpriteBatch& batch = VIDEODRIVER.GetSpriteBatch();
+    batch.AddQuad(texture, vertices, curTexCoords, color);
+
     if(player_color && hasPlayer)
     {
-        std::copy(vertices.begin(), vertices.begin() + 4, vertices.begin() + 4);
-
-        colors[4].r = GetRed(player_color);
-        colors[4].g = GetGreen(player_color);
-        colors[4].b = GetBlue(player_color);
-        colors[4].a = GetAlpha(player_color);
-        colors[7] = colors[6] = colors[5] = colors[4];
-
-        curTexCoords[4] = texCoords[4];
-        curTexCoords[5] = texCoords[5];
-        curTexCoords[6] = texCoords[6];
-        curTexCoords[7] = texCoords[7];
-        curTexCoords[4].y = curTexCoords[7].y = curTexCoords[0].y;
-
-        numQuads = 8;
-    } else
-        numQuads = 4;
-
-    glEnableClientState(GL_COLOR_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 0, vertices.data());
-    glTexCoordPointer(2, GL_FLOAT, 0, curTexCoords.data());
-    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
-    VIDEODRIVER.BindTexture(texture);
-    glDrawArrays(GL_QUADS, 0, numQuads);
-    glDisableClientState(GL_COLOR_ARRAY);
+        SpriteBatch::Quad playerTexCoords;
+        playerTexCoords[0] = texCoords[4];
+        playerTexCoords[1] = texCoords[5];
+        playerTexCoords[2] = texCoords[6];
+        playerTexCoords[3] = texCoords[7];
+        playerTexCoords[0].y = playerTexCoords[3].y = curTexCoords[0].y;
+        batch.AddQuad(texture, vertices, playerTexCoords, player_color);
+    }
 }
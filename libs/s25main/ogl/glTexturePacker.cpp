@@ -23,9 +23,54 @@
 #include "ogl/saveBitmap.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <utility>
 
+namespace bfs = boost::filesystem;
+
+namespace {
+/// Format of the cache file: Header, one Item per bitmap, per texture its size and the pixels in BGRA format
+constexpr std::array<char, 8> cacheSignature = {{'R', 'T', 'T', 'R', 'T', 'E', 'X', 'C'}};
+constexpr uint32_t cacheVersion = 1;
+
+struct CacheHeader
+{
+    std::array<char, 8> signature;
+    uint64_t key;
+    uint32_t version;
+    uint32_t numItems, numTextures;
+};
+struct CacheItem
+{
+    uint32_t texture;
+    /// Used to verify that the bitmap is still the same
+    uint32_t width, height;
+    std::array<Point<float>, 8> texCoords;
+};
+
+template<typename T>
+void writeRaw(bnw::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Copy the value at the position into result and advance the position. Return false if the data ends before
+template<typename T>
+bool readRaw(const char*& pos, const char* end, T& result)
+{
+    if(static_cast<size_t>(end - pos) < sizeof(result))
+        return false;
+    std::memcpy(&result, pos, sizeof(result));
+    pos += sizeof(result);
+    return true;
+}
+} // namespace
+
 static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
 {
     const Extent sizeA = a->getRequiredTexSize();
@@ -105,10 +150,14 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
             if(left.empty()) // nothing left, just generate texture and return success
             {
                 textures.emplace_back(std::move(texture));
+                if(keepPixelData)
+                    pixelData.emplace_back(std::move(buffer));
                 return true;
             } else if(maxTex) // maximum texture size reached and something still left
             {
                 textures.emplace_back(std::move(texture));
+                if(keepPixelData)
+                    pixelData.emplace_back(std::move(buffer));
                 // recursively generate textures for what is left
                 return packHelper(left);
             }
@@ -127,22 +176,141 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
     } while(true);
 }
 
-bool glTexturePacker::pack()
-{
-    std::sort(items.begin(), items.end(), isSizeGreater);
+glTexturePacker::glTexturePacker() : keepPixelData(false) {}
 
-    if(packHelper(items))
-        return true;
+glTexturePacker::~glTexturePacker() = default;
 
+void glTexturePacker::reset()
+{
     // reset glSmartBitmap textures
     for(glSmartBitmap* bmp : items)
         bmp->setSharedTexture(0);
 
     textures.clear();
+    pixelData.clear();
+}
+
+bool glTexturePacker::pack(bool keepPixelData)
+{
+    this->keepPixelData = keepPixelData;
+    // Sort a copy as saving requires the original order
+    std::vector<glSmartBitmap*> sortedItems = items;
+    std::sort(sortedItems.begin(), sortedItems.end(), isSizeGreater);
+
+    if(packHelper(sortedItems))
+        return true;
+
+    reset();
 
     return false;
 }
 
+bool glTexturePacker::save(const std::string& filePath, uint64_t key)
+{
+    if(textures.empty() || pixelData.size() != textures.size())
+        return false;
+
+    boost::system::error_code ec;
+    bfs::create_directories(bfs::path(filePath).parent_path(), ec);
+    bnw::ofstream file(filePath, std::ios::binary);
+    if(!file)
+        return false;
+
+    CacheHeader header;
+    header.signature = cacheSignature;
+    header.version = cacheVersion;
+    header.numItems = static_cast<uint32_t>(items.size());
+    header.numTextures = static_cast<uint32_t>(textures.size());
+    header.key = key;
+    writeRaw(file, header);
+
+    for(const glSmartBitmap* bmp : items)
+    {
+        CacheItem item;
+        const auto itTexture = std::find_if(textures.begin(), textures.end(),
+                                            [bmp](const glTexture& texture) { return texture.get() == bmp->getTexture(); });
+        if(itTexture == textures.end())
+            return false;
+        item.texture = static_cast<uint32_t>(itTexture - textures.begin());
+        item.width = bmp->getRequiredTexSize().x;
+        item.height = bmp->getRequiredTexSize().y;
+        item.texCoords = bmp->texCoords;
+        writeRaw(file, item);
+    }
+
+    for(const libsiedler2::PixelBufferBGRA& buffer : pixelData)
+    {
+        writeRaw(file, static_cast<uint32_t>(buffer.getWidth()));
+        writeRaw(file, static_cast<uint32_t>(buffer.getHeight()));
+        const auto numBytes = static_cast<std::streamsize>(buffer.getWidth()) * buffer.getHeight() * 4;
+        file.write(reinterpret_cast<const char*>(buffer.getPixelPtr()), numBytes);
+    }
+    pixelData.clear();
+    return static_cast<bool>(file);
+}
+
+bool glTexturePacker::load(const std::string& filePath, uint64_t key)
+{
+    RTTR_Assert(textures.empty());
+
+    boost::system::error_code ec;
+    if(!bfs::is_regular_file(filePath, ec))
+        return false;
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(filePath);
+    } catch(const std::exception&)
+    {
+        return false;
+    }
+    const char* pos = file.data();
+    const char* const end = pos + file.size();
+
+    CacheHeader header;
+    if(!readRaw(pos, end, header) || header.signature != cacheSignature || header.version != cacheVersion || header.key != key
+       || header.numItems != items.size())
+        return false;
+
+    // Verify all bitmaps before creating any texture
+    std::vector<CacheItem> cacheItems(header.numItems);
+    for(unsigned i = 0; i < items.size(); i++)
+    {
+        CacheItem& item = cacheItems[i];
+        if(!readRaw(pos, end, item) || item.texture >= header.numTextures
+           || Extent(item.width, item.height) != items[i]->getRequiredTexSize())
+            return false;
+    }
+
+    for(unsigned i = 0; i < header.numTextures; i++)
+    {
+        Extent size;
+        if(!readRaw(pos, end, size.x) || !readRaw(pos, end, size.y))
+            break;
+        const size_t numBytes = static_cast<size_t>(size.x) * size.y * 4u;
+        if(static_cast<size_t>(end - pos) < numBytes)
+            break;
+        glTexture texture;
+        // The pixels are uploaded directly from the mapped file
+        if(!texture.checkSize(size) || !texture.uploadData(size, reinterpret_cast<const uint8_t*>(pos)))
+            break;
+        pos += numBytes;
+        textures.emplace_back(std::move(texture));
+    }
+    if(textures.size() != header.numTextures)
+    {
+        reset();
+        return false;
+    }
+
+    for(unsigned i = 0; i < items.size(); i++)
+    {
+        items[i]->setSharedTexture(textures[cacheItems[i].texture].get());
+        items[i]->texCoords = cacheItems[i].texCoords;
+    }
+    return true;
+}
+
 glTexture::glTexture() : handle(VIDEODRIVER.GenerateTexture()), size(0, 0)
 {
     if(!handle)
@@ -187,12 +355,17 @@ bool glTexture::checkSize(const Extent& size)
 }
 
 bool glTexture::uploadData(const libsiedler2::PixelBufferBGRA& buffer)
+{
+    return uploadData(Extent(buffer.getWidth(), buffer.getHeight()), buffer.getPixelPtr());
+}
+
+bool glTexture::uploadData(const Extent& texSize, const uint8_t* pixels)
 {
     if(!handle)
         return false;
     VIDEODRIVER.BindTexture(handle);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, buffer.getWidth(), buffer.getHeight(), 0, GL_BGRA, GL_UNSIGNED_BYTE, buffer.getPixelPtr());
-    size = Extent(buffer.getWidth(), buffer.getHeight());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texSize.x, texSize.y, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+    size = texSize;
     int resultWidth;
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &resultWidth);
     return resultWidth > 0;
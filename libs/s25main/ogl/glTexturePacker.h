@@ -19,14 +19,13 @@
 #define glTexturePacker_h__
 
 #include "Point.h"
+#include "libsiedler2/PixelBufferBGRA.h"
+#include <cstdint>
+#include <string>
 #include <vector>
 
 class glSmartBitmap;
 
-namespace libsiedler2 {
-class PixelBufferBGRA;
-}
-
 class glTexture
 {
     unsigned handle;
@@ -47,18 +46,35 @@ public:
     void bind();
     bool checkSize(const Extent&);
     bool uploadData(const libsiedler2::PixelBufferBGRA&);
+    /// Upload texSize.x * texSize.y pixels in BGRA format
+    bool uploadData(const Extent& texSize, const uint8_t* pixels);
 };
 
 class glTexturePacker
 {
 private:
     std::vector<glTexture> textures;
+    /// Bitmaps in the order they were added
     std::vector<glSmartBitmap*> items;
+    bool keepPixelData;
+    /// Content of the textures (only if requested in pack)
+    std::vector<libsiedler2::PixelBufferBGRA> pixelData;
 
     bool packHelper(std::vector<glSmartBitmap*>& list);
+    void reset();
 
 public:
-    bool pack();
+    glTexturePacker();
+    ~glTexturePacker();
+
+    /// Pack all bitmaps into shared textures. Keep the texture contents for saving them if keepPixelData is true
+    bool pack(bool keepPixelData = false);
+    /// Save the textures and the texture coordinates of all bitmaps to a file which can be loaded instead of packing again.
+    /// Requires a previous pack(true) and releases the kept texture contents
+    bool save(const std::string& filePath, uint64_t key);
+    /// Load textures and texture coordinates written by save instead of packing.
+    /// Fails if the key or the added bitmaps do not match the saved ones
+    bool load(const std::string& filePath, uint64_t key);
     void add(glSmartBitmap& bmp) { items.push_back(&bmp); }
     const auto& getTextures() const { return textures; }
 };
@@ -28,48 +28,104 @@
 /// FreePathFinder implementation
 //////////////////////////////////////////////////////////////////////////
 
-/// MapNodes
-using MapNodes = std::vector<NewNode>;
-using FreePathNodes = std::vector<FreePathNode>;
-MapNodes nodes;
-FreePathNodes fpNodes;
+FreePathFinder::FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), size_(0, 0), numUsedWorkspaces_(0) {}
+
+FreePathFinder::~FreePathFinder()
+{
+    RTTR_Assert(numUsedWorkspaces_ == 0u);
+}
 
 void FreePathFinder::Init(const MapExtent& mapSize)
 {
-    currentVisit = 0;
+    std::lock_guard<std::mutex> lock(workspaceMutex_);
+    RTTR_Assert(numUsedWorkspaces_ == 0u);
     size_ = Extent(mapSize);
-    // Reset nodes
-    nodes.clear();
-    fpNodes.clear();
-    nodes.resize(size_.x * size_.y);
-    fpNodes.resize(nodes.size());
-    RTTR_FOREACH_PT(MapPoint, size_)
+    // Nodes are (re-)created on first use
+    freeWorkspaces_.clear();
+}
+
+unsigned FreePathFinder::GetNumWorkspaces() const
+{
+    std::lock_guard<std::mutex> lock(workspaceMutex_);
+    return freeWorkspaces_.size() + numUsedWorkspaces_;
+}
+
+FreePathFinder::WorkspaceLease::WorkspaceLease(FreePathFinder& pf) : pf_(pf), ws_(pf.AcquireWorkspace()) {}
+
+FreePathFinder::WorkspaceLease::~WorkspaceLease()
+{
+    pf_.ReleaseWorkspace(std::move(ws_));
+}
+
+std::unique_ptr<FreePathWorkspace> FreePathFinder::AcquireWorkspace()
+{
+    std::unique_ptr<FreePathWorkspace> ws;
+    {
+        std::lock_guard<std::mutex> lock(workspaceMutex_);
+        ++numUsedWorkspaces_;
+        if(!freeWorkspaces_.empty())
+        {
+            ws = std::move(freeWorkspaces_.back());
+            freeWorkspaces_.pop_back();
+        }
+    }
+    if(!ws)
+        ws = std::make_unique<FreePathWorkspace>();
+    return ws;
+}
+
+void FreePathFinder::ReleaseWorkspace(std::unique_ptr<FreePathWorkspace> ws)
+{
+    std::lock_guard<std::mutex> lock(workspaceMutex_);
+    RTTR_Assert(numUsedWorkspaces_ > 0u);
+    --numUsedWorkspaces_;
+    freeWorkspaces_.push_back(std::move(ws));
+}
+
+std::vector<FreePathNode>& FreePathFinder::GetFreePathNodes(FreePathWorkspace& ws) const
+{
+    if(ws.fpNodes.empty())
+    {
+        ws.fpNodes.resize(size_.x * size_.y);
+        RTTR_FOREACH_PT(MapPoint, size_)
+        {
+            const unsigned idx = gwb_.GetIdx(pt);
+            ws.fpNodes[idx].lastVisited = 0;
+            ws.fpNodes[idx].mapPt = pt;
+            ws.fpNodes[idx].idx = idx;
+        }
+    }
+    return ws.fpNodes;
+}
+
+std::vector<NewNode>& FreePathFinder::GetNodes(FreePathWorkspace& ws) const
+{
+    if(ws.nodes.empty())
     {
-        const unsigned idx = gwb_.GetIdx(pt);
-        nodes[idx].mapPt = pt;
-        fpNodes[idx].lastVisited = 0;
-        fpNodes[idx].mapPt = pt;
-        fpNodes[idx].idx = idx;
+        ws.nodes.resize(size_.x * size_.y);
+        RTTR_FOREACH_PT(MapPoint, size_)
+            ws.nodes[gwb_.GetIdx(pt)].mapPt = pt;
     }
+    return ws.nodes;
 }
 
-void FreePathFinder::IncreaseCurrentVisit()
+void FreePathFinder::IncreaseCurrentVisit(FreePathWorkspace& ws)
 {
     // if the counter reaches its maxium, tidy up
-    if(currentVisit == std::numeric_limits<unsigned>::max())
+    if(ws.currentVisit == std::numeric_limits<unsigned>::max())
     {
-        for(auto& node : nodes)
+        for(auto& node : ws.nodes)
         {
             node.lastVisited = 0;
             node.lastVisitedEven = 0;
         }
-        for(auto& fpNode : fpNodes)
+        for(auto& fpNode : ws.fpNodes)
         {
             fpNode.lastVisited = 0;
         }
-        currentVisit = 1;
+        ws.currentVisit = 1;
     } else
-        currentVisit++;
+        ws.currentVisit++;
 }
 
 /// Pathfinder ( A* ), O(v lg v) --> Normal terrain (ignoring roads) for road building and free walking jobs
@@ -94,8 +150,10 @@ bool FreePathFinder::FindPathAlternatingConditions(const MapPoint start, const M
         return true;
     }
 
-    // increase currentVisit, so we don't have to clear the visited-states at every run
-    IncreaseCurrentVisit();
+    const WorkspaceLease ws(*this);
+    std::vector<NewNode>& nodes = GetNodes(*ws);
+    IncreaseCurrentVisit(*ws);
+    const unsigned currentVisit = (*ws).currentVisit;
 
     std::list<PathfindingPoint> todo;
     const unsigned destId = gwb_.GetIdx(dest);
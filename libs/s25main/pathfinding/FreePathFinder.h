@@ -20,9 +20,14 @@
 
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 
 class GameWorldBase;
+struct FreePathNode;
+struct FreePathWorkspace;
+struct NewNode;
 
 using FP_Node_OK_Callback = bool (*)(const GameWorldBase&, const MapPoint, const Direction, const void*);
 
@@ -33,11 +38,30 @@ using FP_Node_OK_Callback = bool (*)(const GameWorldBase&, const MapPoint, const
 class FreePathFinder
 {
     GameWorldBase& gwb_;
-    unsigned currentVisit;
     Extent size_;
+    /// Workspaces not used by any running search. They are kept to avoid reallocating the nodes for every search
+    std::vector<std::unique_ptr<FreePathWorkspace>> freeWorkspaces_;
+    /// Number of workspaces currently in use by searches
+    unsigned numUsedWorkspaces_;
+    mutable std::mutex workspaceMutex_;
+
+    /// Gets a workspace from the finder for the duration of a search and returns it afterwards
+    class WorkspaceLease
+    {
+        FreePathFinder& pf_;
+        std::unique_ptr<FreePathWorkspace> ws_;
+
+    public:
+        explicit WorkspaceLease(FreePathFinder& pf);
+        WorkspaceLease(const WorkspaceLease&) = delete;
+        WorkspaceLease& operator=(const WorkspaceLease&) = delete;
+        ~WorkspaceLease();
+        FreePathWorkspace& operator*() const { return *ws_; }
+    };
 
 public:
-    FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0) {}
+    FreePathFinder(GameWorldBase& gwb);
+    ~FreePathFinder();
     void Init(const MapExtent& mapSize);
 
     /// Wegfindung in freiem Terrain - Template version. Users need to include FreePathFinderImpl.h
@@ -56,8 +80,18 @@ public:
     bool CheckRoute(MapPoint start, const std::vector<Direction>& route, unsigned pos, const TNodeChecker& nodeChecker,
                     MapPoint* dest) const;
 
+    /// Number of workspaces allocated so far (== max number of searches that ran at the same time)
+    unsigned GetNumWorkspaces() const;
+
 private:
-    void IncreaseCurrentVisit();
+    std::unique_ptr<FreePathWorkspace> AcquireWorkspace();
+    void ReleaseWorkspace(std::unique_ptr<FreePathWorkspace> ws);
+    /// Return the nodes for FindPath initializing them if required
+    std::vector<FreePathNode>& GetFreePathNodes(FreePathWorkspace& ws) const;
+    /// Return the nodes for FindPathAlternatingConditions initializing them if required
+    std::vector<NewNode>& GetNodes(FreePathWorkspace& ws) const;
+    /// Increase currentVisit of the workspace, so we don't have to clear the visited-states at every run
+    static void IncreaseCurrentVisit(FreePathWorkspace& ws);
 };
 
 #endif // FreePathFinder_h__
@@ -26,9 +26,6 @@
 #include "pathfinding/PathfindingPoint.h"
 #include "world/GameWorldBase.h"
 
-using FreePathNodes = std::vector<FreePathNode>;
-extern FreePathNodes fpNodes;
-
 struct NodePtrCmpGreater
 {
     bool operator()(const FreePathNode* const lhs, const FreePathNode* const rhs) const
@@ -57,8 +54,10 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
 {
     RTTR_Assert(start != dest);
 
-    // increase currentVisit, so we don't have to clear the visited-states at every run
-    IncreaseCurrentVisit();
+    const WorkspaceLease ws(*this);
+    std::vector<FreePathNode>& fpNodes = GetFreePathNodes(*ws);
+    IncreaseCurrentVisit(*ws);
+    const unsigned currentVisit = (*ws).currentVisit;
 
     QueueImpl todo;
     const unsigned startId = gwb_.GetIdx(start);
@@ -0,0 +1,394 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "pathfinding/HierarchicalPathFinder.h"
+#include "helpers/containerUtils.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "world/World.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+HierarchicalPathFinder::HierarchicalPathFinder(const World& world) : world_(world), numClusters_(0, 0), numClusterUpdates_(0) {}
+
+void HierarchicalPathFinder::Init(const MapExtent& mapSize)
+{
+    numClusters_ = Extent((mapSize.x + CLUSTER_SIZE - 1) / CLUSTER_SIZE, (mapSize.y + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+    clusters_.clear();
+    clusters_.resize(numClusters_.x * numClusters_.y);
+    dirtyClusters_.clear();
+    for(unsigned cy = 0; cy < numClusters_.y; cy++)
+    {
+        for(unsigned cx = 0; cx < numClusters_.x; cx++)
+        {
+            const unsigned clusterIdx = cy * numClusters_.x + cx;
+            Cluster& cluster = clusters_[clusterIdx];
+            // All 8 surrounding clusters (wrapping around the map borders)
+            for(unsigned y = cy + numClusters_.y - 1; y <= cy + numClusters_.y + 1; y++)
+            {
+                for(unsigned x = cx + numClusters_.x - 1; x <= cx + numClusters_.x + 1; x++)
+                {
+                    const unsigned nbIdx = (y % numClusters_.y) * numClusters_.x + x % numClusters_.x;
+                    if(nbIdx != clusterIdx)
+                        cluster.neighbours.push_back(nbIdx);
+                }
+            }
+            helpers::makeUnique(cluster.neighbours);
+            std::sort(cluster.neighbours.begin(), cluster.neighbours.end());
+            cluster.crossings.resize(cluster.neighbours.size());
+            dirtyClusters_.push_back(clusterIdx);
+        }
+    }
+    entranceIdx_.assign(static_cast<size_t>(mapSize.x) * mapSize.y, NO_ENTRANCE);
+}
+
+unsigned HierarchicalPathFinder::GetClusterIdx(const MapPoint pt) const
+{
+    return (pt.y / CLUSTER_SIZE) * numClusters_.x + pt.x / CLUSTER_SIZE;
+}
+
+unsigned HierarchicalPathFinder::GetLocalIdx(const MapPoint pt)
+{
+    return (pt.y % CLUSTER_SIZE) * CLUSTER_SIZE + pt.x % CLUSTER_SIZE;
+}
+
+void HierarchicalPathFinder::NodeChanged(const MapPoint pt)
+{
+    if(clusters_.empty())
+        return;
+    const unsigned clusterIdx = GetClusterIdx(pt);
+    Cluster& cluster = clusters_[clusterIdx];
+    if(!cluster.isDirty)
+    {
+        cluster.isDirty = true;
+        dirtyClusters_.push_back(clusterIdx);
+    }
+}
+
+void HierarchicalPathFinder::UpdateClusters()
+{
+    if(dirtyClusters_.empty())
+        return;
+    // Crossings depend on both clusters, entrances of a cluster on the crossings to all of its neighbours
+    std::sort(dirtyClusters_.begin(), dirtyClusters_.end());
+    std::vector<unsigned> changedClusters = dirtyClusters_;
+    for(const unsigned clusterIdx : dirtyClusters_)
+    {
+        const Cluster& cluster = clusters_[clusterIdx];
+        for(unsigned i = 0; i < cluster.neighbours.size(); i++)
+        {
+            const unsigned nbIdx = cluster.neighbours[i];
+            // Calculate crossings between 2 dirty clusters only once
+            if(clusters_[nbIdx].isDirty && nbIdx < clusterIdx)
+                continue;
+            UpdateCrossings(clusterIdx, i);
+            changedClusters.push_back(nbIdx);
+        }
+    }
+    for(const unsigned clusterIdx : dirtyClusters_)
+        clusters_[clusterIdx].isDirty = false;
+    dirtyClusters_.clear();
+
+    std::sort(changedClusters.begin(), changedClusters.end());
+    changedClusters.erase(std::unique(changedClusters.begin(), changedClusters.end()), changedClusters.end());
+    for(const unsigned clusterIdx : changedClusters)
+        UpdateEntrances(clusterIdx);
+}
+
+void HierarchicalPathFinder::UpdateCrossings(const unsigned clusterIdx, const unsigned neighbourIdx)
+{
+    // Always calculate from the cluster with the lower index so the result does not depend on which one is updated
+    const unsigned idxA = std::min(clusterIdx, clusters_[clusterIdx].neighbours[neighbourIdx]);
+    const unsigned idxB = std::max(clusterIdx, clusters_[clusterIdx].neighbours[neighbourIdx]);
+    Cluster& clusterA = clusters_[idxA];
+    Cluster& clusterB = clusters_[idxB];
+
+    const PathConditionHuman condition(world_);
+    std::vector<Crossing> candidates;
+    const MapPoint origin((idxA % numClusters_.x) * CLUSTER_SIZE, (idxA / numClusters_.x) * CLUSTER_SIZE);
+    const MapPoint endPt(std::min<unsigned>(origin.x + CLUSTER_SIZE, world_.GetWidth()),
+                         std::min<unsigned>(origin.y + CLUSTER_SIZE, world_.GetHeight()));
+    for(MapPoint pt(origin.x, origin.y); pt.y < endPt.y; pt.y++)
+    {
+        for(pt.x = origin.x; pt.x < endPt.x; pt.x++)
+        {
+            for(const Direction dir : Direction())
+            {
+                const MapPoint nbPt = world_.GetNeighbour(pt, dir);
+                if(GetClusterIdx(nbPt) == idxB && condition.IsNodeOk(pt) && condition.IsNodeOk(nbPt) && condition.IsEdgeOk(pt, dir))
+                    candidates.push_back(Crossing{pt, dir});
+            }
+        }
+    }
+
+    // Use only the middle crossing of each run of adjacent crossings
+    std::vector<Crossing> crossingsA, crossingsB;
+    unsigned runStart = 0;
+    for(unsigned i = 1; i <= candidates.size(); i++)
+    {
+        if(i == candidates.size() || i - runStart >= MAX_CROSSINGS_PER_ENTRANCE
+           || world_.CalcDistance(candidates[i].pt, candidates[i - 1].pt) > 1)
+        {
+            const Crossing& crossing = candidates[(runStart + i - 1) / 2];
+            crossingsA.push_back(crossing);
+            crossingsB.push_back(Crossing{world_.GetNeighbour(crossing.pt, crossing.dir), crossing.dir + 3u});
+            runStart = i;
+        }
+    }
+    // A cluster can be a neighbour only once
+    const auto itNbA = std::find(clusterA.neighbours.begin(), clusterA.neighbours.end(), idxB);
+    const auto itNbB = std::find(clusterB.neighbours.begin(), clusterB.neighbours.end(), idxA);
+    RTTR_Assert(itNbA != clusterA.neighbours.end() && itNbB != clusterB.neighbours.end());
+    clusterA.crossings[itNbA - clusterA.neighbours.begin()] = std::move(crossingsA);
+    clusterB.crossings[itNbB - clusterB.neighbours.begin()] = std::move(crossingsB);
+}
+
+void HierarchicalPathFinder::UpdateEntrances(const unsigned clusterIdx)
+{
+    Cluster& cluster = clusters_[clusterIdx];
+    for(const Entrance& entrance : cluster.entrances)
+        entranceIdx_[world_.GetIdx(entrance.pt)] = NO_ENTRANCE;
+
+    std::vector<MapPoint> entrancePts;
+    for(const std::vector<Crossing>& crossings : cluster.crossings)
+    {
+        for(const Crossing& crossing : crossings)
+            entrancePts.push_back(crossing.pt);
+    }
+    std::sort(entrancePts.begin(), entrancePts.end(),
+              [this](const MapPoint& lhs, const MapPoint& rhs) { return world_.GetIdx(lhs) < world_.GetIdx(rhs); });
+    entrancePts.erase(std::unique(entrancePts.begin(), entrancePts.end()), entrancePts.end());
+    RTTR_Assert(entrancePts.size() < NO_ENTRANCE);
+
+    cluster.entrances.clear();
+    cluster.entrances.resize(entrancePts.size());
+    for(unsigned i = 0; i < entrancePts.size(); i++)
+    {
+        cluster.entrances[i].pt = entrancePts[i];
+        entranceIdx_[world_.GetIdx(entrancePts[i])] = static_cast<uint16_t>(i);
+    }
+    // Connections to other clusters
+    for(const std::vector<Crossing>& crossings : cluster.crossings)
+    {
+        for(const Crossing& crossing : crossings)
+        {
+            Entrance& entrance = cluster.entrances[entranceIdx_[world_.GetIdx(crossing.pt)]];
+            entrance.edges.push_back(Edge{world_.GetNeighbour(crossing.pt, crossing.dir), 1});
+        }
+    }
+    // Connections inside the cluster
+    for(Entrance& entrance : cluster.entrances)
+    {
+        SearchInCluster(entrance.pt, tmpSearch_);
+        for(const Entrance& otherEntrance : cluster.entrances)
+        {
+            const uint16_t dist = tmpSearch_.dist[GetLocalIdx(otherEntrance.pt)];
+            if(&otherEntrance != &entrance && dist != NOT_REACHED)
+                entrance.edges.push_back(Edge{otherEntrance.pt, dist});
+        }
+    }
+    numClusterUpdates_++;
+}
+
+void HierarchicalPathFinder::SearchInCluster(const MapPoint start, ClusterSearch& result) const
+{
+    const PathConditionHuman condition(world_);
+    const unsigned clusterIdx = GetClusterIdx(start);
+    result.dist.assign(CLUSTER_SIZE * CLUSTER_SIZE, NOT_REACHED);
+    result.dirFromPrev.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+    std::vector<MapPoint> todo;
+    todo.reserve(CLUSTER_SIZE * CLUSTER_SIZE);
+    todo.push_back(start);
+    result.dist[GetLocalIdx(start)] = 0;
+    // All steps have the same cost, so a breadth first search yields the shortest distances
+    for(unsigned i = 0; i < todo.size(); i++)
+    {
+        const MapPoint curPt = todo[i];
+        const uint16_t curDist = result.dist[GetLocalIdx(curPt)];
+        for(const Direction dir : Direction())
+        {
+            const MapPoint nbPt = world_.GetNeighbour(curPt, dir);
+            if(GetClusterIdx(nbPt) != clusterIdx)
+                continue;
+            uint16_t& nbDist = result.dist[GetLocalIdx(nbPt)];
+            if(nbDist != NOT_REACHED || !condition.IsNodeOk(nbPt) || !condition.IsEdgeOk(curPt, dir))
+                continue;
+            nbDist = curDist + 1;
+            result.dirFromPrev[GetLocalIdx(nbPt)] = dir;
+            todo.push_back(nbPt);
+        }
+    }
+}
+
+void HierarchicalPathFinder::AppendRouteFromStart(const ClusterSearch& search, const MapPoint start, MapPoint pt,
+                                                  std::vector<Direction>& route) const
+{
+    const size_t oldSize = route.size();
+    while(pt != start)
+    {
+        const Direction dir = search.dirFromPrev[GetLocalIdx(pt)];
+        route.push_back(dir);
+        pt = world_.GetNeighbour(pt, dir + 3u);
+    }
+    std::reverse(route.begin() + oldSize, route.end());
+}
+
+void HierarchicalPathFinder::AppendRouteToStart(const ClusterSearch& search, const MapPoint start, MapPoint pt,
+                                                std::vector<Direction>& route) const
+{
+    // The connections are symmetric, so we can walk the search tree backwards
+    while(pt != start)
+    {
+        const Direction dir = search.dirFromPrev[GetLocalIdx(pt)] + 3u;
+        route.push_back(dir);
+        pt = world_.GetNeighbour(pt, dir);
+    }
+}
+
+bool HierarchicalPathFinder::FindHumanPath(const MapPoint start, const MapPoint dest, const unsigned maxLength,
+                                           std::vector<Direction>* route, unsigned* length, Direction* firstDir)
+{
+    RTTR_Assert(start != dest);
+    std::lock_guard<std::mutex> lock(mutex_);
+    UpdateClusters();
+
+    const unsigned startClusterIdx = GetClusterIdx(start);
+    const unsigned destClusterIdx = GetClusterIdx(dest);
+    if(startClusterIdx == destClusterIdx)
+        return false;
+    SearchInCluster(start, startSearch_);
+    SearchInCluster(dest, destSearch_);
+
+    /// Node of the abstract graph. Key is the node index or GOAL_IDX
+    struct SearchNode
+    {
+        MapPoint pt;
+        unsigned dist;
+        unsigned prevIdx;
+        bool closed;
+    };
+    struct OpenEntry
+    {
+        unsigned estimate;
+        /// Insertion counter to make the order strict
+        unsigned seq;
+        unsigned nodeIdx;
+        bool operator>(const OpenEntry& rhs) const { return estimate > rhs.estimate || (estimate == rhs.estimate && seq > rhs.seq); }
+    };
+    constexpr unsigned START_IDX = std::numeric_limits<unsigned>::max();
+    constexpr unsigned GOAL_IDX = std::numeric_limits<unsigned>::max() - 1;
+
+    std::unordered_map<unsigned, SearchNode> nodes;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> todo;
+    unsigned seq = 0;
+    const auto addNode = [&](const MapPoint pt, const unsigned nodeIdx, const unsigned dist, const unsigned prevIdx) {
+        const unsigned estimate = dist + ((nodeIdx == GOAL_IDX) ? 0 : world_.CalcDistance(pt, dest));
+        if(estimate > maxLength)
+            return;
+        const auto itNode = nodes.find(nodeIdx);
+        if(itNode == nodes.end())
+            nodes.emplace(nodeIdx, SearchNode{pt, dist, prevIdx, false});
+        else if(itNode->second.closed || itNode->second.dist <= dist)
+            return;
+        else
+        {
+            itNode->second.dist = dist;
+            itNode->second.prevIdx = prevIdx;
+        }
+        todo.push(OpenEntry{estimate, seq++, nodeIdx});
+    };
+
+    for(const Entrance& entrance : clusters_[startClusterIdx].entrances)
+    {
+        const uint16_t dist = startSearch_.dist[GetLocalIdx(entrance.pt)];
+        if(dist != NOT_REACHED)
+            addNode(entrance.pt, world_.GetIdx(entrance.pt), dist, START_IDX);
+    }
+
+    while(!todo.empty())
+    {
+        const OpenEntry entry = todo.top();
+        todo.pop();
+        SearchNode& node = nodes[entry.nodeIdx];
+        if(node.closed)
+            continue;
+        node.closed = true;
+        if(entry.nodeIdx == GOAL_IDX)
+            break;
+        const unsigned clusterIdx = GetClusterIdx(node.pt);
+        const Entrance& entrance = clusters_[clusterIdx].entrances[entranceIdx_[entry.nodeIdx]];
+        const unsigned curDist = node.dist;
+        for(const Edge& edge : entrance.edges)
+            addNode(edge.target, world_.GetIdx(edge.target), curDist + edge.cost, entry.nodeIdx);
+        if(clusterIdx == destClusterIdx)
+        {
+            const uint16_t distToDest = destSearch_.dist[GetLocalIdx(node.pt)];
+            if(distToDest != NOT_REACHED)
+                addNode(dest, GOAL_IDX, curDist + distToDest, entry.nodeIdx);
+        }
+    }
+
+    const auto itGoal = nodes.find(GOAL_IDX);
+    if(itGoal == nodes.end() || !itGoal->second.closed)
+        return false;
+
+    if(length)
+        *length = itGoal->second.dist;
+    if(!route && !firstDir)
+        return true;
+
+    // Entrances used from start to goal
+    std::vector<MapPoint> entrancePts;
+    for(unsigned curIdx = itGoal->second.prevIdx; curIdx != START_IDX; curIdx = nodes[curIdx].prevIdx)
+        entrancePts.push_back(nodes[curIdx].pt);
+    std::reverse(entrancePts.begin(), entrancePts.end());
+
+    // Refine the path. If only the first direction is required we can stop as soon as the route is not empty
+    std::vector<Direction> tmpRoute;
+    std::vector<Direction>& curRoute = route ? *route : tmpRoute;
+    curRoute.clear();
+    AppendRouteFromStart(startSearch_, start, entrancePts.front(), curRoute);
+    for(unsigned i = 1; i < entrancePts.size() && (route || curRoute.empty()); i++)
+    {
+        const MapPoint fromPt = entrancePts[i - 1];
+        const MapPoint toPt = entrancePts[i];
+        if(GetClusterIdx(fromPt) == GetClusterIdx(toPt))
+        {
+            SearchInCluster(fromPt, tmpSearch_);
+            AppendRouteFromStart(tmpSearch_, fromPt, toPt, curRoute);
+        } else
+        {
+            for(const Direction dir : Direction())
+            {
+                if(world_.GetNeighbour(fromPt, dir) == toPt)
+                {
+                    curRoute.push_back(dir);
+                    break;
+                }
+            }
+        }
+    }
+    if(route || curRoute.empty())
+        AppendRouteToStart(destSearch_, dest, entrancePts.back(), curRoute);
+    RTTR_Assert(!route || route->size() == itGoal->second.dist);
+    if(firstDir)
+        *firstDir = curRoute.front();
+    return true;
+}
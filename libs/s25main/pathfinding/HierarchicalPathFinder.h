@@ -0,0 +1,130 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HierarchicalPathFinder_h__
+#define HierarchicalPathFinder_h__
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class World;
+
+/// Cluster based abstraction of the map for finding long distance paths of humans (HPA*).
+/// The map is split into clusters of CLUSTER_SIZE x CLUSTER_SIZE nodes. Nodes where humans can cross the border between 2 clusters are
+/// entrances which are connected by the distances between them inside a cluster. A path is then searched over the entrances and only
+/// refined inside the clusters where required.
+/// Clusters are marked dirty when objects or roads change and recalculated on the next search.
+/// Note: Found paths are not always the shortest ones and differ from the FreePathFinder.
+///       Hence this must only be used when all players agree on it (AddonId::HIERARCHICAL_PATHFINDING)
+class HierarchicalPathFinder
+{
+public:
+    /// Width and height of a cluster in nodes
+    static constexpr unsigned CLUSTER_SIZE = 16;
+    /// Paths with a smaller air distance are not worth using the abstraction
+    static constexpr unsigned MIN_DISTANCE = 2 * CLUSTER_SIZE;
+
+    explicit HierarchicalPathFinder(const World& world);
+
+    void Init(const MapExtent& mapSize);
+    /// Notify that the walkability of the node (object, roads) may have changed. Must not be called while searches are running
+    void NodeChanged(MapPoint pt);
+
+    /// Find a path for humans (see PathConditionHuman) from start to dest with at most maxLength steps.
+    /// Returns false if no path was found over the abstraction. There might still be a path in rare cases (e.g. through an entrance
+    /// which is not used by the abstraction) so callers should fall back to the exact search
+    bool FindHumanPath(MapPoint start, MapPoint dest, unsigned maxLength, std::vector<Direction>* route, unsigned* length,
+                       Direction* firstDir);
+
+    /// Return the number of clusters (re-)calculated so far
+    unsigned GetNumClusterUpdates() const { return numClusterUpdates_; }
+
+private:
+    /// Transition from a node of a cluster in a direction to a node of another cluster
+    struct Crossing
+    {
+        MapPoint pt;
+        Direction dir;
+    };
+    /// Connection from an entrance to another entrance
+    struct Edge
+    {
+        MapPoint target;
+        unsigned cost;
+    };
+    struct Entrance
+    {
+        MapPoint pt;
+        std::vector<Edge> edges;
+    };
+    struct Cluster
+    {
+        /// Indices of the surrounding clusters
+        std::vector<unsigned> neighbours;
+        /// Crossings from this cluster to the neighbour with the same index
+        std::vector<std::vector<Crossing>> crossings;
+        /// Entrances sorted by their node index
+        std::vector<Entrance> entrances;
+        bool isDirty = true;
+    };
+    /// Result of a breadth first search inside a cluster
+    struct ClusterSearch
+    {
+        /// Distance from the start per node (local index) or NOT_REACHED
+        std::vector<uint16_t> dist;
+        /// Direction used to reach the node from its predecessor
+        std::vector<Direction> dirFromPrev;
+    };
+    static constexpr uint16_t NOT_REACHED = 0xFFFF;
+    static constexpr uint16_t NO_ENTRANCE = 0xFFFF;
+    /// Maximum number of adjacent crossings that are represented by a single entrance
+    static constexpr unsigned MAX_CROSSINGS_PER_ENTRANCE = 8;
+
+    const World& world_;
+    /// Searches update the dirty clusters and reuse the search buffers, so only one may run at a time (AIs search concurrently)
+    std::mutex mutex_;
+    /// Number of clusters in each direction
+    Extent numClusters_;
+    std::vector<Cluster> clusters_;
+    std::vector<unsigned> dirtyClusters_;
+    /// Index of the entrance in the cluster of the node or NO_ENTRANCE
+    std::vector<uint16_t> entranceIdx_;
+    unsigned numClusterUpdates_;
+    /// Searches reused to avoid allocations
+    ClusterSearch startSearch_, destSearch_, tmpSearch_;
+
+    unsigned GetClusterIdx(MapPoint pt) const;
+    /// Index of the point inside its cluster
+    static unsigned GetLocalIdx(MapPoint pt);
+    /// Recalculate the dirty clusters and their neighbours
+    void UpdateClusters();
+    /// Calculate the crossings between the cluster and its neighbour with the given index
+    void UpdateCrossings(unsigned clusterIdx, unsigned neighbourIdx);
+    /// Calculate the entrances and their connections from the crossings of the cluster
+    void UpdateEntrances(unsigned clusterIdx);
+    /// Breadth first search from the start point to all reachable points of its cluster
+    void SearchInCluster(MapPoint start, ClusterSearch& result) const;
+    /// Append the route from the start of the search to the given point
+    void AppendRouteFromStart(const ClusterSearch& search, MapPoint start, MapPoint pt, std::vector<Direction>& route) const;
+    /// Append the route from the given point to the start of the search
+    void AppendRouteToStart(const ClusterSearch& search, MapPoint start, MapPoint pt, std::vector<Direction>& route) const;
+};
+
+#endif // HierarchicalPathFinder_h__
@@ -21,6 +21,7 @@
 #include "pathfinding/OpenListBinaryHeap.h"
 #include "pathfinding/PathfindingPoint.h"
 #include <set>
+#include <vector>
 
 /// Konstante für einen ungültigen Vorgängerknoten
 const unsigned INVALID_PREV = 0xFFFFFFFF;
@@ -67,4 +68,16 @@ struct FreePathNode
     MapPoint mapPt;
     OpenListBinaryHeapBase<FreePathNode>::PosMarker posMarker;
 };
+
+/// Nodes used by a run of the free pathfinding.
+/// Searches running at the same time (nested or in different threads) must use different workspaces
+struct FreePathWorkspace
+{
+    /// Nodes for FindPathAlternatingConditions. Empty until first used
+    std::vector<NewNode> nodes;
+    /// Nodes for FindPath. Empty until first used
+    std::vector<FreePathNode> fpNodes;
+    /// Value of lastVisited for nodes visited in the current run
+    unsigned currentVisit = 0;
+};
 #endif // NewNode_h__
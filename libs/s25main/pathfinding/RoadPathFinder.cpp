@@ -25,6 +25,9 @@
 #include "nodeObjs/noRoadNode.h"
 #include "gameData/GameConsts.h"
 #include "s25util/Log.h"
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <queue>
 
 /// Comparison operator for road nodes that returns true if lhs > rhs (descending order)
 struct RoadNodeComperatorGreater
@@ -110,6 +113,24 @@ struct And : private T_Func1, private T_Func2
 };
 } // namespace SegmentConstraints
 
+void RoadPathFinder::IncreaseCurrentVisit()
+{
+    // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
+    currentVisit++;
+
+    // if the counter reaches its maximum, tidy up
+    if(currentVisit == std::numeric_limits<unsigned>::max())
+    {
+        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
+        {
+            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
+            if(node)
+                node->last_visit = 0;
+        }
+        currentVisit = 1;
+    }
+}
+
 /// Wegfinden ( A* ), O(v lg v) --> Wegfindung auf Stra�en
 template<class T_AdditionalCosts, class T_SegmentConstraints>
 bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goal, const unsigned max, const T_AdditionalCosts addCosts,
@@ -132,20 +153,7 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         return true;
     }
 
-    // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
-    currentVisit++;
-
-    // if the counter reaches its maximum, tidy up
-    if(currentVisit == std::numeric_limits<unsigned>::max())
-    {
-        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
-        {
-            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
-            if(node)
-                node->last_visit = 0;
-        }
-        currentVisit = 1;
-    }
+    IncreaseCurrentVisit();
 
     // Anfangsknoten einf�gen
     todo.clear();
@@ -304,6 +312,7 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
                               MapPoint* const firstNodePos)
 {
     RTTR_Assert(length || firstDir || firstNodePos); // If none of them is set use the \ref PathExist function!
+    std::lock_guard<std::mutex> lock(mutex_);
 
     if(wareMode)
     {
@@ -311,7 +320,7 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
             return FindPathImpl(start, goal, max, AdditonalCosts::Carrier(), SegmentConstraints::AvoidSegment(forbidden), length, firstDir,
                                 firstNodePos);
         else
-            return FindPathImpl(start, goal, max, AdditonalCosts::Carrier(), SegmentConstraints::None(), length, firstDir, firstNodePos);
+            return FindWarePath(start, goal, max, length, firstDir, firstNodePos);
     } else
     {
         if(forbidden)
@@ -328,6 +337,7 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
 bool RoadPathFinder::PathExists(const noRoadNode& start, const noRoadNode& goal, const bool allowWaterRoads, const unsigned max,
                                 const RoadSegment* const forbidden)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     if(allowWaterRoads)
     {
         if(forbidden)
@@ -345,3 +355,342 @@ bool RoadPathFinder::PathExists(const noRoadNode& start, const noRoadNode& goal,
             return FindPathImpl(start, goal, max, AdditonalCosts::None(), SegmentConstraints::AvoidRoadType<RoadSegment::RT_BOAT>());
     }
 }
+
+/// Dijkstra from start until the cheapest goal is known.
+/// For the paths from the goals to start (toGoals == false) the roads are followed backwards and the restrictions
+/// and additional costs are applied as if the path started at the other end of each road
+template<class T_AdditionalCosts, class T_SegmentConstraints>
+bool RoadPathFinder::FindNearestGoalImpl(const noRoadNode& start, const SortedGoals& goals, const bool toGoals,
+                                         const T_AdditionalCosts addCosts, const T_SegmentConstraints isSegmentAllowed,
+                                         unsigned* const goalIdx, unsigned* const length)
+{
+    const auto findGoal = [&goals](const noRoadNode* node) {
+        const auto it = std::lower_bound(goals.begin(), goals.end(), std::make_pair(node, 0u));
+        return (it != goals.end() && it->first == node) ? it : goals.end();
+    };
+
+    IncreaseCurrentVisit();
+    todo.clear();
+
+    start.estimate = 0;
+    start.last_visit = currentVisit;
+    start.prev = nullptr;
+    start.cost = 0;
+    start.dir_ = 0;
+
+    todo.push(&start);
+
+    bool found = false;
+    unsigned bestCost = 0, bestIdx = 0;
+    while(!todo.empty())
+    {
+        const noRoadNode& best = *todo.pop();
+
+        // All nodes with the costs of the cheapest goal were checked so no other goal can be better
+        if(found && best.cost > bestCost)
+            break;
+
+        const auto itGoal = findGoal(&best);
+        if(itGoal != goals.end())
+        {
+            // Same costs -> Prefer the one listed first
+            if(!found || itGoal->second < bestIdx)
+                bestIdx = itGoal->second;
+            bestCost = best.cost;
+            found = true;
+            continue;
+        }
+
+        // Paths leading into a building must end there, so don't go on from one (backwards) unless it is the start
+        const GO_Type bestGOT = best.GetGOT();
+        const bool isEnterableNode = &best == &start || bestGOT == GOT_FLAG || bestGOT == GOT_NOB_HARBORBUILDING;
+
+        for(unsigned iDir = 0; iDir < 6; ++iDir)
+        {
+            const Direction dir = Direction::fromInt(iDir);
+            noRoadNode* neighbour = best.GetNeighbour(dir);
+
+            if(!neighbour || neighbour == best.prev)
+                continue;
+
+            const RoadSegment& route = *best.GetRoute(dir);
+            unsigned cost = best.cost + route.GetLength();
+            if(toGoals)
+            {
+                // No pathes over buildings
+                if(dir == Direction::NORTHWEST && findGoal(neighbour) == goals.end())
+                {
+                    // Flags and harbors are allowed
+                    const GO_Type got = neighbour->GetGOT();
+                    if(got != GOT_FLAG && got != GOT_NOB_HARBORBUILDING)
+                        continue;
+                }
+                cost += addCosts(best, dir);
+            } else
+            {
+                // Direction of this road when starting at the neighbour
+                const Direction neighbourDir = route.GetDir(route.GetF1() == &best, 0);
+                if(neighbourDir == Direction::NORTHWEST && !isEnterableNode)
+                    continue;
+                cost += addCosts(*neighbour, neighbourDir);
+            }
+
+            if(!isSegmentAllowed(route))
+                continue;
+
+            if(neighbour->last_visit == currentVisit)
+            {
+                if(cost < neighbour->cost)
+                {
+                    neighbour->cost = cost;
+                    neighbour->prev = &best;
+                    neighbour->estimate = cost;
+                    neighbour->dir_ = iDir;
+                }
+            } else
+            {
+                neighbour->last_visit = currentVisit;
+                neighbour->cost = cost;
+                neighbour->dir_ = iDir;
+                neighbour->prev = &best;
+                neighbour->estimate = cost;
+                todo.push(neighbour);
+            }
+        }
+
+        if(bestGOT == GOT_NOB_HARBORBUILDING)
+        {
+            const auto& harbor = static_cast<const nobHarborBuilding&>(best);
+            for(const nobHarborBuilding::ShipConnection& sc : harbor.GetShipConnections())
+            {
+                // Harbors at the same sea are connected both ways, but use the costs of the ship leaving at the other harbor
+                unsigned cost = best.cost;
+                if(toGoals)
+                    cost += sc.way_costs;
+                else
+                {
+                    const auto& destHarbor = static_cast<const nobHarborBuilding&>(*sc.dest);
+                    // Unless the other harbor is being destroyed: It has no connections anymore
+                    if(destHarbor.IsBeingDestroyedNow())
+                        continue;
+                    cost += 2 * gwb_.CalcHarborDistance(destHarbor.GetHarborPosID(), harbor.GetHarborPosID()) + 10;
+                }
+
+                noRoadNode& dest = *sc.dest;
+                if(dest.last_visit == currentVisit)
+                {
+                    if(cost < dest.cost)
+                    {
+                        dest.dir_ = SHIP_DIR;
+                        dest.cost = cost;
+                        dest.prev = &best;
+                        dest.estimate = cost;
+                    }
+                } else
+                {
+                    dest.last_visit = currentVisit;
+                    dest.dir_ = SHIP_DIR;
+                    dest.prev = &best;
+                    dest.cost = cost;
+                    dest.estimate = cost;
+                    todo.push(&dest);
+                }
+            }
+        }
+    }
+
+    if(!found)
+        return false;
+    *goalIdx = bestIdx;
+    if(length)
+        *length = bestCost;
+    return true;
+}
+
+bool RoadPathFinder::FindNearestGoal(const noRoadNode& start, const std::vector<const noRoadNode*>& goals, const bool toGoals,
+                                     const bool wareMode, const RoadSegment* const forbidden, unsigned* const goalIdx,
+                                     unsigned* const length)
+{
+    RTTR_Assert(goalIdx);
+    SortedGoals sortedGoals;
+    sortedGoals.reserve(goals.size());
+    for(unsigned i = 0; i < goals.size(); i++)
+        sortedGoals.emplace_back(goals[i], i);
+    std::sort(sortedGoals.begin(), sortedGoals.end());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(wareMode)
+    {
+        if(forbidden)
+            return FindNearestGoalImpl(start, sortedGoals, toGoals, AdditonalCosts::Carrier(), SegmentConstraints::AvoidSegment(forbidden),
+                                       goalIdx, length);
+        else
+            return FindNearestGoalImpl(start, sortedGoals, toGoals, AdditonalCosts::Carrier(), SegmentConstraints::None(), goalIdx,
+                                       length);
+    } else
+    {
+        if(forbidden)
+            return FindNearestGoalImpl(
+              start, sortedGoals, toGoals, AdditonalCosts::None(),
+              SegmentConstraints::And<SegmentConstraints::AvoidSegment, SegmentConstraints::AvoidRoadType<RoadSegment::RT_BOAT>>(forbidden),
+              goalIdx, length);
+        else
+            return FindNearestGoalImpl(start, sortedGoals, toGoals, AdditonalCosts::None(),
+                                       SegmentConstraints::AvoidRoadType<RoadSegment::RT_BOAT>(), goalIdx, length);
+    }
+}
+
+size_t RoadPathFinder::WarePathKeyHasher::operator()(const WarePathKey& key) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, key.startId);
+    boost::hash_combine(seed, key.goalId);
+    boost::hash_combine(seed, key.max);
+    return seed;
+}
+
+bool RoadPathFinder::FindWarePath(const noRoadNode& start, const noRoadNode& goal, const unsigned max, unsigned* const length,
+                                  unsigned char* const firstDir, MapPoint* const firstNodePos)
+{
+    // Invalid request, let the search handle it
+    if(&start == &goal)
+        return FindPathImpl(start, goal, max, AdditonalCosts::Carrier(), SegmentConstraints::None(), length, firstDir, firstNodePos);
+
+    const unsigned player = start.GetPlayer();
+    if(player >= warePathCaches_.size())
+        warePathCaches_.resize(player + 1);
+    WarePathCache& cache = warePathCaches_[player];
+    // The search is deterministic, so as long as nothing changed it yields the same result for the same parameters
+    const WarePathKey key{start.GetObjId(), goal.GetObjId(), max};
+    auto itPath = cache.find(key);
+    if(itPath != cache.end())
+        numWarePathCacheHits_++;
+    else
+    {
+        if(cache.size() >= MAX_CACHED_WARE_PATHS)
+            cache.clear();
+        WarePath path;
+        path.found = FindPathImpl(start, goal, max, AdditonalCosts::Carrier(), SegmentConstraints::None(), &path.length, &path.firstDir,
+                                  &path.firstNodePos);
+        itPath = cache.emplace(key, path).first;
+    }
+
+    const WarePath& path = itPath->second;
+    if(!path.found)
+        return false;
+    if(length)
+        *length = path.length;
+    if(firstDir)
+        *firstDir = path.firstDir;
+    if(firstNodePos)
+        *firstNodePos = path.firstNodePos;
+    return true;
+}
+
+void RoadPathFinder::CalcWarePathLengths(const noRoadNode& start, const unsigned max)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const unsigned player = start.GetPlayer();
+    if(player >= warePathLengthsCaches_.size())
+        warePathLengthsCaches_.resize(player + 1);
+    WarePathLengthsCache& cache = warePathLengthsCaches_[player];
+    auto itLengths = cache.find(start.GetObjId());
+    if(itLengths != cache.end())
+    {
+        if(itLengths->second.max >= max)
+            return;
+    } else
+    {
+        if(cache.size() >= MAX_CACHED_WARE_PATH_LENGTHS)
+            cache.clear();
+        itLengths = cache.emplace(start.GetObjId(), WarePathLengths()).first;
+    }
+    WarePathLengths& result = itLengths->second;
+    result.max = max;
+    result.lengths.clear();
+
+    // Dijkstra with the same costs as the ware paths in FindPathImpl.
+    // Whole road networks are searched, so use a heap instead of the open list and skip outdated entries instead of rearranging
+    using CostAndNode = std::pair<unsigned, const noRoadNode*>;
+    const auto compareCosts = [](const CostAndNode& lhs, const CostAndNode& rhs) { return lhs.first > rhs.first; };
+    std::priority_queue<CostAndNode, std::vector<CostAndNode>, decltype(compareCosts)> open(compareCosts);
+
+    IncreaseCurrentVisit();
+    start.last_visit = currentVisit;
+    start.prev = nullptr;
+    start.cost = 0;
+    open.emplace(0, &start);
+
+    const auto addToOpen = [this, &open, max](const noRoadNode& prev, noRoadNode& node, const unsigned cost) {
+        if(cost > max || (node.last_visit == currentVisit && cost >= node.cost))
+            return;
+        node.last_visit = currentVisit;
+        node.cost = cost;
+        node.prev = &prev;
+        open.emplace(cost, &node);
+    };
+
+    const AdditonalCosts::Carrier addCosts;
+    while(!open.empty())
+    {
+        const CostAndNode cur = open.top();
+        open.pop();
+        const noRoadNode& best = *cur.second;
+        // Found a shorter path to it after this entry was added
+        if(cur.first != best.cost)
+            continue;
+        result.lengths[best.GetObjId()] = best.cost;
+
+        // Buildings can only be the goal of a path (No pathes over buildings)
+        const GO_Type got = best.GetGOT();
+        if(&best != &start && got != GOT_FLAG && got != GOT_NOB_HARBORBUILDING)
+            continue;
+
+        for(unsigned iDir = 0; iDir < 6; ++iDir)
+        {
+            const Direction dir = Direction::fromInt(iDir);
+            noRoadNode* neighbour = best.GetNeighbour(dir);
+            if(neighbour && neighbour != best.prev)
+                addToOpen(best, *neighbour, best.cost + best.GetRoute(dir)->GetLength() + addCosts(best, dir));
+        }
+
+        if(got == GOT_NOB_HARBORBUILDING)
+        {
+            for(const nobHarborBuilding::ShipConnection& sc : static_cast<const nobHarborBuilding&>(best).GetShipConnections())
+                addToOpen(best, *sc.dest, best.cost + sc.way_costs);
+        }
+    }
+}
+
+bool RoadPathFinder::GetWarePathLength(const noRoadNode& start, const noRoadNode& goal, const unsigned max, unsigned* const length)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const unsigned player = start.GetPlayer();
+        if(&start != &goal && player < warePathLengthsCaches_.size())
+        {
+            const WarePathLengthsCache& cache = warePathLengthsCaches_[player];
+            const auto itLengths = cache.find(start.GetObjId());
+            if(itLengths != cache.end() && itLengths->second.max >= max)
+            {
+                numWarePathSearchesSaved_++;
+                const auto itLength = itLengths->second.lengths.find(goal.GetObjId());
+                if(itLength == itLengths->second.lengths.end() || itLength->second > max)
+                    return false;
+                if(length)
+                    *length = itLength->second;
+                return true;
+            }
+        }
+    }
+    return FindPath(start, goal, true, max, nullptr, length);
+}
+
+void RoadPathFinder::InvalidateWarePaths(const unsigned player)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(player < warePathCaches_.size())
+        warePathCaches_[player].clear();
+    if(player < warePathLengthsCaches_.size())
+        warePathLengthsCaches_[player].clear();
+}
@@ -20,6 +20,10 @@
 
 #include "gameTypes/MapCoordinates.h"
 #include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class GameWorldBase;
 class noRoadNode;
@@ -27,11 +31,51 @@ class RoadSegment;
 
 class RoadPathFinder
 {
+    /// Result of a path search for a ware
+    struct WarePath
+    {
+        bool found;
+        unsigned length;
+        unsigned char firstDir;
+        MapPoint firstNodePos;
+    };
+    /// Object ids of start and goal and the maximum costs of a path search for a ware
+    struct WarePathKey
+    {
+        unsigned startId, goalId, max;
+        bool operator==(const WarePathKey& rhs) const { return startId == rhs.startId && goalId == rhs.goalId && max == rhs.max; }
+    };
+    struct WarePathKeyHasher
+    {
+        size_t operator()(const WarePathKey& key) const;
+    };
+    using WarePathCache = std::unordered_map<WarePathKey, WarePath, WarePathKeyHasher>;
+    /// Maximum number of paths cached per player. The cache is cleared when reached
+    static constexpr unsigned MAX_CACHED_WARE_PATHS = 4096;
+    /// Costs of the ware paths from one start node to all nodes (by object id) that can be reached with costs <= max
+    struct WarePathLengths
+    {
+        unsigned max;
+        std::unordered_map<unsigned, unsigned> lengths;
+    };
+    /// Path lengths by the object id of the start node
+    using WarePathLengthsCache = std::unordered_map<unsigned, WarePathLengths>;
+    /// Maximum number of start nodes with path lengths cached per player
+    static constexpr unsigned MAX_CACHED_WARE_PATH_LENGTHS = 64;
+
     GameWorldBase& gwb_;
+    /// Searches store their state in the road nodes, so only one may run at a time (AIs search concurrently)
+    std::mutex mutex_;
     unsigned currentVisit;
+    /// Results of the ware path searches per player since the last change of the road network or ware costs of that player
+    std::vector<WarePathCache> warePathCaches_;
+    /// Path lengths from CalcWarePathLengths per player, invalidated together with the ware paths
+    std::vector<WarePathLengthsCache> warePathLengthsCaches_;
+    unsigned numWarePathCacheHits_;
+    unsigned numWarePathSearchesSaved_;
 
 public:
-    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0) {}
+    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), numWarePathCacheHits_(0), numWarePathSearchesSaved_(0) {}
 
     /// Calculates the best path from start to goal
     /// Outputs are only valid if true is returned!
@@ -56,11 +100,51 @@ public:
     bool PathExists(const noRoadNode& start, const noRoadNode& goal, bool allowWaterRoads,
                     unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr);
 
+    /// Finds the goal with the cheapest path in a single search expanding from start.
+    /// Equal costs are resolved in favor of the goal listed first, so the result is the same as
+    /// searching the path to each goal separately (FindPath) and taking the first cheapest one
+    ///
+    /// @param toGoals True to use the paths from start to the goals, false for the paths from the goals to start
+    /// @param wareMode Same as for FindPath
+    /// @param forbidden RoadSegment that will be ignored
+    /// @param goalIdx Receives the index of the goal found
+    /// @param length If != nullptr will receive the costs of the path to/from that goal
+    bool FindNearestGoal(const noRoadNode& start, const std::vector<const noRoadNode*>& goals, bool toGoals, bool wareMode,
+                         const RoadSegment* forbidden, unsigned* goalIdx, unsigned* length = nullptr);
+
+    /// Calculates the costs of the ware paths from start to all nodes that can be reached with costs of at most max in one search.
+    /// Use this before asking for the path lengths from the same start to many goals with GetWarePathLength
+    void CalcWarePathLengths(const noRoadNode& start, unsigned max);
+    /// Gets the costs of the path a ware would take from start to goal, same as FindPath(start, goal, true, max, nullptr, length).
+    /// Answered without a search if the lengths from start were calculated up to at least max and did not change since then
+    bool GetWarePathLength(const noRoadNode& start, const noRoadNode& goal, unsigned max, unsigned* length);
+
+    /// Notify that roads, carriers or wares waiting at flags of the player changed.
+    /// Discards the cached ware paths of that player as the path costs might have changed
+    void InvalidateWarePaths(unsigned player);
+    /// Return the number of ware path searches answered from the cache
+    unsigned GetNumWarePathCacheHits() const { return numWarePathCacheHits_; }
+    /// Return the number of ware path searches avoided by using the lengths from CalcWarePathLengths
+    unsigned GetNumWarePathSearchesSaved() const { return numWarePathSearchesSaved_; }
+
 private:
+    /// Find the path for a ware using the cached result if the road network of the player did not change since the last search
+    bool FindWarePath(const noRoadNode& start, const noRoadNode& goal, unsigned max, unsigned* length, unsigned char* firstDir,
+                      MapPoint* firstNodePos);
+
+    /// Start a new search invalidating the search state stored in the nodes
+    void IncreaseCurrentVisit();
+
     template<class T_AdditionalCosts, class T_SegmentConstraints>
     bool FindPathImpl(const noRoadNode& start, const noRoadNode& goal, unsigned max, T_AdditionalCosts addCosts,
                       T_SegmentConstraints isSegmentAllowed, unsigned* length = nullptr, unsigned char* firstDir = nullptr,
                       MapPoint* firstNodePos = nullptr);
+
+    /// Goals with their index in the list passed to FindNearestGoal sorted by the node address
+    using SortedGoals = std::vector<std::pair<const noRoadNode*, unsigned>>;
+    template<class T_AdditionalCosts, class T_SegmentConstraints>
+    bool FindNearestGoalImpl(const noRoadNode& start, const SortedGoals& goals, bool toGoals, T_AdditionalCosts addCosts,
+                             T_SegmentConstraints isSegmentAllowed, unsigned* goalIdx, unsigned* length);
 };
 
 #endif // RoadPathFinder_h__
@@ -0,0 +1,133 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "pathfinding/ShipDistanceFields.h"
+#include "pathfinding/PathConditionShip.h"
+#include "world/World.h"
+#include <set>
+
+constexpr size_t ShipDistanceFields::DEFAULT_MEMORY_BUDGET;
+constexpr unsigned ShipDistanceFields::MAX_LENGTH;
+constexpr uint16_t ShipDistanceFields::NOT_REACHED;
+
+ShipDistanceFields::ShipDistanceFields(const World& world) : world_(world), memoryBudget_(DEFAULT_MEMORY_BUDGET), state_(State::Unchecked)
+{}
+
+void ShipDistanceFields::Init(size_t memoryBudget)
+{
+    memoryBudget_ = memoryBudget;
+    state_ = State::Unchecked;
+    fields_.clear();
+}
+
+bool ShipDistanceFields::IsUsable()
+{
+    if(state_ == State::Unchecked)
+    {
+        // Decide for all fields at once so the result does not depend on the order of the searches
+        std::set<unsigned> coastalPts;
+        for(unsigned harborId = 1; harborId <= world_.GetNumHarborPoints(); harborId++)
+        {
+            for(unsigned dir = 0; dir < Direction::COUNT; dir++)
+            {
+                const unsigned short seaId = world_.GetSeaId(harborId, Direction::fromInt(dir));
+                if(seaId)
+                    coastalPts.insert(world_.GetIdx(world_.GetCoastalPoint(harborId, seaId)));
+            }
+        }
+        const size_t fieldSize = static_cast<size_t>(world_.GetWidth()) * world_.GetHeight() * sizeof(Field::value_type);
+        state_ = (coastalPts.size() * fieldSize <= memoryBudget_) ? State::Usable : State::TooLarge;
+    }
+    return state_ == State::Usable;
+}
+
+bool ShipDistanceFields::FindPath(const MapPoint start, const MapPoint dest, unsigned maxLength, unsigned firstDir,
+                                  std::vector<Direction>* route, unsigned* length)
+{
+    RTTR_Assert(start != dest);
+    RTTR_Assert(maxLength < MAX_LENGTH);
+    RTTR_Assert(IsUsable());
+
+    const Field& field = GetField(dest);
+    const unsigned distance = field[world_.GetIdx(start)];
+    if(distance > maxLength)
+        return false;
+    if(length)
+        *length = distance;
+    if(!route)
+        return true;
+
+    route->resize(distance);
+    const PathConditionShip condition(world_);
+    MapPoint curPt = start;
+    for(unsigned i = 0; i < distance; i++)
+    {
+        // Take the first neighbour which is one step closer to the goal and could have been used by the search
+        const unsigned nextDistance = distance - i - 1;
+        bool found = false;
+        for(unsigned z = firstDir; z < firstDir + Direction::COUNT && !found; z++)
+        {
+            const Direction dir(z);
+            const MapPoint nb = world_.GetNeighbour(curPt, dir);
+            if(field[world_.GetIdx(nb)] != nextDistance || (nb != dest && !condition.IsNodeOk(nb)) || !condition.IsEdgeOk(curPt, dir))
+                continue;
+            (*route)[i] = dir;
+            curPt = nb;
+            found = true;
+        }
+        RTTR_Assert(found);
+    }
+    RTTR_Assert(curPt == dest);
+    return true;
+}
+
+const ShipDistanceFields::Field& ShipDistanceFields::GetField(const MapPoint dest)
+{
+    Field& field = fields_[world_.GetIdx(dest)];
+    if(field.empty())
+        CalcField(dest, field);
+    return field;
+}
+
+void ShipDistanceFields::CalcField(const MapPoint dest, Field& field) const
+{
+    field.assign(static_cast<size_t>(world_.GetWidth()) * world_.GetHeight(), NOT_REACHED);
+    const PathConditionShip condition(world_);
+    std::vector<MapPoint> todo;
+    field[world_.GetIdx(dest)] = 0;
+    todo.push_back(dest);
+    // Edges can be used in both directions, so the distances from the goal are the ones to the goal.
+    // Nodes which are not usable by ships (e.g. the start on the coast) get a distance but are not passed
+    for(unsigned i = 0; i < todo.size(); i++)
+    {
+        const MapPoint curPt = todo[i];
+        const unsigned nextDistance = field[world_.GetIdx(curPt)] + 1u;
+        if(nextDistance >= MAX_LENGTH)
+            continue;
+        for(unsigned z = 0; z < Direction::COUNT; z++)
+        {
+            const Direction dir = Direction::fromInt(z);
+            const MapPoint nb = world_.GetNeighbour(curPt, dir);
+            uint16_t& nbDistance = field[world_.GetIdx(nb)];
+            if(nbDistance != NOT_REACHED || !condition.IsEdgeOk(curPt, dir))
+                continue;
+            nbDistance = static_cast<uint16_t>(nextDistance);
+            if(condition.IsNodeOk(nb))
+                todo.push_back(nb);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#ifndef ShipDistanceFields_h__
+#define ShipDistanceFields_h__
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class World;
+
+/// Distances of all nodes to the coastal points of the harbors for ships (see PathConditionShip).
+/// Seas and harbors do not change after loading the map, so a field is calculated once per coastal point on first use and a path to
+/// it is found by walking downhill from the start. The fields are only used when all of them fit into the memory budget, otherwise
+/// searches have to be done by the FreePathFinder.
+class ShipDistanceFields
+{
+public:
+    /// Memory in bytes all fields may use together
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    /// Paths must be shorter than this
+    static constexpr unsigned MAX_LENGTH = 0xFFFF;
+
+    explicit ShipDistanceFields(const World& world);
+
+    /// Forget all fields, e.g. when a new map is loaded
+    void Init(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    /// Return true if the fields for all coastal points of the map fit into the memory budget
+    bool IsUsable();
+    /// Find a shortest path from start to the coastal point dest with at most maxLength (< MAX_LENGTH) steps.
+    /// Of multiple shortest paths the one preferring the directions from firstDir on (clockwise) is taken
+    bool FindPath(MapPoint start, MapPoint dest, unsigned maxLength, unsigned firstDir, std::vector<Direction>* route, unsigned* length);
+
+    /// Return the number of fields calculated so far
+    unsigned GetNumFields() const { return fields_.size(); }
+
+private:
+    using Field = std::vector<uint16_t>;
+    static constexpr uint16_t NOT_REACHED = MAX_LENGTH;
+
+    const World& world_;
+    size_t memoryBudget_;
+    enum class State
+    {
+        Unchecked,
+        Usable,
+        TooLarge
+    } state_;
+    /// Fields by the index of their coastal point
+    std::map<unsigned, Field> fields_;
+
+    const Field& GetField(MapPoint dest);
+    /// Breadth first search from the coastal point over all nodes ships can reach
+    void CalcField(MapPoint dest, Field& field) const;
+};
+
+#endif // ShipDistanceFields_h__
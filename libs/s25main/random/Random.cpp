@@ -32,9 +32,13 @@ int calcRandValue(T_PRNG& rng, int max)
     return static_cast<int>(rng() % static_cast<unsigned>(max));
 }
 
+template<class T_PRNG>
+constexpr unsigned Random<T_PRNG>::DEFAULT_HISTORY_SIZE;
+
 template<class T_PRNG>
 Random<T_PRNG>::Random()
 {
+    SetHistorySize(DEFAULT_HISTORY_SIZE);
     Init(123456789);
 }
 
@@ -54,7 +58,13 @@ void Random<T_PRNG>::ResetState(const PRNG& newState)
 template<class T_PRNG>
 int Random<T_PRNG>::Rand(const char* const src_name, const unsigned src_line, const unsigned obj_id, const int max)
 {
-    history_[numInvocations_ % history_.size()] = RandomEntry(numInvocations_, max, rng_, src_name, src_line, obj_id);
+    HistoryEntry& entry = history_[numInvocations_ & historyMask_];
+    entry.counter = numInvocations_;
+    entry.max = max;
+    entry.rngState = rng_;
+    entry.src_name = src_name;
+    entry.src_line = src_line;
+    entry.obj_id = obj_id;
     ++numInvocations_;
 
     return calcRandValue(rng_, max);
@@ -108,7 +118,10 @@ std::vector<typename Random<T_PRNG>::RandomEntry> Random<T_PRNG>::GetAsyncLog()
 
     ret.reserve(end - begin);
     for(unsigned i = begin; i < end; ++i)
-        ret.push_back(history_[i % history_.size()]);
+    {
+        const HistoryEntry& entry = history_[i & historyMask_];
+        ret.emplace_back(entry.counter, entry.max, entry.rngState, entry.src_name, entry.src_line, entry.obj_id);
+    }
 
     return ret;
 }
@@ -123,6 +136,19 @@ void Random<T_PRNG>::SaveLog(const std::string& filename)
         file << curLog << std::endl;
 }
 
+template<class T_PRNG>
+void Random<T_PRNG>::SetHistorySize(unsigned size)
+{
+    RTTR_Assert(size > 0u && size <= (1u << 31));
+    unsigned roundedSize = 1;
+    while(roundedSize < size)
+        roundedSize <<= 1;
+    history_.clear();
+    history_.resize(roundedSize);
+    historyMask_ = roundedSize - 1;
+    numInvocations_ = 0;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template<class T_PRNG>
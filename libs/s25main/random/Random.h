@@ -69,6 +69,9 @@ public:
         int GetValue() const;
     };
 
+    /// Number of invocations kept in the history by default
+    static constexpr unsigned DEFAULT_HISTORY_SIZE = 1024;
+
     Random();
     /// Initialize the rng with a given seed
     void Init(const uint64_t& seed);
@@ -89,12 +92,31 @@ public:
     /// Save the log to a file
     void SaveLog(const std::string& filename);
 
+    /// Set the number of invocations kept in the history (rounded up to a power of 2). A larger history helps finding the cause of an
+    /// async. Clears the history and the invocation counter, so this must be called before a game is started
+    void SetHistorySize(unsigned size);
+    unsigned GetHistorySize() const { return static_cast<unsigned>(history_.size()); }
+
 private:
+    /// Invocation of the rng as stored in the history. Only keeps the pointer to the source file name,
+    /// which is a string literal (__FILE__), so recording an invocation doesn't allocate
+    struct HistoryEntry
+    {
+        unsigned counter;
+        int max;
+        PRNG rngState;
+        const char* src_name;
+        unsigned src_line;
+        unsigned obj_id;
+    };
+
     PRNG rng_; /// the PRNG
     /// Number of invocations to the PRNG
     unsigned numInvocations_;
-    /// History
-    std::array<RandomEntry, 1024> history_; //-V730_NOINIT
+    /// Ring buffer of the last invocations. Size is a power of 2
+    std::vector<HistoryEntry> history_;
+    /// history_.size() - 1 to get the index of an invocation
+    unsigned historyMask_;
 };
 
 /// The actual PRNG used for the ingame RNG
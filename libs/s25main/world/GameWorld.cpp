@@ -17,8 +17,10 @@
 
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "GameWorld.h"
+#include "GamePlayer.h"
 #include "GlobalGameSettings.h"
 #include "SerializedGameData.h"
+#include "addons/const_addons.h"
 #include "buildings/noBuildingSite.h"
 #include "lua/LuaInterfaceGame.h"
 #include "ogl/glArchivItem_Map.h"
@@ -64,6 +66,31 @@ bool GameWorld::LoadMap(const std::shared_ptr<Game>& game, const std::string& ma
     return true;
 }
 
+bool GameWorld::SetupNewGame(const std::shared_ptr<Game>& game, const std::string& mapFilePath, const std::string& luaFilePath)
+{
+    /// Startbündnisse setzen
+    for(unsigned i = 0; i < GetNumPlayers(); ++i)
+        GetPlayer(i).MakeStartPacts();
+
+    if(!LoadMap(game, mapFilePath, luaFilePath))
+        return false;
+
+    /// Evtl. Goldvorkommen ändern
+    Resource::Type target; // löschen
+    switch(GetGGS().getSelection(AddonId::CHANGE_GOLD_DEPOSITS))
+    {
+        case 0:
+        default: target = Resource::Gold; break;
+        case 1: target = Resource::Nothing; break;
+        case 2: target = Resource::Iron; break;
+        case 3: target = Resource::Coal; break;
+        case 4: target = Resource::Granite; break;
+    }
+    ConvertMineResourceTypes(Resource::Gold, target);
+    PlaceAndFixWater();
+    return true;
+}
+
 void GameWorld::Serialize(SerializedGameData& sgd) const
 {
     MapSerializer::Serialize(*this, GetNumPlayers(), sgd);
@@ -93,6 +120,7 @@ void GameWorld::Serialize(SerializedGameData& sgd) const
 
 void GameWorld::Deserialize(const std::shared_ptr<Game>& game, SerializedGameData& sgd)
 {
+    ClearViewerCounts();
     MapSerializer::Deserialize(*this, GetNumPlayers(), sgd);
 
     sgd.PopObjectContainer(harbor_building_sites_from_sea, GOT_BUILDINGSITE);
@@ -32,6 +32,8 @@ public:
 
     /// Lädt eine Karte
     bool LoadMap(const std::shared_ptr<Game>& game, const std::string& mapFilePath, const std::string& luaFilePath);
+    /// Load the map for a new game and apply the game settings that modify it (start pacts, gold deposits, ...)
+    bool SetupNewGame(const std::shared_ptr<Game>& game, const std::string& mapFilePath, const std::string& luaFilePath);
 
     /// Serialisiert den gesamten GameWorld
     void Serialize(SerializedGameData& sgd) const;
@@ -31,15 +31,19 @@
 #include "notifications/NodeNote.h"
 #include "notifications/PlayerNodeNote.h"
 #include "pathfinding/FreePathFinder.h"
+#include "pathfinding/HierarchicalPathFinder.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ShipDistanceFields.h"
 #include "nodeObjs/noFlag.h"
+#include "nodeObjs/noShip.h"
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
 #include "gameData/TerrainDesc.h"
 #include <utility>
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
-    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
+    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)),
+      hierarchicalPathFinder(new HierarchicalPathFinder(*this)), shipDistanceFields(new ShipDistanceFields(*this)), players(std::move(players)),
       gameSettings(gameSettings), em(em), gi(nullptr)
 {}
 
@@ -51,12 +55,16 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     BuildingProperties::Init();
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
+    hierarchicalPathFinder->Init(mapSize);
+    shipDistanceFields->Init();
 }
 
 void GameWorldBase::InitAfterLoad()
 {
     RTTR_FOREACH_PT(MapPoint, GetSize())
         RecalcBQ(pt);
+    // Nodes were set directly by the map loader or deserialization
+    InitStateHash();
 }
 
 GamePlayer& GameWorldBase::GetPlayer(const unsigned id)
@@ -271,6 +279,24 @@ void GameWorldBase::AltitudeChanged(const MapPoint pt)
     GetNotifications().publish(NodeNote(NodeNote::Altitude, pt));
 }
 
+void GameWorldBase::PassabilityChanged(const MapPoint pt)
+{
+    hierarchicalPathFinder->NodeChanged(pt);
+}
+
+void GameWorldBase::FigureAdded(const MapPoint pt, noBase& fig)
+{
+    // Ships are figures, so this keeps their military square up to date while they move
+    if(fig.GetGOT() == GOT_SHIP)
+        militarySquares.AddShip(static_cast<noShip*>(&fig), pt);
+}
+
+void GameWorldBase::FigureRemoved(const MapPoint pt, noBase& fig)
+{
+    if(fig.GetGOT() == GOT_SHIP)
+        militarySquares.RemoveShip(static_cast<noShip*>(&fig), pt);
+}
+
 void GameWorldBase::RecalcBQAroundPoint(const MapPoint pt)
 {
     RecalcBQ(pt);
@@ -31,17 +31,21 @@ class FreePathFinder;
 class GamePlayer;
 class GameInterface;
 class GlobalGameSettings;
+class HierarchicalPathFinder;
 class noBuildingSite;
 class noFlag;
 class nobHarborBuilding;
 class nofPassiveSoldier;
 class RoadPathFinder;
+class ShipDistanceFields;
 
 /// Grundlegende Klasse, die die Gamewelt darstellt, enth�lt nur deren Daten
 class GameWorldBase : public World
 {
     std::unique_ptr<RoadPathFinder> roadPathFinder;
     std::unique_ptr<FreePathFinder> freePathFinder;
+    std::unique_ptr<HierarchicalPathFinder> hierarchicalPathFinder;
+    std::unique_ptr<ShipDistanceFields> shipDistanceFields;
     PostManager postManager;
     NotificationManager notifications;
 
@@ -63,7 +67,7 @@ public:
     // Grundlegende Initialisierungen
     void Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt = DescIdx<LandscapeDesc>(0)) override;
     // Remaining initialization after loading (BQ...)
-    void InitAfterLoad();
+    virtual void InitAfterLoad();
 
     /// Setzt GameInterface
     void SetGameInterface(GameInterface* const gi) { this->gi = gi; }
@@ -87,16 +91,33 @@ public:
     bool IsMilitaryBuildingOnNode(MapPoint pt, bool attackBldsOnly) const;
     /// Erstellt eine Liste mit allen Milit�rgeb�uden in der Umgebung, radius bestimmt wie viele K�stchen nach einer Richtung im Umkreis
     sortedMilitaryBlds LookForMilitaryBuildings(MapPoint pt, unsigned short radius) const;
+    /// Call functor(bld) for the buildings LookForMilitaryBuildings would return without creating the container.
+    /// The order is unspecified, so only use it for queries which don't depend on it
+    template<class T_Functor>
+    void VisitMilitaryBuildings(MapPoint pt, unsigned short radius, T_Functor&& functor) const
+    {
+        militarySquares.VisitBuildingsInRange(pt, radius, functor);
+    }
+    /// Same as VisitMilitaryBuildings but only for the buildings of the given player
+    template<class T_Functor>
+    void VisitMilitaryBuildings(MapPoint pt, unsigned short radius, unsigned char player, T_Functor&& functor) const
+    {
+        militarySquares.VisitBuildingsInRange(pt, radius, player, functor);
+    }
 
     /// Finds a path for figures. Returns 0xFF if none found
     unsigned char FindHumanPath(MapPoint start, MapPoint dest, unsigned max_route = 0xFFFFFFFF, bool random_route = false,
                                 unsigned* length = nullptr, std::vector<Direction>* route = nullptr) const;
     /// Find path for ships to a specific harbor and see. Return true on success
-    bool FindShipPathToHarbor(MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route, unsigned* length);
+    /// The path may be at most maxDistance long, 0 = distance to the furthest harbor at that sea plus a few fields
+    bool FindShipPathToHarbor(MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route, unsigned* length,
+                              unsigned maxDistance = 0);
     /// Find path for ships with a limited distance. Return true on success
     bool FindShipPath(MapPoint start, MapPoint dest, unsigned maxDistance, std::vector<Direction>* route, unsigned* length);
     RoadPathFinder& GetRoadPathFinder() const { return *roadPathFinder; }
     FreePathFinder& GetFreePathFinder() const { return *freePathFinder; }
+    HierarchicalPathFinder& GetHierarchicalPathFinder() const { return *hierarchicalPathFinder; }
+    ShipDistanceFields& GetShipDistanceFields() const { return *shipDistanceFields; }
 
     /// Return flag that is on road at given point. dir will be set to the direction of the road from the returned flag
     /// prevDir (if set) will be skipped when searching for the road points
@@ -191,6 +212,11 @@ protected:
     void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) override;
     /// Called, when the altitude of a point was changed
     void AltitudeChanged(MapPoint pt) override;
+    /// Called when the object or roads of a point were changed
+    void PassabilityChanged(MapPoint pt) override;
+    /// Called when a figure was added to or removed from a point
+    void FigureAdded(MapPoint pt, noBase& fig) override;
+    void FigureRemoved(MapPoint pt, noBase& fig) override;
 
 private:
     /// Returns the harbor ID of the next matching harbor in the given direction (0 = None)
@@ -24,6 +24,7 @@
 #include "TradePathCache.h"
 #include "addons/const_addons.h"
 #include "buildings/noBuildingSite.h"
+#include "buildings/nobBaseWarehouse.h"
 #include "buildings/nobMilitary.h"
 #include "buildings/nobUsual.h"
 #include "figures/nofAttacker.h"
@@ -33,6 +34,7 @@
 #include "lua/LuaInterfaceGame.h"
 #include "notifications/BuildingNote.h"
 #include "notifications/ExpeditionNote.h"
+#include "notifications/NodeNote.h"
 #include "notifications/RoadNote.h"
 #include "pathfinding/PathConditionHuman.h"
 #include "pathfinding/PathConditionRoad.h"
@@ -50,6 +52,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <set>
 #include <stdexcept>
 
@@ -74,6 +77,21 @@ GameWorldGame::~GameWorldGame()
     GameObject::DetachWorld(this);
 }
 
+void GameWorldGame::InitAfterLoad()
+{
+    GameWorldBase::InitAfterLoad();
+    // Occupied lookout towers are only known once their workers are loaded
+    for(unsigned i = 0; i < GetNumPlayers(); ++i)
+    {
+        for(nobUsual* tower : GetPlayer(i).GetBuildingRegister().GetBuildings(BLD_LOOKOUTTOWER))
+        {
+            if(tower->HasWorker())
+                militarySquares.AddLookoutTower(tower);
+        }
+    }
+    RecalcViewerCounts();
+}
+
 MilitarySquares& GameWorldGame::GetMilitarySquares()
 {
     return militarySquares;
@@ -136,6 +154,7 @@ void GameWorldGame::SetPointRoad(MapPoint pt, Direction dir, unsigned char type)
         pt = GetNeighbour(pt, dir);
 
     SetRoad(pt, dir.toUInt(), type);
+    GetNotifications().publish(NodeNote(NodeNote::Road, pt));
 
     if(gi)
         gi->GI_UpdateMinimap(pt);
@@ -1026,24 +1045,45 @@ bool GameWorldGame::ValidPointForFighting(const MapPoint pt, const bool avoid_mi
 
 bool GameWorldGame::IsPointCompletelyVisible(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const
 {
-    sortedMilitaryBlds buildings = LookForMilitaryBuildings(pt, 3);
+    if(viewerCounts_.empty())
+        return IsPointSeenByBuildings(pt, player, exception) || IsPointScoutedByFigures(pt, player) || IsPointScoutedByShip(pt, player);
 
-    // Sichtbereich von Militärgebäuden
-    for(const nobBaseMilitary* milBld : buildings)
+    unsigned numViewers = viewerCounts_[player][GetIdx(pt)];
+    // The exception is only counted if it still sees something
+    if(numViewers && exception && exception->GetPlayer() == player)
     {
-        if(milBld->GetPlayer() == player && milBld != exception)
-        {
-            // Prüfen, obs auch unbesetzt ist
-            if(milBld->GetGOT() == GOT_NOB_MILITARY)
-            {
-                if(static_cast<const nobMilitary*>(milBld)->IsNewBuilt())
-                    continue;
-            }
-
-            if(CalcDistance(pt, milBld->GetPos()) <= unsigned(milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY))
-                return true;
-        }
+        const unsigned radius = GetViewerRadius(*exception);
+        if(radius && CalcDistance(pt, exception->GetPos()) <= radius)
+            numViewers--;
     }
+    RTTR_Assert((numViewers > 0u) == (IsPointSeenByBuildings(pt, player, exception) || IsPointScoutedByFigures(pt, player)));
+    if(numViewers)
+        return true;
+    // Ships are not counted as their visual range changes with their state, not only when they move
+    return IsPointScoutedByShip(pt, player);
+}
+
+bool GameWorldGame::IsPointScoutedByFigures(const MapPoint& pt, unsigned char player) const
+{
+    const unsigned range = std::max(VISUALRANGE_SCOUT, VISUALRANGE_SOLDIER);
+    return CheckPointsInRadius(pt, range, [this, player](auto pt, auto distance) { return this->IsScoutingFigureOnNode(pt, player, distance); },
+                               true);
+}
+
+bool GameWorldGame::IsPointSeenByBuildings(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const
+{
+    // Sichtbereich von Militärgebäuden
+    bool isSeen = false;
+    VisitMilitaryBuildings(pt, 3, player, [this, pt, exception, &isSeen](const nobBaseMilitary* milBld) {
+        // Prüfen, obs auch unbesetzt ist
+        if(isSeen || milBld == exception
+           || (milBld->GetGOT() == GOT_NOB_MILITARY && static_cast<const nobMilitary*>(milBld)->IsNewBuilt()))
+            return;
+        if(CalcDistance(pt, milBld->GetPos()) <= unsigned(milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY))
+            isSeen = true;
+    });
+    if(isSeen)
+        return true;
 
     // Sichtbereich von Hafenbaustellen
     for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
@@ -1055,30 +1095,160 @@ bool GameWorldGame::IsPointCompletelyVisible(const MapPoint& pt, unsigned char p
         }
     }
 
-    // Sichtbereich von Spähtürmen
-    for(const nobUsual* bld : GetPlayer(player).GetBuildingRegister().GetBuildings(BLD_LOOKOUTTOWER)) //-V807
+    // Sichtbereich von Spähtürmen (nur besetzte sind in den Militärquadraten)
+    const unsigned short squareRadius = MilitarySquares::GetSquareRadius(VISUALRANGE_LOOKOUTTOWER);
+    militarySquares.VisitLookoutTowersInRange(pt, squareRadius, player, [this, pt, exception, &isSeen](const nobUsual* tower) {
+        // Nicht die Ausnahme wählen
+        if(isSeen || tower == exception)
+            return;
+        // Liegt Spähturm innerhalb des Sichtradius?
+        if(CalcDistance(pt, tower->GetPos()) <= VISUALRANGE_LOOKOUTTOWER)
+            isSeen = true;
+    });
+    return isSeen;
+}
+
+unsigned GameWorldGame::GetViewerRadius(const noBaseBuilding& building) const
+{
+    const GO_Type got = building.GetGOT();
+    if(got == GOT_NOB_MILITARY || got == GOT_NOB_HQ || got == GOT_NOB_HARBORBUILDING)
     {
-        // Ist Späturm überhaupt besetzt?
-        if(!bld->HasWorker())
-            continue;
+        // Military buildings need to be occupied
+        if(got == GOT_NOB_MILITARY && static_cast<const nobMilitary&>(building).IsNewBuilt())
+            return 0;
+        // Destroyed buildings are removed from the military squares
+        bool isRegistered = false;
+        VisitMilitaryBuildings(building.GetPos(), 0, [&building, &isRegistered](const nobBaseMilitary* milBld) {
+            if(milBld == &building)
+                isRegistered = true;
+        });
+        if(!isRegistered)
+            return 0;
+        return building.GetMilitaryRadius() + VISUALRANGE_MILITARY;
+    } else if(got == GOT_BUILDINGSITE)
+    {
+        if(IsHarborBuildingSiteFromSea(static_cast<const noBuildingSite*>(&building)))
+            return HARBOR_RADIUS + VISUALRANGE_MILITARY;
+    } else if(got == GOT_NOB_USUAL && building.GetBuildingType() == BLD_LOOKOUTTOWER)
+    {
+        const auto& tower = static_cast<const nobUsual&>(building);
+        if(tower.HasWorker()
+           && helpers::contains(GetPlayer(tower.GetPlayer()).GetBuildingRegister().GetBuildings(BLD_LOOKOUTTOWER), &tower))
+            return VISUALRANGE_LOOKOUTTOWER;
+    }
+    return 0;
+}
 
-        // Nicht die Ausnahme wählen
-        if(bld == exception)
-            continue;
+void GameWorldGame::RecalcViewerCounts()
+{
+    viewerCounts_.assign(GetNumPlayers(), std::vector<uint16_t>(prodOfComponents(GetSize()), 0));
+    const auto addViewer = [this](const noBaseBuilding& building) {
+        const unsigned radius = GetViewerRadius(building);
+        if(radius)
+            AddViewer(building.GetPos(), radius, building.GetPlayer());
+    };
+    for(unsigned i = 0; i < GetNumPlayers(); ++i)
+    {
+        const BuildingRegister& buildings = GetPlayer(i).GetBuildingRegister();
+        for(const nobMilitary* bld : buildings.GetMilitaryBuildings())
+            addViewer(*bld);
+        for(const nobBaseWarehouse* bld : buildings.GetStorehouses())
+            addViewer(*bld);
+        for(const nobUsual* bld : buildings.GetBuildings(BLD_LOOKOUTTOWER))
+            addViewer(*bld);
+    }
+    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
+        addViewer(*bldSite);
+    // Figures of the nodes were loaded without notifying the world
+    RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
+        for(const noBase* fig : GetFigures(pt))
+            VisitFigureViewers(*fig, [this, pt](unsigned char player, unsigned radius) { AddViewer(pt, radius, player); });
+    }
+}
 
-        // Liegt Spähturm innerhalb des Sichtradius?
-        if(CalcDistance(pt, bld->GetPos()) <= VISUALRANGE_LOOKOUTTOWER)
-            return true;
+template<class T_Func>
+void GameWorldGame::VisitFigureViewers(const noBase& fig, T_Func&& func) const
+{
+    // Same figures as checked by IsScoutingFigureOnNode
+    switch(fig.GetGOT())
+    {
+        case GOT_NOF_SCOUT_FREE: func(static_cast<const nofScout_Free&>(fig).GetPlayer(), VISUALRANGE_SCOUT); break;
+        case GOT_NOF_ATTACKER:
+        case GOT_NOF_AGGRESSIVEDEFENDER: func(static_cast<const nofActiveSoldier&>(fig).GetPlayer(), VISUALRANGE_SOLDIER); break;
+        case GOT_FIGHTING:
+        {
+            // The players of a fight stay the same while it is on the map as the winner is remembered when leaving it
+            const auto& fight = static_cast<const noFighting&>(fig);
+            for(unsigned char player = 0; player < GetNumPlayers(); ++player)
+            {
+                if(fight.IsSoldierOfPlayer(player))
+                    func(player, VISUALRANGE_SOLDIER);
+            }
+            break;
+        }
+        default: break;
     }
+}
 
-    // Check scouts and soldiers
-    const unsigned range = std::max(VISUALRANGE_SCOUT, VISUALRANGE_SOLDIER);
-    if(CheckPointsInRadius(pt, range, [this, player](auto pt, auto distance) { return this->IsScoutingFigureOnNode(pt, player, distance); },
-                           true))
+void GameWorldGame::FigureAdded(const MapPoint pt, noBase& fig)
+{
+    GameWorldBase::FigureAdded(pt, fig);
+    VisitFigureViewers(fig, [this, pt](unsigned char player, unsigned radius) { AddViewer(pt, radius, player); });
+}
+
+void GameWorldGame::FigureRemoved(const MapPoint pt, noBase& fig)
+{
+    GameWorldBase::FigureRemoved(pt, fig);
+    VisitFigureViewers(fig, [this, pt](unsigned char player, unsigned radius) { RemoveViewer(pt, radius, player); });
+}
+
+/// Calls the function with the index of each point within the radius around pt exactly once (even on small maps)
+template<class T_Func>
+static void ForEachIdxInRadius(const GameWorldGame& world, const MapPoint pt, const unsigned radius, T_Func&& func)
+{
+    const MapExtent size = world.GetSize();
+    if(size.x > 2 * radius && size.y > 2 * radius)
     {
-        return true;
+        // The circle does not wrap around onto itself, so each point is reached once
+        world.CheckPointsInRadius(pt, radius,
+                                  [&world, &func](const MapPoint curPt, unsigned) {
+                                      func(world.GetIdx(curPt));
+                                      return false;
+                                  },
+                                  true);
+    } else
+    {
+        std::vector<unsigned> indices;
+        for(const MapPoint& curPt : world.GetPointsInRadiusWithCenter(pt, radius))
+            indices.push_back(world.GetIdx(curPt));
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        for(const unsigned idx : indices)
+            func(idx);
     }
-    return IsPointScoutedByShip(pt, player);
+}
+
+void GameWorldGame::AddViewer(const MapPoint pt, const unsigned radius, const unsigned char player)
+{
+    if(viewerCounts_.empty())
+        return;
+    std::vector<uint16_t>& counts = viewerCounts_[player];
+    ForEachIdxInRadius(*this, pt, radius, [&counts](const unsigned idx) {
+        RTTR_Assert(counts[idx] < std::numeric_limits<uint16_t>::max());
+        ++counts[idx];
+    });
+}
+
+void GameWorldGame::RemoveViewer(const MapPoint pt, const unsigned radius, const unsigned char player)
+{
+    if(viewerCounts_.empty())
+        return;
+    std::vector<uint16_t>& counts = viewerCounts_[player];
+    ForEachIdxInRadius(*this, pt, radius, [&counts](const unsigned idx) {
+        RTTR_Assert(counts[idx] > 0u);
+        --counts[idx];
+    });
 }
 
 bool GameWorldGame::IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const
@@ -1120,14 +1290,15 @@ bool GameWorldGame::IsScoutingFigureOnNode(const MapPoint& pt, unsigned player,
 
 bool GameWorldGame::IsPointScoutedByShip(const MapPoint& pt, unsigned player) const
 {
-    const std::vector<noShip*>& ships = GetPlayer(player).GetShips();
-    for(const noShip* ship : ships)
-    {
-        unsigned shipDistance = CalcDistance(pt, ship->GetPos());
-        if(shipDistance <= ship->GetVisualRange())
-            return true;
-    }
-    return false;
+    static_assert(VISUALRANGE_EXPLORATION_SHIP >= VISUALRANGE_SHIP, "Visual range changed. Check radius below!");
+
+    bool isScouted = false;
+    const unsigned short squareRadius = MilitarySquares::GetSquareRadius(VISUALRANGE_EXPLORATION_SHIP);
+    militarySquares.VisitShipsInRange(pt, squareRadius, player, [this, pt, &isScouted](const noShip* ship) {
+        if(!isScouted && CalcDistance(pt, ship->GetPos()) <= ship->GetVisualRange())
+            isScouted = true;
+    });
+    return isScouted;
 }
 
 void GameWorldGame::RecalcVisibility(const MapPoint pt, const unsigned char player, const noBaseBuilding* const exception)
@@ -1367,10 +1538,19 @@ bool GameWorldGame::FoundColony(const unsigned harbor_point, const unsigned char
     return true;
 }
 
+void GameWorldGame::AddHarborBuildingSiteFromSea(noBuildingSite* building_site)
+{
+    harbor_building_sites_from_sea.push_back(building_site);
+    AddViewer(building_site->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY, building_site->GetPlayer());
+}
+
 void GameWorldGame::RemoveHarborBuildingSiteFromSea(noBuildingSite* building_site)
 {
     RTTR_Assert(building_site->GetBuildingType() == BLD_HARBORBUILDING);
+    if(!IsHarborBuildingSiteFromSea(building_site))
+        return;
     harbor_building_sites_from_sea.remove(building_site);
+    RemoveViewer(building_site->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY, building_site->GetPlayer());
 }
 
 bool GameWorldGame::IsHarborBuildingSiteFromSea(const noBuildingSite* building_site) const
@@ -20,6 +20,7 @@
 
 #include "world/GameWorldBase.h"
 #include "gameTypes/MapCoordinates.h"
+#include <cstdint>
 #include <vector>
 
 class GameInterface;
@@ -43,6 +44,10 @@ enum class TerritoryChangeReason
 /// "Interface-Klasse" für das Spiel
 class GameWorldGame : public GameWorldBase
 {
+    /// Number of buildings and figures (scouts, attacking soldiers and fights) of each player which see each point
+    /// (per player, indexed by point). Empty until InitAfterLoad, afterwards kept up to date by AddViewer/RemoveViewer
+    std::vector<std::vector<uint16_t>> viewerCounts_;
+
     /// Destroys player belongings if that pint does not belong to the player anymore
     void DestroyPlayerRests(MapPoint pt, unsigned char newOwner, const noBaseBuilding* exception);
 
@@ -50,6 +55,17 @@ class GameWorldGame : public GameWorldBase
     bool HasRemovableObjForRoad(MapPoint pt) const;
 
     bool IsPointCompletelyVisible(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const;
+    /// Return if any building of the player (except the given one) sees the point by checking all of them
+    bool IsPointSeenByBuildings(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const;
+    /// Return the radius within which the building sees everything for its owner or 0 if it does not (e.g. unoccupied)
+    unsigned GetViewerRadius(const noBaseBuilding& building) const;
+    /// Counts the buildings and figures seeing each point for all players
+    void RecalcViewerCounts();
+    /// Call func(player, radius) for each player for whom the figure sees everything within the radius around it
+    template<class T_Func>
+    void VisitFigureViewers(const noBase& fig, T_Func&& func) const;
+    /// Return if a scout or soldier of the player sees the point by checking the figures around it
+    bool IsPointScoutedByFigures(const MapPoint& pt, unsigned char player) const;
     /// Return if there is a scout (or an attacking soldier) of this player at that node with a visual range of at most the given distance.
     /// Excludes scouting ships!
     bool IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const;
@@ -70,11 +86,15 @@ class GameWorldGame : public GameWorldBase
 protected:
     /// Create Trade graphs
     void CreateTradeGraphs();
+    /// Forget the viewer counts, e.g. before loading a game. They are recalculated by InitAfterLoad
+    void ClearViewerCounts() { viewerCounts_.clear(); }
 
 public:
     GameWorldGame(const std::vector<PlayerInfo>& players, const GlobalGameSettings& gameSettings, EventManager& em);
     ~GameWorldGame() override;
 
+    void InitAfterLoad() override;
+
     /// Stellt anderen Spielern/Spielobjekten das Game-GUI-Interface zur Verfüung
     inline GameInterface* GetGameInterface() const { return gi; }
 
@@ -149,6 +169,11 @@ public:
     void MakeVisibleAroundPoint(MapPoint pt, MapCoord radius, unsigned char player);
     /// Bestimmt bei der Bewegung eines spähenden Objekts die Sichtbarkeiten an den Rändern neu
     void RecalcMovingVisibilities(MapPoint pt, unsigned char player, MapCoord radius, Direction moving_dir, MapPoint* enemy_territory);
+    /// Notify that a building of the player starts to see everything within the radius around pt.
+    /// Must be called whenever GetViewerRadius of a building changes from 0, RemoveViewer when it changes back.
+    /// Figures are handled automatically when they are added to or removed from a node
+    void AddViewer(MapPoint pt, unsigned radius, unsigned char player);
+    void RemoveViewer(MapPoint pt, unsigned radius, unsigned char player);
 
     /// Return whether this is a border node (node belongs to player, but not all others around)
     bool IsBorderNode(MapPoint pt, unsigned char owner) const;
@@ -163,7 +188,7 @@ public:
     /// Gründet vom Schiff aus eine neue Kolonie, gibt true zurück bei Erfolg
     bool FoundColony(unsigned harbor_point, unsigned char player, unsigned short seaId);
     /// Registriert eine Baustelle eines Hafens, die vom Schiff aus gesetzt worden ist
-    void AddHarborBuildingSiteFromSea(noBuildingSite* building_site) { harbor_building_sites_from_sea.push_back(building_site); }
+    void AddHarborBuildingSiteFromSea(noBuildingSite* building_site);
     /// Removes it. It is allowed to be called with a regular harbor building site (no-op in that case)
     void RemoveHarborBuildingSiteFromSea(noBuildingSite* building_site);
     /// Gibt zurück, ob eine bestimmte Baustellen eine Baustelle ist, die vom Schiff aus errichtet wurde
@@ -178,6 +203,9 @@ public:
 
 protected:
     void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) override;
+    /// Scouts and soldiers change the viewer counts when they move
+    void FigureAdded(MapPoint pt, noBase& fig) override;
+    void FigureRemoved(MapPoint pt, noBase& fig) override;
 };
 
 #endif // GameWorldGame_h__
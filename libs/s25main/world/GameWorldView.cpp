@@ -31,6 +31,7 @@
 #include "helpers/containerUtils.h"
 #include "helpers/toString.h"
 #include "ogl/FontStyle.h"
+#include "ogl/SpriteBatch.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
 #include "ogl/glSmartBitmap.h"
@@ -148,6 +149,10 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
     terrainRenderer.Draw(GetFirstPt(), GetLastPt(), gwv, water);
     glTranslatef(static_cast<GLfloat>(offset.x), static_cast<GLfloat>(offset.y), 0.0f);
 
+    // Draw the objects in as few draw calls as possible. Needs to be flushed before changing the matrices
+    SpriteBatch& spriteBatch = VIDEODRIVER.GetSpriteBatch();
+    spriteBatch.Begin();
+
     for(int y = firstPt.y; y <= lastPt.y; ++y)
     {
         // Figuren speichern, die in dieser Zeile gemalt werden müssen
@@ -209,6 +214,7 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
         if(gwv.GetVisibility(catapult_stone->dest_building) == VIS_VISIBLE || gwv.GetVisibility(catapult_stone->dest_map) == VIS_VISIBLE)
             catapult_stone->Draw(offset);
     }
+    spriteBatch.End();
 
     if(zoomFactor_ != 1.f) //-V550
     {
@@ -56,10 +56,12 @@ void GameWorldViewer::InitVisualData()
 void GameWorldViewer::InitTerrainRenderer()
 {
     tr.GenerateOpenGL(*this);
-    // Notify renderer about altitude changes
-    evAltitudeChanged = gwb.GetNotifications().subscribe<NodeNote>([this](const NodeNote& note) {
+    // Notify renderer about altitude and road changes
+    evNodeChanged = gwb.GetNotifications().subscribe<NodeNote>([this](const NodeNote& note) {
         if(note.type == NodeNote::Altitude)
             tr.AltitudeChanged(note.pos, *this);
+        else if(note.type == NodeNote::Road)
+            tr.RoadChanged(note.pos);
     });
     // And visibility changes
     evVisibilityChanged = gwb.GetNotifications().subscribe<PlayerNodeNote>([this](const PlayerNodeNote& note) {
@@ -88,13 +90,11 @@ unsigned GameWorldViewer::GetNumSoldiersForAttack(const MapPoint pt) const
     // Militärgebäude in der Nähe finden
     unsigned total_count = 0;
 
-    sortedMilitaryBlds buildings = GetWorld().LookForMilitaryBuildings(pt, 3);
-    for(auto& building : buildings)
-    {
+    GetWorld().VisitMilitaryBuildings(pt, 3, playerId_, [pt, &total_count](const nobBaseMilitary* building) {
         // Muss ein Gebäude von uns sein und darf nur ein "normales Militärgebäude" sein (kein HQ etc.)
-        if(building->GetPlayer() == playerId_ && BuildingProperties::IsMilitary(building->GetBuildingType()))
-            total_count += static_cast<nobMilitary*>(building)->GetNumSoldiersForAttack(pt);
-    }
+        if(BuildingProperties::IsMilitary(building->GetBuildingType()))
+            total_count += static_cast<const nobMilitary*>(building)->GetNumSoldiersForAttack(pt);
+    });
 
     return total_count;
 }
@@ -180,6 +180,7 @@ void GameWorldViewer::SetVisiblePointRoad(const MapPoint& pt, Direction dir, uns
     } else
         nodePt = GetNeighbour(pt, dir);
     visualNodes[GetWorld().GetIdx(nodePt)].roads[dir.toUInt()] = type;
+    tr.RoadChanged(nodePt);
 }
 
 bool GameWorldViewer::IsOnRoad(const MapPoint& pt) const
@@ -109,7 +109,7 @@ private:
     unsigned playerId_;
     GameWorldBase& gwb;
     TerrainRenderer tr;
-    Subscription evVisibilityChanged, evAltitudeChanged, evRoadConstruction, evBQChanged;
+    Subscription evVisibilityChanged, evNodeChanged, evRoadConstruction, evBQChanged;
     std::vector<VisualMapNode> visualNodes;
 
     void InitVisualData();
@@ -21,6 +21,7 @@
 #include "GameWorldBase.h"
 #include "PointOutput.h"
 #include "factories/BuildingFactory.h"
+#include "helpers/runParallel.h"
 #include "lua/GameDataLoader.h"
 #include "ogl/glArchivItem_Map.h"
 #include "pathfinding/PathConditionShip.h"
@@ -37,8 +38,10 @@
 #include "libsiedler2/ArchivItem_Map_Header.h"
 #include "s25util/Log.h"
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <queue>
+#include <thread>
 
 class noBase;
 
@@ -494,6 +497,7 @@ bool MapLoader::InitSeasAndHarbors(World& world, const std::vector<MapPoint>& ad
     return true;
 }
 
+namespace {
 // class for finding harbor neighbors
 struct CalcHarborPosNeighborsNode
 {
@@ -504,93 +508,97 @@ struct CalcHarborPosNeighborsNode
     unsigned distance;
 };
 
-/// Calculate the distance from each harbor to the others
-void MapLoader::CalcHarborPosNeighbors(World& world)
+/// Buffers of a thread searching the neighbors, reused for all harbors searched by it
+struct HarborNeighborSearch
+{
+    // Possible values are
+    // -1 - sea point, not already visited
+    // 0 - visited or no sea point
+    // 1 - Coast to a harbor
+    std::vector<int8_t> ptToVisitOrHb;
+    std::vector<bool> hbFound;
+    // FIFO queue used for a BFS
+    std::vector<CalcHarborPosNeighborsNode> todo_list;
+};
+} // namespace
+
+void MapLoader::CalcHarborPosNeighbors(World& world, unsigned numThreads)
 {
     for(HarborPos& harbor : world.harbor_pos)
     {
         for(unsigned z = 0; z < 6; ++z)
             harbor.neighbors[z].clear();
     }
-    PathConditionShip shipPathChecker(world);
+    const PathConditionShip shipPathChecker(world);
 
-    // pre-calculate sea-points, as IsSeaPoint is rather expensive
-    std::vector<int8_t> ptIsSeaPt(world.nodes.size()); //-V656
+    // pre-calculate sea-points, as IsSeaPoint is rather expensive. Coastal points of all harbors are marked too
+    std::vector<int8_t> ptIsSeaPtOrHb(world.nodes.size()); //-V656
 
     RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
         if(shipPathChecker.IsNodeOk(pt))
-            ptIsSeaPt[world.GetIdx(pt)] = -1;
+            ptIsSeaPtOrHb[world.GetIdx(pt)] = -1;
     }
 
-    // FIFO queue used for a BFS
-    std::queue<CalcHarborPosNeighborsNode> todo_list;
-
-    for(unsigned startHbId = 1; startHbId < world.harbor_pos.size(); ++startHbId)
+    // Store the coastal point indices and their harbor. A coastal point belongs to a single sea
+    std::multimap<unsigned, unsigned> coastToHarbor;
+    for(unsigned hbId = 1; hbId < world.harbor_pos.size(); ++hbId)
     {
-        RTTR_Assert(todo_list.empty());
-
-        // Copy sea points to working flags. Possible values are
-        // -1 - sea point, not already visited
-        // 0 - visited or no sea point
-        // 1 - Coast to a harbor
-        std::vector<int8_t> ptToVisitOrHb(ptIsSeaPt);
-
-        std::vector<bool> hbFound(world.harbor_pos.size(), false);
-        // For each sea, store the coastal point indices and their harbor
-        std::vector<std::multimap<unsigned, unsigned>> coastToHarborPerSea(world.seas.size() + 1);
-        std::vector<MapPoint> ownCoastalPoints;
-
-        // mark coastal points around harbors
-        for(unsigned otherHbId = 1; otherHbId < world.harbor_pos.size(); ++otherHbId)
+        for(unsigned d = 0; d < Direction::COUNT; d++)
         {
-            for(unsigned d = 0; d < Direction::COUNT; d++)
-            {
-                unsigned seaId = world.GetSeaId(otherHbId, Direction::fromInt(d));
-                // No sea? -> Next
-                if(!seaId)
-                    continue;
-                const MapPoint coastPt = world.GetNeighbour(world.GetHarborPoint(otherHbId), Direction::fromInt(d));
-                // This should not be marked for visit
-                unsigned idx = world.GetIdx(coastPt);
-                RTTR_Assert(ptToVisitOrHb[idx] != -1);
-                if(otherHbId == startHbId)
-                {
-                    // This is our start harbor. Add the coast points around it to our todo list.
-                    ownCoastalPoints.push_back(coastPt);
-                } else
-                {
-                    ptToVisitOrHb[idx] = 1;
-                    coastToHarborPerSea[seaId].insert(std::make_pair(idx, otherHbId));
-                }
-            }
+            // No sea? -> Next
+            if(!world.GetSeaId(hbId, Direction::fromInt(d)))
+                continue;
+            const unsigned idx = world.GetIdx(world.GetNeighbour(world.GetHarborPoint(hbId), Direction::fromInt(d)));
+            // This should not be marked for visit
+            RTTR_Assert(ptIsSeaPtOrHb[idx] != -1);
+            ptIsSeaPtOrHb[idx] = 1;
+            coastToHarbor.insert(std::make_pair(idx, hbId));
         }
+    }
+
+    // The searches only read the world and write the neighbors of their start harbor, so they can run in parallel
+    const auto searchNeighbors = [&](unsigned startHbId, HarborNeighborSearch& search) {
+        search.ptToVisitOrHb = ptIsSeaPtOrHb;
+        search.hbFound.assign(world.harbor_pos.size(), false);
+        std::vector<CalcHarborPosNeighborsNode>& todo_list = search.todo_list;
+        todo_list.clear();
+        HarborPos& startHb = world.harbor_pos[startHbId];
 
-        for(const MapPoint& ownCoastPt : ownCoastalPoints)
+        for(unsigned d = 0; d < Direction::COUNT; d++)
         {
+            if(!world.GetSeaId(startHbId, Direction::fromInt(d)))
+                continue;
+            const MapPoint ownCoastPt = world.GetNeighbour(startHb.pos, Direction::fromInt(d));
+            const unsigned idx = world.GetIdx(ownCoastPt);
+            // Our coast points are only marked if they are shared with other harbors
+            bool isShared = false;
             // Special case: Get all harbors that share the coast point with us
-            unsigned short seaId = world.GetSeaFromCoastalPoint(ownCoastPt);
-            auto const coastToHbs = coastToHarborPerSea[seaId].equal_range(world.GetIdx(ownCoastPt));
+            const auto coastToHbs = coastToHarbor.equal_range(idx);
             for(auto it = coastToHbs.first; it != coastToHbs.second; ++it)
             {
+                if(it->second == startHbId)
+                    continue;
                 ShipDirection shipDir = world.GetShipDir(ownCoastPt, ownCoastPt);
-                world.harbor_pos[startHbId].neighbors[shipDir.toUInt()].push_back(HarborPos::Neighbor(it->second, 0));
-                hbFound[it->second] = true;
+                startHb.neighbors[shipDir.toUInt()].push_back(HarborPos::Neighbor(it->second, 0));
+                search.hbFound[it->second] = true;
+                isShared = true;
             }
-            todo_list.push(CalcHarborPosNeighborsNode(ownCoastPt, 0));
+            if(!isShared)
+                search.ptToVisitOrHb[idx] = 0;
+            todo_list.push_back(CalcHarborPosNeighborsNode(ownCoastPt, 0));
         }
 
-        while(!todo_list.empty()) // as long as there are sea points on our todo list...
+        for(unsigned i = 0; i < todo_list.size(); i++) // as long as there are sea points on our todo list...
         {
-            CalcHarborPosNeighborsNode curNode = todo_list.front();
-            todo_list.pop();
+            const CalcHarborPosNeighborsNode curNode = todo_list[i];
 
             for(unsigned dir = 0; dir < Direction::COUNT; ++dir)
             {
                 MapPoint curPt = world.GetNeighbour(curNode.pos, Direction::fromInt(dir));
                 unsigned idx = world.GetIdx(curPt);
 
-                int ptValue = ptToVisitOrHb[idx];
+                int ptValue = search.ptToVisitOrHb[idx];
                 // Already visited
                 if(ptValue == 0)
                     continue;
@@ -600,34 +608,36 @@ void MapLoader::CalcHarborPosNeighbors(World& world)
 
                 if(ptValue > 0) // found harbor(s)
                 {
-                    ShipDirection shipDir = world.GetShipDir(world.harbor_pos[startHbId].pos, curPt);
-                    unsigned seaId = world.GetSeaFromCoastalPoint(curPt);
-                    auto const coastToHbs = coastToHarborPerSea[seaId].equal_range(idx);
+                    ShipDirection shipDir = world.GetShipDir(startHb.pos, curPt);
+                    auto const coastToHbs = coastToHarbor.equal_range(idx);
                     for(auto it = coastToHbs.first; it != coastToHbs.second; ++it)
                     {
                         unsigned otherHbId = it->second;
-                        if(hbFound[otherHbId])
+                        if(otherHbId == startHbId || search.hbFound[otherHbId])
                             continue;
 
-                        hbFound[otherHbId] = true;
-                        world.harbor_pos[startHbId].neighbors[shipDir.toUInt()].push_back(
-                          HarborPos::Neighbor(otherHbId, curNode.distance + 1));
-
-                        // Make this the only coastal point of this harbor for this sea
-                        HarborPos& otherHb = world.harbor_pos[otherHbId];
-                        RTTR_Assert(seaId);
-                        for(unsigned hbDir = 0; hbDir < Direction::COUNT; ++hbDir)
-                        {
-                            if(otherHb.cps[hbDir].seaId == seaId && world.GetNeighbour(otherHb.pos, Direction::fromInt(hbDir)) != curPt)
-                                otherHb.cps[hbDir].seaId = 0;
-                        }
+                        search.hbFound[otherHbId] = true;
+                        startHb.neighbors[shipDir.toUInt()].push_back(HarborPos::Neighbor(otherHbId, curNode.distance + 1));
+                        // There is only 1 coastal point per harbor and sea, so this is the one used for this sea
+                        RTTR_Assert(world.GetCoastalPoint(otherHbId, world.GetSeaFromCoastalPoint(curPt)) == curPt);
                     }
                 }
-                todo_list.push(CalcHarborPosNeighborsNode(curPt, curNode.distance + 1));
-                ptToVisitOrHb[idx] = 0; // mark as visited, so we do not go here again
+                todo_list.push_back(CalcHarborPosNeighborsNode(curPt, curNode.distance + 1));
+                search.ptToVisitOrHb[idx] = 0; // mark as visited, so we do not go here again
             }
         }
-    }
+    };
+
+    const unsigned numHarbors = world.harbor_pos.size() - 1;
+    if(numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, numHarbors);
+    std::atomic<unsigned> nextHbId(1);
+    helpers::runParallel(numThreads, numThreads, [&searchNeighbors, &nextHbId, numHarbors](unsigned) {
+        HarborNeighborSearch search;
+        for(unsigned hbId = nextHbId++; hbId <= numHarbors; hbId = nextHbId++)
+            searchNeighbors(hbId, search);
+    });
 }
 
 /// Vermisst ein neues Weltmeer von einem Punkt aus, indem es alle mit diesem Punkt verbundenen
@@ -43,7 +43,6 @@ class MapLoader
     /// Vermisst ein neues Weltmeer von einem Punkt aus, indem es alle mit diesem Punkt verbundenen
     /// Wasserpunkte mit der gleichen seaId belegt und die Anzahl zurückgibt
     static unsigned MeasureSea(World& world, MapPoint start, unsigned short seaId);
-    static void CalcHarborPosNeighbors(World& world);
 
 public:
     /// Construct a loader for the given world.
@@ -59,6 +58,8 @@ public:
     static void InitShadows(World& world);
     static void SetMapExplored(World& world);
     static bool InitSeasAndHarbors(World& world, const std::vector<MapPoint>& additionalHarbors = std::vector<MapPoint>());
+    /// Calculate the distance from each harbor to the others using the given number of threads (0 = one per core)
+    static void CalcHarborPosNeighbors(World& world, unsigned numThreads = 0);
     static bool PlaceHQs(GameWorldBase& world, std::vector<MapPoint> hqPositions, bool randomStartPos);
 };
 
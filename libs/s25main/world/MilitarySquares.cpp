@@ -18,80 +18,65 @@
 #include "rttrDefines.h" // IWYU pragma: keep
 #include "world/MilitarySquares.h"
 #include "buildings/nobBaseMilitary.h"
-#include "helpers/containerUtils.h"
+#include "buildings/nobUsual.h"
+#include "nodeObjs/noShip.h"
 #include "gameData/MilitaryConsts.h"
 
-MilitarySquares::MilitarySquares() : size_(MapExtent::all(0)) {}
-
 void MilitarySquares::Init(const MapExtent& mapSize)
 {
-    RTTR_Assert(size_ == MapExtent::all(0));     // Already initialized
-    RTTR_Assert(mapSize.x > 0 && mapSize.y > 0); // No empty map
-    // Calculate size (rounding up)
-    size_ = (mapSize + MapExtent::all(MILITARY_SQUARE_SIZE - 1)) / MILITARY_SQUARE_SIZE;
-    squares.resize(size_.x * size_.y);
+    buildings.Init(mapSize, MILITARY_SQUARE_SIZE);
+    lookoutTowers.Init(mapSize, MILITARY_SQUARE_SIZE);
+    ships.Init(mapSize, MILITARY_SQUARE_SIZE);
 }
 
 void MilitarySquares::Clear()
 {
-    squares.clear();
-    size_ = MapExtent::all(0);
-}
-
-std::list<nobBaseMilitary*>& MilitarySquares::GetSquare(const MapPoint pt)
-{
-    MapPoint milPt = pt / MILITARY_SQUARE_SIZE;
-    return squares[milPt.y * size_.x + milPt.x];
+    buildings.Clear();
+    lookoutTowers.Clear();
+    ships.Clear();
 }
 
 void MilitarySquares::Add(nobBaseMilitary* const bld)
 {
-    GetSquare(bld->GetPos()).push_back(bld);
+    buildings.Add(bld, bld->GetPos(), bld->GetPlayer());
 }
 
 void MilitarySquares::Remove(nobBaseMilitary* const bld)
 {
-    RTTR_Assert(helpers::contains(GetSquare(bld->GetPos()), bld));
-    GetSquare(bld->GetPos()).remove(bld);
+    buildings.Remove(bld, bld->GetPos());
 }
 
-sortedMilitaryBlds MilitarySquares::GetBuildingsInRange(const MapPoint pt, unsigned short radius) const
+void MilitarySquares::AddLookoutTower(nobUsual* const tower)
 {
-    // maximum radius is half the size (rounded up) to avoid overlapping
-    const Position offsets = elMin((size_ + Position::all(1)) / 2, Position::all(radius));
+    RTTR_Assert(tower->GetBuildingType() == BLD_LOOKOUTTOWER);
+    lookoutTowers.Add(tower, tower->GetPos(), tower->GetPlayer());
+}
 
-    // Convert to military coords
-    const Position milPos(pt / MILITARY_SQUARE_SIZE);
+void MilitarySquares::RemoveLookoutTower(nobUsual* const tower)
+{
+    lookoutTowers.Remove(tower, tower->GetPos());
+}
 
-    const Position firstPt = milPos - offsets;
-    const Position lastPt = milPos + offsets;
+void MilitarySquares::AddShip(noShip* const ship, const MapPoint pt)
+{
+    ships.Add(ship, pt, ship->GetPlayerId());
+}
 
-    // List with unique(!) military buildings
-    sortedMilitaryBlds buildings;
+void MilitarySquares::RemoveShip(noShip* const ship, const MapPoint pt)
+{
+    ships.Remove(ship, pt);
+}
 
-    // Create list
-    for(int cy = firstPt.y; cy <= lastPt.y; ++cy)
-    {
-        // Handle wrap-around
-        int realY = cy;
-        if(realY < 0)
-            realY += size_.y;
-        else if(realY >= static_cast<int>(size_.y))
-            realY -= size_.y;
-        RTTR_Assert(realY >= 0 && realY < static_cast<int>(size_.y));
-        for(int cx = firstPt.x; cx <= lastPt.x; ++cx)
-        {
-            int realX = cx;
-            if(realX < 0)
-                realX += size_.x;
-            else if(realX >= static_cast<int>(size_.x))
-                realX -= size_.x;
-            RTTR_Assert(realX >= 0 && realX < static_cast<int>(size_.x));
-            const std::list<nobBaseMilitary*>& milBuildings = squares[realY * size_.x + realX];
-            for(auto milBuilding : milBuildings)
-                buildings.insert(milBuilding);
-        }
-    }
+unsigned short MilitarySquares::GetSquareRadius(const unsigned distance)
+{
+    // The last square in each direction may be only partially on the map.
+    // So a point across the map border can be one square further away than its distance suggests
+    return static_cast<unsigned short>((distance + MILITARY_SQUARE_SIZE - 2) / MILITARY_SQUARE_SIZE + 1);
+}
 
-    return buildings;
+sortedMilitaryBlds MilitarySquares::GetBuildingsInRange(const MapPoint pt, unsigned short radius) const
+{
+    sortedMilitaryBlds result;
+    buildings.VisitObjectsInRange(pt, radius, [&result](nobBaseMilitary* bld) { result.insert(bld); });
+    return result;
 }
@@ -18,28 +18,63 @@
 #ifndef MilitarySquares_h__
 #define MilitarySquares_h__
 
+#include "world/SpatialGrid.h"
 #include "gameTypes/MapCoordinates.h"
-#include <list>
-#include <vector>
 
 class nobBaseMilitary;
+class nobUsual;
+class noShip;
 class sortedMilitaryBlds;
 
+/// Index of the objects which hold land or let their owner see the map, sorted into military squares:
+/// Military buildings (including HQs and harbors), occupied lookout towers and ships
 class MilitarySquares
 {
-    /// military buildings (including HQs and harbors) per military square
-    std::vector<std::list<nobBaseMilitary*>> squares;
-    MapExtent size_;
-    // Liefert das entsprechende Militärquadrat für einen bestimmten Punkt auf der Karte zurück (normale Koordinaten)
-    std::list<nobBaseMilitary*>& GetSquare(MapPoint pt);
+    SpatialGrid<nobBaseMilitary> buildings;
+    SpatialGrid<nobUsual> lookoutTowers;
+    SpatialGrid<noShip> ships;
 
 public:
-    MilitarySquares();
     void Init(const MapExtent& mapSize);
     void Clear();
     void Add(nobBaseMilitary* bld);
     void Remove(nobBaseMilitary* bld);
+    void AddLookoutTower(nobUsual* tower);
+    void RemoveLookoutTower(nobUsual* tower);
+    /// Ships move, so their position is passed explicitly
+    void AddShip(noShip* ship, MapPoint pt);
+    void RemoveShip(noShip* ship, MapPoint pt);
+
+    /// Return the number of squares to search so that all objects at most distance nodes away from a point are found
+    static unsigned short GetSquareRadius(unsigned distance);
+
+    /// Return the buildings within radius military squares, sorted so iterating them gives the same order on all clients
     sortedMilitaryBlds GetBuildingsInRange(MapPoint pt, unsigned short radius) const;
+    /// Call functor(bld) for the same buildings as GetBuildingsInRange without creating a container.
+    /// The order is unspecified, so the functor must not do anything depending on it (e.g. changing the game state)
+    template<class T_Functor>
+    void VisitBuildingsInRange(MapPoint pt, unsigned short radius, T_Functor&& functor) const
+    {
+        buildings.VisitObjectsInRange(pt, radius, functor);
+    }
+    /// Same as VisitBuildingsInRange but only for the buildings of the given player
+    template<class T_Functor>
+    void VisitBuildingsInRange(MapPoint pt, unsigned short radius, unsigned char player, T_Functor&& functor) const
+    {
+        buildings.VisitObjectsInRange(pt, radius, player, functor);
+    }
+    /// Call functor(tower) for the occupied lookout towers of the player within radius military squares in unspecified order
+    template<class T_Functor>
+    void VisitLookoutTowersInRange(MapPoint pt, unsigned short radius, unsigned char player, T_Functor&& functor) const
+    {
+        lookoutTowers.VisitObjectsInRange(pt, radius, player, functor);
+    }
+    /// Call functor(ship) for the ships of the player within radius military squares in unspecified order
+    template<class T_Functor>
+    void VisitShipsInRange(MapPoint pt, unsigned short radius, unsigned char player, T_Functor&& functor) const
+    {
+        ships.VisitObjectsInRange(pt, radius, player, functor);
+    }
 };
 
 #endif // MilitarySquares_h__
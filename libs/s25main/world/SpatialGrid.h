@@ -0,0 +1,154 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SpatialGrid_h__
+#define SpatialGrid_h__
+
+#include "RTTR_Assert.h"
+#include "gameTypes/MapCoordinates.h"
+#include <algorithm>
+#include <vector>
+
+/// Sorts objects into square cells of the map so the ones near a point can be found without checking all of them.
+/// The objects of a cell are stored contiguously in no specific order together with their owner,
+/// so queries for one player skip the others without accessing them
+template<class T>
+class SpatialGrid
+{
+public:
+    SpatialGrid() : cellSize_(1), size_(MapExtent::all(0)) {}
+
+    void Init(const MapExtent& mapSize, unsigned short cellSize);
+    void Clear();
+    void Add(T* obj, MapPoint pt, unsigned char player);
+    void Remove(T* obj, MapPoint pt);
+
+    /// Call functor(obj) once for every object in the cells at most radius cells away from the cell containing pt
+    template<class T_Functor>
+    void VisitObjectsInRange(MapPoint pt, unsigned short radius, T_Functor&& functor) const;
+    /// Same as VisitObjectsInRange but only for the objects of the given player
+    template<class T_Functor>
+    void VisitObjectsInRange(MapPoint pt, unsigned short radius, unsigned char player, T_Functor&& functor) const;
+
+private:
+    struct Entry
+    {
+        T* obj;
+        unsigned char player;
+    };
+
+    std::vector<Entry>& GetCell(MapPoint pt);
+    /// Call functor(entry) for all entries in the cells at most radius cells away from the cell containing pt
+    template<class T_Functor>
+    void VisitEntriesInRange(MapPoint pt, unsigned short radius, T_Functor&& functor) const;
+
+    std::vector<std::vector<Entry>> cells_;
+    unsigned short cellSize_;
+    /// Size in cells
+    MapExtent size_;
+};
+
+template<class T>
+void SpatialGrid<T>::Init(const MapExtent& mapSize, unsigned short cellSize)
+{
+    RTTR_Assert(size_ == MapExtent::all(0));     // Already initialized
+    RTTR_Assert(mapSize.x > 0 && mapSize.y > 0); // No empty map
+    cellSize_ = cellSize;
+    // Calculate size (rounding up)
+    size_ = (mapSize + MapExtent::all(cellSize - 1)) / cellSize;
+    cells_.resize(size_.x * size_.y);
+}
+
+template<class T>
+void SpatialGrid<T>::Clear()
+{
+    cells_.clear();
+    size_ = MapExtent::all(0);
+}
+
+template<class T>
+std::vector<typename SpatialGrid<T>::Entry>& SpatialGrid<T>::GetCell(const MapPoint pt)
+{
+    const MapPoint cellPt = pt / cellSize_;
+    return cells_[cellPt.y * size_.x + cellPt.x];
+}
+
+template<class T>
+void SpatialGrid<T>::Add(T* obj, const MapPoint pt, const unsigned char player)
+{
+    std::vector<Entry>& cell = GetCell(pt);
+    RTTR_Assert(std::none_of(cell.begin(), cell.end(), [obj](const Entry& entry) { return entry.obj == obj; }));
+    cell.push_back(Entry{obj, player});
+}
+
+template<class T>
+void SpatialGrid<T>::Remove(T* obj, const MapPoint pt)
+{
+    std::vector<Entry>& cell = GetCell(pt);
+    const auto it = std::find_if(cell.begin(), cell.end(), [obj](const Entry& entry) { return entry.obj == obj; });
+    RTTR_Assert(it != cell.end());
+    if(it == cell.end())
+        return;
+    // Order is irrelevant -> Replace by last one
+    *it = cell.back();
+    cell.pop_back();
+}
+
+template<class T>
+template<class T_Functor>
+void SpatialGrid<T>::VisitObjectsInRange(const MapPoint pt, unsigned short radius, T_Functor&& functor) const
+{
+    VisitEntriesInRange(pt, radius, [&functor](const Entry& entry) { functor(entry.obj); });
+}
+
+template<class T>
+template<class T_Functor>
+void SpatialGrid<T>::VisitObjectsInRange(const MapPoint pt, unsigned short radius, const unsigned char player, T_Functor&& functor) const
+{
+    VisitEntriesInRange(pt, radius, [player, &functor](const Entry& entry) {
+        if(entry.player == player)
+            functor(entry.obj);
+    });
+}
+
+template<class T>
+template<class T_Functor>
+void SpatialGrid<T>::VisitEntriesInRange(const MapPoint pt, unsigned short radius, T_Functor&& functor) const
+{
+    const Position cellPos(pt / cellSize_);
+    // Visit each cell only once even if the range is bigger than the map
+    const Position numCells = elMin(Position(size_), Position::all(2 * radius + 1));
+    const Position firstPt = cellPos - Position::all(radius);
+
+    for(int dy = 0; dy < numCells.y; ++dy)
+    {
+        // Handle wrap-around
+        int realY = (firstPt.y + dy) % static_cast<int>(size_.y);
+        if(realY < 0)
+            realY += size_.y;
+        for(int dx = 0; dx < numCells.x; ++dx)
+        {
+            int realX = (firstPt.x + dx) % static_cast<int>(size_.x);
+            if(realX < 0)
+                realX += size_.x;
+            for(const Entry& entry : cells_[realY * size_.x + realX])
+                functor(entry);
+        }
+    }
+}
+
+#endif // SpatialGrid_h__
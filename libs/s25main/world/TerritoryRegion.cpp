@@ -22,6 +22,7 @@
 #include "buildings/noBaseBuilding.h"
 #include "buildings/nobMilitary.h"
 #include "world/GameWorldBase.h"
+#include <algorithm>
 #include <stdexcept>
 
 TerritoryRegion::TerritoryRegion(const Position& startPt, const Extent& size, const GameWorldBase& gwb)
@@ -145,14 +146,28 @@ bool TerritoryRegion::AdjustCoords(Position& pt) const
 }
 
 namespace {
-struct GetMapPointWithRadius
+/// Return the distance of the coordinate to the range [0, length) which may wrap around the map border
+unsigned GetDistanceToRange(int coord, unsigned length, unsigned mapLength)
 {
-    using result_type = std::pair<MapPoint, unsigned>;
-
-    result_type operator()(const MapPoint pt, unsigned r) { return std::make_pair(pt, r); }
-};
+    coord %= static_cast<int>(mapLength);
+    if(coord < 0)
+        coord += mapLength;
+    const auto uCoord = static_cast<unsigned>(coord);
+    if(uCoord < length)
+        return 0;
+    // Distance to the last point or to the first point when going around the map border
+    return std::min(uCoord - (length - 1), mapLength - uCoord);
+}
 } // namespace
 
+bool TerritoryRegion::IsInRange(const MapPoint& pt, unsigned radius) const
+{
+    // Each step changes x and y by at most 1, so points in the radius are within radius rows and columns
+    const Position relPos = GetPosFromMapPos(pt);
+    return GetDistanceToRange(relPos.x, size.x, world.GetWidth()) <= radius
+           && GetDistanceToRange(relPos.y, size.y, world.GetHeight()) <= radius;
+}
+
 void TerritoryRegion::CalcTerritoryOfBuilding(const noBaseBuilding& building)
 {
     unsigned radius = building.GetMilitaryRadius();
@@ -169,11 +184,18 @@ void TerritoryRegion::CalcTerritoryOfBuilding(const noBaseBuilding& building)
 
     // Punkt, auf dem das Militärgebäude steht
     MapPoint bldPos = building.GetPos();
+    // Buildings too far away can't change anything
+    if(!IsInRange(bldPos, radius))
+        return;
     AdjustNode(bldPos, building.GetPlayer(), 0, nullptr); // no need to check barriers here. this point is on our territory.
 
-    std::vector<GetMapPointWithRadius::result_type> pts = world.GetPointsInRadius(bldPos, radius, GetMapPointWithRadius());
-    for(const auto& ptWithRadius : pts)
-        AdjustNode(ptWithRadius.first, building.GetPlayer(), ptWithRadius.second, allowedArea);
+    // Visit the points in the same order as GetPointsInRadius but without creating a list of them
+    world.CheckPointsInRadius(bldPos, radius,
+                              [this, &building, allowedArea](const MapPoint curPt, unsigned curRadius) {
+                                  AdjustNode(curPt, building.GetPlayer(), curRadius, allowedArea);
+                                  return false;
+                              },
+                              false);
 }
 
 uint8_t TerritoryRegion::SafeGetOwner(const Position& pt) const
@@ -39,6 +39,8 @@ public:
 
     /// Adds the territory of the building
     void CalcTerritoryOfBuilding(const noBaseBuilding& building);
+    /// Return true, if a building at the given position with the given military radius can own points in this region
+    bool IsInRange(const MapPoint& pt, unsigned radius) const;
 
     unsigned GetIdx(const Position& pt) const;
     Position GetPosFromMapPos(const MapPoint& pt) const;
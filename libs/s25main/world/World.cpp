@@ -31,6 +31,40 @@
 #include <set>
 #include <stdexcept>
 
+namespace {
+/// Parts of a node contained in the state hash, stored in the lowest bits of the key
+enum NodeHashPart
+{
+    NHP_OWNER,
+    NHP_ROAD,
+    NHP_OBJECT = NHP_ROAD + 3
+};
+
+uint64_t GetNodeHashKey(unsigned idx, unsigned part)
+{
+    return (static_cast<uint64_t>(idx) << 3) | part;
+}
+
+uint64_t GetObjHashValue(const noBase* obj)
+{
+    return obj ? obj->GetObjId() : 0u;
+}
+
+StateHash HashNodes(const std::vector<MapNode>& nodes)
+{
+    StateHash hash;
+    for(unsigned idx = 0; idx < nodes.size(); ++idx)
+    {
+        const MapNode& node = nodes[idx];
+        hash.Add(GetNodeHashKey(idx, NHP_OWNER), node.owner);
+        for(unsigned dir = 0; dir < node.roads.size(); ++dir)
+            hash.Add(GetNodeHashKey(idx, NHP_ROAD + dir), node.roads[dir]);
+        hash.Add(GetNodeHashKey(idx, NHP_OBJECT), GetObjHashValue(node.obj));
+    }
+    return hash;
+}
+} // namespace
+
 World::World() : noNodeObj(nullptr) {}
 
 World::~World()
@@ -105,6 +139,7 @@ void World::Resize(const MapExtent& newSize)
     MapBase::Resize(newSize);
     nodes.clear();
     militarySquares.Clear();
+    stateHash_.Clear();
     if(GetSize().x > 0)
     {
         nodes.resize(prodOfComponents(GetSize()));
@@ -120,6 +155,7 @@ void World::AddFigure(const MapPoint pt, noBase* fig)
     std::list<noBase*>& figures = GetNodeInt(pt).figures;
     RTTR_Assert(!helpers::contains(figures, fig));
     figures.push_back(fig);
+    FigureAdded(pt, *fig);
 
 #if RTTR_ENABLE_ASSERTS
     for(unsigned char i = 0; i < 6; ++i)
@@ -134,6 +170,7 @@ void World::RemoveFigure(const MapPoint pt, noBase* fig)
 {
     RTTR_Assert(helpers::contains(GetNode(pt).figures, fig));
     GetNodeInt(pt).figures.remove(fig);
+    FigureRemoved(pt, *fig);
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -158,7 +195,10 @@ void World::SetNO(const MapPoint pt, noBase* obj, const bool replace /* = false*
 #if RTTR_ENABLE_ASSERTS
     RTTR_Assert(!dynamic_cast<noMovable*>(obj)); // It should be a static, non-movable object
 #endif
-    GetNodeInt(pt).obj = obj;
+    MapNode& node = GetNodeInt(pt);
+    stateHash_.Change(GetNodeHashKey(GetIdx(pt), NHP_OBJECT), GetObjHashValue(node.obj), GetObjHashValue(obj));
+    node.obj = obj;
+    PassabilityChanged(pt);
 }
 
 void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
@@ -168,9 +208,11 @@ void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
     {
         // Destroy may remove the NO already from the map or replace it (e.g. building -> fire)
         // So remove from map, then destroy and free
+        stateHash_.Remove(GetNodeHashKey(GetIdx(pt), NHP_OBJECT), GetObjHashValue(obj));
         GetNodeInt(pt).obj = nullptr;
         obj->Destroy();
         deletePtr(obj);
+        PassabilityChanged(pt);
     } else
         RTTR_Assert(!checkExists);
 }
@@ -192,6 +234,13 @@ void World::ReduceResource(const MapPoint pt)
     GetNodeInt(pt).resources.setAmount(curAmount - 1u);
 }
 
+void World::SetOwner(const MapPoint pt, unsigned char newOwner)
+{
+    MapNode& node = GetNodeInt(pt);
+    stateHash_.Change(GetNodeHashKey(GetIdx(pt), NHP_OWNER), node.owner, newOwner);
+    node.owner = newOwner;
+}
+
 void World::SetReserved(const MapPoint pt, const bool reserved)
 {
     RTTR_Assert(GetNodeInt(pt).reserved != reserved);
@@ -445,7 +494,11 @@ unsigned short World::GetSeaFromCoastalPoint(const MapPoint pt) const
 void World::SetRoad(const MapPoint pt, unsigned char roadDir, unsigned char type)
 {
     RTTR_Assert(roadDir < 3);
-    GetNodeInt(pt).roads[roadDir] = type;
+    unsigned char& road = GetNodeInt(pt).roads[roadDir];
+    stateHash_.Change(GetNodeHashKey(GetIdx(pt), NHP_ROAD + roadDir), road, type);
+    road = type;
+    PassabilityChanged(pt);
+    PassabilityChanged(GetNeighbour(pt, Direction::fromInt(roadDir + 3)));
 }
 
 bool World::SetBQ(const MapPoint pt, BuildingQuality bq)
@@ -470,3 +523,13 @@ void World::RecalcShadow(const MapPoint pt)
         shadingS2 = 0;
     GetNodeInt(pt).shadow = shadingS2;
 }
+
+unsigned World::CalcStateHash() const
+{
+    return HashNodes(nodes).Get();
+}
+
+void World::InitStateHash()
+{
+    stateHash_ = HashNodes(nodes);
+}
@@ -18,6 +18,7 @@
 #ifndef World_h__
 #define World_h__
 
+#include "StateHash.h"
 #include "world/MapBase.h"
 #include "world/MilitarySquares.h"
 #include "gameTypes/Direction.h"
@@ -66,6 +67,8 @@ class World : public MapBase
     WorldDescription description_;
 
     std::unique_ptr<noBase> noNodeObj;
+    /// Hash of the owners, roads and objects of all nodes
+    StateHash stateHash_;
     void Resize(const MapExtent& newSize) override final;
 
 public:
@@ -106,7 +109,7 @@ public:
     GO_Type GetGOT(MapPoint pt) const;
     void ReduceResource(MapPoint pt);
     void SetResource(const MapPoint pt, Resource newResource) { GetNodeInt(pt).resources = newResource; }
-    void SetOwner(const MapPoint pt, unsigned char newOwner) { GetNodeInt(pt).owner = newOwner; }
+    void SetOwner(MapPoint pt, unsigned char newOwner);
     void SetReserved(MapPoint pt, bool reserved);
     /// Sets the visibility and fires a Visibility Changed event if different
     /// fowTime is only used if visibility gets changed to FoW
@@ -188,6 +191,11 @@ public:
     void AddCatapultStone(CatapultStone* cs);
     void RemoveCatapultStone(CatapultStone* cs);
 
+    /// Return the hash of the owners, roads and objects of all nodes. It is updated on every change of those
+    unsigned GetStateHash() const { return stateHash_.Get(); }
+    /// Calculate the state hash from scratch. Differs from GetStateHash if a change was missed
+    unsigned CalcStateHash() const;
+
 protected:
     /// Internal method for access to nodes with write access
     MapNode& GetNodeInt(MapPoint pt);
@@ -197,6 +205,11 @@ protected:
     virtual void AltitudeChanged(MapPoint pt) = 0;
     /// Notify derived classes of changed visibility
     virtual void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) = 0;
+    /// Notify derived classes that the object or roads of the point were changed
+    virtual void PassabilityChanged(MapPoint pt) = 0;
+    /// Notify derived classes that a figure was added to or removed from the figures of the point
+    virtual void FigureAdded(MapPoint pt, noBase& fig) = 0;
+    virtual void FigureRemoved(MapPoint pt, noBase& fig) = 0;
     /// Sets the road for the given (road) direction
     void SetRoad(MapPoint pt, unsigned char roadDir, unsigned char type);
     BoundaryStones& GetBoundaryStones(const MapPoint pt) { return GetNodeInt(pt).boundary_stones; }
@@ -205,6 +218,8 @@ protected:
 
     /// Recalculates the shade of a point
     void RecalcShadow(MapPoint pt);
+    /// Recalculate the state hash after the nodes were set directly (e.g. when loading)
+    void InitStateHash();
 };
 
 //////////////////////////////////////////////////////////////////////////
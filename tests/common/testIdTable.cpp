@@ -0,0 +1,62 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+#include "commonDefines.h" // IWYU pragma: keep
+#include "helpers/IdTable.h"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(IdTableTests)
+
+BOOST_AUTO_TEST_CASE(SetAndGetValues)
+{
+    int values[3];
+    helpers::IdTable<int*, 4> table;
+    BOOST_TEST(table.size() == 0u);
+    BOOST_TEST(!table.get(0));
+    BOOST_TEST(!table.contains(100));
+
+    table.reserve(10);
+    table.insert(1, &values[0]);
+    // In another block with an unused block in between
+    table.insert(9, &values[1]);
+    table.insert(10, &values[2]);
+    BOOST_TEST(table.size() == 3u);
+    BOOST_TEST(table.get(1) == &values[0]);
+    BOOST_TEST(table.get(9) == &values[1]);
+    BOOST_TEST(table.get(10) == &values[2]);
+    for(unsigned id : {0u, 2u, 3u, 4u, 7u, 8u, 11u, 12u, 1000u})
+    {
+        BOOST_TEST(!table.get(id));
+        BOOST_TEST(!table.contains(id));
+    }
+
+    table.clear();
+    BOOST_TEST(table.size() == 0u);
+    BOOST_TEST(!table.contains(1));
+    BOOST_TEST(!table.contains(10));
+}
+
+BOOST_AUTO_TEST_CASE(BoolTable)
+{
+    helpers::IdTable<bool> table;
+    table.insert(5000, true);
+    BOOST_TEST(table.contains(5000));
+    BOOST_TEST(!table.contains(4999));
+    BOOST_TEST(!table.contains(5001));
+    BOOST_TEST(table.size() == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
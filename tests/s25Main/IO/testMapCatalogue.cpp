@@ -0,0 +1,142 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "MapCatalogue.h"
+#include "RttrConfig.h"
+#include "files.h"
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <ctime>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(MapCatalogueSuite)
+
+BOOST_AUTO_TEST_CASE(IndexMapHeaders)
+{
+    const bfs::path tmpPath = bfs::absolute(bfs::unique_path());
+    bfs::create_directories(tmpPath);
+    const std::string mapPath = (tmpPath / "map.swd").string();
+    const std::string brokenMapPath = (tmpPath / "broken.wld").string();
+    const std::string indexPath = (tmpPath / "index.dat").string();
+    bfs::copy_file(RTTRCONFIG.ExpandPath(std::string(FILE_PATHS[52]) + "/Bergruft.swd"), mapPath);
+    {
+        bnw::ofstream brokenMap(brokenMapPath);
+        brokenMap << "No map";
+    }
+    const std::vector<std::string> files{mapPath, brokenMapPath, (tmpPath / "missing.swd").string()};
+
+    MapCatalogue::Entry mapEntry;
+    {
+        MapCatalogue catalogue(indexPath);
+        BOOST_TEST(!catalogue.Load());
+        const std::vector<MapCatalogue::Entry> entries = catalogue.Update(files, 2);
+        BOOST_TEST_REQUIRE(entries.size() == files.size());
+        mapEntry = entries[0];
+        BOOST_TEST(mapEntry.filePath == mapPath);
+        BOOST_TEST(mapEntry.isValid);
+        BOOST_TEST(mapEntry.width == 176u);
+        BOOST_TEST(mapEntry.height == 80u);
+        BOOST_TEST(mapEntry.numPlayers == 4u);
+        BOOST_TEST(!mapEntry.name.empty());
+        BOOST_TEST(!mapEntry.hasLua);
+        BOOST_TEST(!entries[1].isValid);
+        BOOST_TEST(!entries[2].isValid);
+        // Missing files are not indexed
+        BOOST_TEST(catalogue.GetNumEntries() == 2u);
+        BOOST_TEST(catalogue.Save());
+    }
+
+    MapCatalogue catalogue(indexPath);
+    BOOST_TEST_REQUIRE(catalogue.Load());
+    BOOST_TEST(catalogue.GetNumEntries() == 2u);
+
+    // Replace the map by garbage of the same size and time so only the index can provide the header
+    const std::time_t writeTime = bfs::last_write_time(mapPath);
+    {
+        bnw::ofstream map(mapPath, std::ios::binary);
+        map << std::string(mapEntry.fileSize, 'x');
+        bnw::ofstream lua(bfs::path(mapPath).replace_extension("lua").string());
+        lua << "-- Script";
+    }
+    bfs::last_write_time(mapPath, writeTime);
+    std::vector<MapCatalogue::Entry> entries = catalogue.Update(files, 1);
+    BOOST_TEST_REQUIRE(entries.size() == files.size());
+    BOOST_TEST(entries[0].isValid);
+    BOOST_TEST(entries[0].name == mapEntry.name);
+    BOOST_TEST(entries[0].author == mapEntry.author);
+    BOOST_TEST(entries[0].width == mapEntry.width);
+    BOOST_TEST(entries[0].gfxSet == mapEntry.gfxSet);
+    // Lua script is always checked
+    BOOST_TEST(entries[0].hasLua);
+
+    // Changed files get read again
+    bfs::last_write_time(mapPath, writeTime + 10);
+    entries = catalogue.Update(files, 1);
+    BOOST_TEST_REQUIRE(entries.size() == files.size());
+    BOOST_TEST(!entries[0].isValid);
+
+    const std::atomic<bool> abort(true);
+    BOOST_TEST(catalogue.Update(files, 1, &abort).empty());
+
+    bfs::remove_all(tmpPath);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveMissingFiles)
+{
+    const bfs::path tmpPath = bfs::absolute(bfs::unique_path());
+    const bfs::path folder1 = tmpPath / "maps1", folder2 = tmpPath / "maps2";
+    bfs::create_directories(folder1);
+    bfs::create_directories(folder2);
+    const std::string srcMapPath = RTTRCONFIG.ExpandPath(std::string(FILE_PATHS[52]) + "/Bergruft.swd");
+    const std::string map1Path = (folder1 / "map1.swd").make_preferred().string();
+    const std::string map2Path = (folder1 / "map2.swd").make_preferred().string();
+    const std::string otherMapPath = (folder2 / "map.swd").make_preferred().string();
+    for(const std::string& mapPath : {map1Path, map2Path, otherMapPath})
+        bfs::copy_file(srcMapPath, mapPath);
+
+    MapCatalogue catalogue((tmpPath / "index.dat").string());
+    catalogue.Update({map1Path, map2Path, otherMapPath}, 1);
+    BOOST_TEST(catalogue.GetNumEntries() == 3u);
+    BOOST_TEST(catalogue.Save());
+
+    // Rename one map and delete the other
+    const std::string renamedMapPath = (folder1 / "renamed.swd").make_preferred().string();
+    bfs::rename(map1Path, renamedMapPath);
+    bfs::remove(map2Path);
+    const std::vector<std::string> files{renamedMapPath};
+    catalogue.Update(files, 1);
+    BOOST_TEST(catalogue.GetNumEntries() == 4u);
+    catalogue.RemoveMissing({folder1.string()}, files);
+    // Only the renamed map and the one in the other folder are left
+    BOOST_TEST(catalogue.GetNumEntries() == 2u);
+    BOOST_TEST(catalogue.Save());
+    BOOST_TEST_REQUIRE(catalogue.Load());
+    BOOST_TEST(catalogue.GetNumEntries() == 2u);
+
+    // Files which vanished since listing are removed on update
+    bfs::remove(otherMapPath);
+    catalogue.Update({otherMapPath}, 1);
+    BOOST_TEST(catalogue.GetNumEntries() == 1u);
+
+    bfs::remove_all(tmpPath);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
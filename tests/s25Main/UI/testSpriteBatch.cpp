@@ -0,0 +1,92 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "ogl/SpriteBatch.h"
+#include "uiHelper/uiHelpers.hpp"
+#include "s25util/colors.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+const SpriteBatch::Quad quad = {{{0, 0}, {0, 10}, {10, 10}, {10, 0}}};
+
+void addQuads(SpriteBatch& batch, const std::vector<unsigned>& textures)
+{
+    for(unsigned texture : textures)
+        batch.AddQuad(texture, quad, quad, COLOR_WHITE);
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SpriteBatchSuite, uiHelper::Fixture)
+
+BOOST_AUTO_TEST_CASE(QuadsOutsideBatchAreDrawnDirectly)
+{
+    SpriteBatch batch;
+    BOOST_TEST(!batch.IsActive());
+    addQuads(batch, {1, 1, 2});
+    batch.NextFrame();
+    const SpriteBatch::Statistics& stats = batch.GetLastFrameStatistics();
+    BOOST_TEST(stats.numQuads == 3u);
+    BOOST_TEST(stats.numDrawCalls == 3u);
+    BOOST_TEST(stats.numFlushes == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(QuadsWithSameTextureAreCombined)
+{
+    SpriteBatch batch;
+    batch.Begin();
+    BOOST_TEST(batch.IsActive());
+    addQuads(batch, {1, 1, 1, 2, 2, 1});
+    batch.End();
+    BOOST_TEST(!batch.IsActive());
+    // Outside of the batch again
+    addQuads(batch, {1});
+    batch.NextFrame();
+    BOOST_TEST(batch.GetLastFrameStatistics().numQuads == 7u);
+    BOOST_TEST(batch.GetLastFrameStatistics().numDrawCalls == 4u);
+    BOOST_TEST(batch.GetLastFrameStatistics().numFlushes == 3u);
+
+    // Statistics are per frame
+    batch.NextFrame();
+    BOOST_TEST(batch.GetLastFrameStatistics().numQuads == 0u);
+    BOOST_TEST(batch.GetLastFrameStatistics().numDrawCalls == 0u);
+
+    // Explicit flush splits the batch
+    batch.Begin();
+    addQuads(batch, {1, 1});
+    batch.Flush();
+    addQuads(batch, {1});
+    batch.End();
+    batch.NextFrame();
+    BOOST_TEST(batch.GetLastFrameStatistics().numDrawCalls == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(DisabledBatchDrawsDirectly)
+{
+    SpriteBatch batch;
+    batch.SetEnabled(false);
+    batch.Begin();
+    BOOST_TEST(!batch.IsActive());
+    addQuads(batch, {1, 1});
+    batch.End();
+    batch.NextFrame();
+    BOOST_TEST(batch.GetLastFrameStatistics().numDrawCalls == 2u);
+    BOOST_TEST(batch.GetLastFrameStatistics().numFlushes == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
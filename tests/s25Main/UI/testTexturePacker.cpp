@@ -21,6 +21,7 @@
 #include "uiHelper/uiHelpers.hpp"
 #include "libsiedler2/ArchivItem_Bitmap_Raw.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include "s25util/tmpFile.h"
 #include <boost/test/unit_test.hpp>
 #include <Rect.h>
 #include <array>
@@ -74,4 +75,63 @@ BOOST_AUTO_TEST_CASE(SizeAndPosCorrect)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SaveAndLoad)
+{
+    std::array<libsiedler2::ArchivItem_Bitmap_Raw, 3> bmps;
+    std::array<glSmartBitmap, 3> smartBmps;
+    glTexturePacker packer;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        libsiedler2::PixelBufferBGRA buffer(7 + i * 2, 5 + i, libsiedler2::ColorBGRA(0xFF00FF00 + i));
+        bmps[i].create(buffer);
+        smartBmps[i].add(&bmps[i]);
+        packer.add(smartBmps[i]);
+    }
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    // Saving requires the pixel data
+    BOOST_TEST_REQUIRE(packer.pack());
+    BOOST_TEST(!packer.save(tmpFile.filePath, 42));
+    glTexturePacker packer2;
+    for(glSmartBitmap& bmp : smartBmps)
+        packer2.add(bmp);
+    BOOST_TEST_REQUIRE(packer2.pack(true));
+    BOOST_TEST_REQUIRE(packer2.save(tmpFile.filePath, 42));
+
+    std::array<glSmartBitmap, 3> loadedBmps;
+    glTexturePacker loader;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        loadedBmps[i].add(&bmps[i]);
+        loader.add(loadedBmps[i]);
+    }
+    // Different key -> Files changed
+    BOOST_TEST(!loader.load(tmpFile.filePath, 43));
+    BOOST_TEST(!loadedBmps[0].isGenerated());
+    BOOST_TEST_REQUIRE(loader.load(tmpFile.filePath, 42));
+    BOOST_TEST_REQUIRE(loader.getTextures().size() == packer2.getTextures().size());
+    for(unsigned i = 0; i < loader.getTextures().size(); ++i)
+        BOOST_TEST((loader.getTextures()[i].getSize() == packer2.getTextures()[i].getSize()));
+    for(unsigned i = 0; i < loadedBmps.size(); ++i)
+    {
+        BOOST_TEST(loadedBmps[i].isGenerated());
+        BOOST_TEST(loadedBmps[i].getTexture() == loader.getTextures()[0].get());
+        BOOST_TEST((loadedBmps[i].texCoords == smartBmps[i].texCoords));
+    }
+
+    // Bitmaps not matching the saved ones are rejected
+    std::array<glSmartBitmap, 3> otherBmps;
+    glTexturePacker otherLoader;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        otherBmps[i].add(&bmps[bmps.size() - i - 1]);
+        otherLoader.add(otherBmps[i]);
+    }
+    BOOST_TEST(!otherLoader.load(tmpFile.filePath, 42));
+    glTexturePacker emptyLoader;
+    BOOST_TEST(!emptyLoader.load(tmpFile.filePath, 42));
+    BOOST_TEST(!emptyLoader.load(tmpFile.filePath + "invalid", 42));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,7 +16,10 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "rttrDefines.h" // IWYU pragma: keep
+#include "AsyncChecksum.h"
+#include "PointOutput.h"
 #include "ai/AIPlayer.h"
+#include "ai/AIRunner.h"
 #include "ai/aijh/AIPlayerJH.h"
 #include "buildings/noBuilding.h"
 #include "buildings/noBuildingSite.h"
@@ -24,12 +27,16 @@
 #include "buildings/nobMilitary.h"
 #include "factories/AIFactory.h"
 #include "factories/BuildingFactory.h"
+#include "random/Random.h"
 #include "worldFixtures/WorldWithGCExecution.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noTree.h"
 #include "gameData/BuildingProperties.h"
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <memory>
+#include <random>
+#include <stdexcept>
 
 // We need border land
 using BiggerWorldWithGCExecution = WorldWithGCExecution<1, 24, 22>;
@@ -214,4 +221,138 @@ BOOST_FIXTURE_TEST_CASE(ExpandWhenNoSpace, BiggerWorldWithGCExecution)
     BOOST_REQUIRE(containsBldType(bldSites, BLD_BARRACKS) || containsBldType(bldSites, BLD_GUARDHOUSE));
 }
 
+namespace {
+struct AIRunResult
+{
+    AsyncChecksum checksum;
+    unsigned numGCs = 0;
+};
+
+/// Let 3 AIs play for some GFs with the given number of threads running them
+AIRunResult runAIs(unsigned numThreads)
+{
+    RANDOM.Init(1337);
+    WorldWithGCExecution<3> fixture;
+    boost::ptr_vector<AIPlayer>& ais = fixture.game->aiPlayers_;
+    for(unsigned i = 0; i < fixture.world.GetNumPlayers(); i++)
+        fixture.game->AddAIPlayer(AIFactory::Create(AI::Info(AI::DEFAULT, AI::HARD), i, fixture.world));
+    AIRunner runner(numThreads);
+    AIRunResult result;
+    const unsigned numGFs = 1000;
+    for(unsigned gf = 0; gf < numGFs;)
+    {
+        std::vector<std::vector<gc::GameCommandPtr>> aiGcs;
+        for(AIPlayer& ai : ais)
+            aiGcs.push_back(ai.FetchGameCommands());
+        for(unsigned i = 0; i < 5; i++, gf++)
+        {
+            fixture.em.ExecuteNextGF();
+            runner.RunGF(ais, fixture.em.GetCurrentGF(), i == 0);
+        }
+        for(unsigned i = 0; i < ais.size(); i++)
+        {
+            for(gc::GameCommandPtr& gc : aiGcs[i])
+                gc->Execute(fixture.world, ais[i].GetPlayerId());
+            result.numGCs += aiGcs[i].size();
+        }
+    }
+    BOOST_TEST(runner.GetNumWorkers() == std::min(numThreads, 3u) - 1u);
+    for(const AIPlayer& ai : ais)
+    {
+        BOOST_TEST(ai.GetRunTimes().numRuns == numGFs);
+        BOOST_TEST((ai.GetRunTimes().max >= ai.GetRunTimes().last));
+    }
+    result.checksum = AsyncChecksum::create(*fixture.game);
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ParallelRunIsDeterministic)
+{
+    const AIRunResult serialResult = runAIs(1);
+    // The AIs did something
+    BOOST_TEST_REQUIRE(serialResult.numGCs > 0u);
+    for(unsigned numThreads : {2u, 3u, 8u})
+    {
+        const AIRunResult parallelResult = runAIs(numThreads);
+        BOOST_TEST_INFO("Threads: " << numThreads);
+        BOOST_TEST(parallelResult.numGCs == serialResult.numGCs);
+        BOOST_TEST_INFO("Threads: " << numThreads);
+        BOOST_TEST((parallelResult.checksum == serialResult.checksum));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelRunForwardsExceptions)
+{
+    struct ThrowingAI : public AIPlayer
+    {
+        ThrowingAI(unsigned char playerId, const GameWorldBase& gwb) : AIPlayer(playerId, gwb, AI::EASY) {}
+        void RunGF(unsigned, bool) override { throw std::runtime_error("Test"); }
+    };
+    WorldWithGCExecution<3> fixture;
+    boost::ptr_vector<AIPlayer>& ais = fixture.game->aiPlayers_;
+    fixture.game->AddAIPlayer(AIFactory::Create(AI::Info(AI::DEFAULT, AI::EASY), 0, fixture.world));
+    fixture.game->AddAIPlayer(std::make_unique<ThrowingAI>(1, fixture.world));
+    fixture.game->AddAIPlayer(AIFactory::Create(AI::Info(AI::DEFAULT, AI::EASY), 2, fixture.world));
+    AIRunner runner(2);
+    BOOST_CHECK_THROW(runner.RunGF(ais, 1, true), std::runtime_error);
+    // Runner is still usable
+    ais.erase(ais.begin() + 1);
+    BOOST_CHECK_NO_THROW(runner.RunGF(ais, 2, true));
+}
+
+namespace {
+std::chrono::nanoseconds changeResourceMap(NodeMapBase<int>& map, const std::vector<MapPoint>& pts, unsigned radius, bool useChangeAll)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    if(useChangeAll)
+        AIJH::AIResourceMap::ChangeAll(map, pts, radius, 1);
+    else
+    {
+        // Same as AIResourceMap::Change
+        const auto addValue = [&map, radius](const MapPoint curPt, unsigned distance) {
+            map[curPt] += radius - distance;
+            return false;
+        };
+        for(const MapPoint pt : pts)
+            map.CheckPointsInRadius(pt, radius, addValue, true);
+    }
+    return std::chrono::steady_clock::now() - startTime;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ResourceMapChangeAllMatchesChange)
+{
+    std::mt19937 rng(42);
+    // Includes maps smaller than the radius and odd widths
+    const std::vector<MapExtent> sizes{MapExtent(4, 4), MapExtent(10, 8), MapExtent(13, 12), MapExtent(6, 2), MapExtent(512, 512)};
+    for(const MapExtent size : sizes)
+    {
+        NodeMapBase<int> map, refMap;
+        map.Resize(size);
+        refMap.Resize(size);
+        std::vector<MapPoint> pts;
+        std::bernoulli_distribution hasResource(0.2);
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            if(hasResource(rng))
+                pts.push_back(pt);
+        }
+        for(unsigned radius : {2u, 5u, 8u})
+        {
+            const auto duration = changeResourceMap(map, pts, radius, true);
+            const auto refDuration = changeResourceMap(refMap, pts, radius, false);
+            BOOST_TEST_MESSAGE("Resource map " << size << " with radius " << radius << " took "
+                                               << std::chrono::duration_cast<std::chrono::microseconds>(duration).count()
+                                               << "us. Per point: "
+                                               << std::chrono::duration_cast<std::chrono::microseconds>(refDuration).count() << "us");
+            RTTR_FOREACH_PT(MapPoint, size)
+            {
+                BOOST_TEST_INFO("Size " << size << ", radius " << radius << ", point " << pt);
+                BOOST_TEST_REQUIRE(map[pt] == refMap[pt]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
 #include "world/GameWorldViewer.h"
 #include "nodeObjs/noFlag.h"
 #include "gameTypes/Direction_Output.h"
+#include "gameData/MilitaryConsts.h"
 #include "gameData/SettingTypeConv.h"
 #include <boost/test/unit_test.hpp>
 #include <iostream>
@@ -817,4 +818,33 @@ BOOST_FIXTURE_TEST_CASE(DestroyRoadsOnConquer, DestroyRoadsOnConquerFixture)
     }
 }
 
+using VisibilityFixture = AttackFixtureBase<1, 40, 40>;
+BOOST_FIXTURE_TEST_CASE(MilitaryBldVisibility, VisibilityFixture)
+{
+    ggs.exploration = EXP_FOGOFWAR;
+    const MapPoint bldPos = world.MakeMapPoint(hqPos[0] + Position(7, 0));
+    // Only seen by the military building
+    const MapPoint pt = world.MakeMapPoint(bldPos + Position(8, 0));
+    BOOST_REQUIRE_GT(world.CalcDistance(hqPos[0], pt), HQ_RADIUS + VISUALRANGE_MILITARY);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(pt, 0), VIS_INVISIBLE);
+
+    BOOST_REQUIRE(BuildingFactory::CreateBuilding(world, BLD_WATCHTOWER, bldPos, 0, NAT_ROMANS));
+    // Not occupied yet
+    world.MakeVisibleAroundPoint(pt, 0, 0);
+    world.RecalcVisibilitiesAroundPoint(pt, 0, 0, nullptr);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(pt, 0), VIS_FOW);
+
+    AddSoldiers(bldPos, 1, 0);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(pt, 0), VIS_VISIBLE);
+    world.RecalcVisibilitiesAroundPoint(pt, 0, 0, nullptr);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(pt, 0), VIS_VISIBLE);
+    // Points seen by the HQ stay visible
+    const MapPoint hqSeenPt = world.MakeMapPoint(hqPos[0] + Position(HQ_RADIUS, 0));
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(hqSeenPt, 0), VIS_VISIBLE);
+
+    world.DestroyNO(bldPos);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(pt, 0), VIS_FOW);
+    BOOST_REQUIRE_EQUAL(world.CalcVisiblityWithAllies(hqSeenPt, 0), VIS_VISIBLE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
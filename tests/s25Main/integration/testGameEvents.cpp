@@ -21,7 +21,13 @@
 #include "RTTR_AssertError.h"
 #include "worldFixtures/TestEventManager.h"
 #include <rttr/test/LogAccessor.hpp>
+#include <rttr/test/random.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
 
 BOOST_AUTO_TEST_SUITE(GameEventsTestSuite)
 
@@ -142,6 +148,32 @@ BOOST_AUTO_TEST_CASE(Reschedule)
     BOOST_REQUIRE_EQUAL(obj.handledEventIds.size(), 1u);
 }
 
+BOOST_AUTO_TEST_CASE(StateHashOfQueue)
+{
+    TestEventManager evMgr(0);
+    TestEventHandler obj;
+    const unsigned emptyHash = evMgr.GetStateHash();
+    BOOST_REQUIRE_EQUAL(emptyHash, evMgr.CalcStateHash());
+    evMgr.AddEvent(&obj, 5, 42);
+    const unsigned hash = evMgr.GetStateHash();
+    BOOST_REQUIRE_NE(hash, emptyHash);
+    BOOST_REQUIRE_EQUAL(hash, evMgr.CalcStateHash());
+    // Event outside of the timing wheel
+    const GameEvent* farEvent = evMgr.AddEvent(&obj, 5000, 43);
+    BOOST_REQUIRE_NE(evMgr.GetStateHash(), hash);
+    BOOST_REQUIRE_EQUAL(evMgr.GetStateHash(), evMgr.CalcStateHash());
+    evMgr.RemoveEvent(farEvent);
+    BOOST_REQUIRE_EQUAL(evMgr.GetStateHash(), hash);
+    // Same event at another GF
+    evMgr.RescheduleEvent(evMgr.GetObjEvents(obj).front(), 7);
+    BOOST_REQUIRE_NE(evMgr.GetStateHash(), hash);
+    BOOST_REQUIRE_EQUAL(evMgr.GetStateHash(), evMgr.CalcStateHash());
+    while(obj.handledEventIds.empty())
+        evMgr.ExecuteNextGF();
+    BOOST_REQUIRE_EQUAL(evMgr.GetCurrentGF(), 7u);
+    BOOST_REQUIRE_EQUAL(evMgr.GetStateHash(), emptyHash);
+}
+
 class TestLogKill : public GameObject
 {
 public:
@@ -223,6 +255,157 @@ BOOST_AUTO_TEST_CASE(RemoveEvent)
     BOOST_CHECK(!evMgr.ObjectHasEvents(obj));
 }
 
+namespace {
+/// Scheduler as used before the timing wheel: Map of GF to list of separately allocated events
+class ReferenceEventManager
+{
+    std::map<unsigned, std::list<const GameEvent*>> events;
+    unsigned currentGF = 0, instanceCtr = 1;
+
+public:
+    ~ReferenceEventManager()
+    {
+        for(auto& it : events)
+        {
+            for(const GameEvent* ev : it.second)
+                delete ev;
+        }
+    }
+    unsigned GetCurrentGF() const { return currentGF; }
+    const GameEvent* AddEvent(GameObject* obj, unsigned gf_length, unsigned id)
+    {
+        const auto* ev = new GameEvent(instanceCtr++, obj, currentGF, gf_length, id);
+        events[ev->GetTargetGF()].push_back(ev);
+        return ev;
+    }
+    void RemoveEvent(const GameEvent*& ep)
+    {
+        auto& curEvents = events[ep->GetTargetGF()];
+        curEvents.remove(ep);
+        if(curEvents.empty())
+            events.erase(ep->GetTargetGF());
+        deletePtr(ep);
+    }
+    void ExecuteNextGF()
+    {
+        ++currentGF;
+        if(events.empty() || events.begin()->first != currentGF)
+            return;
+        auto& curEvents = events.begin()->second;
+        for(auto it = curEvents.begin(); it != curEvents.end(); it = curEvents.erase(it))
+        {
+            (*it)->obj->HandleEvent((*it)->id);
+            delete *it;
+        }
+        events.erase(events.begin());
+    }
+};
+
+/// Adds new events with random lengths on each event and removes pending events at random
+template<class T_EventManager>
+class RandomEventHandler : public TestEventHandler
+{
+public:
+    T_EventManager& em;
+    std::vector<const GameEvent*> pendingEvents;
+    std::mt19937 rng;
+    unsigned nextId = 0;
+
+    RandomEventHandler(T_EventManager& em, unsigned seed) : em(em), rng(seed) {}
+
+    void AddRandomEvent()
+    {
+        // Mostly short (walking) events with some long running ones
+        const unsigned length = (rng() % 8u == 0u) ? 1 + rng() % 5000u : 1 + rng() % 40u;
+        pendingEvents.push_back(em.AddEvent(this, length, nextId++));
+    }
+
+    void HandleEvent(unsigned evId) override
+    {
+        TestEventHandler::HandleEvent(evId);
+        pendingEvents.erase(std::remove_if(pendingEvents.begin(), pendingEvents.end(),
+                                           [this](const GameEvent* ev) { return ev->GetTargetGF() == em.GetCurrentGF(); }),
+                            pendingEvents.end());
+        AddRandomEvent();
+        if(rng() % 4u == 0u)
+            AddRandomEvent();
+        if(!pendingEvents.empty() && rng() % 3u == 0u)
+        {
+            const unsigned idx = rng() % pendingEvents.size();
+            // Cannot remove events of the current GF as one might be active
+            if(pendingEvents[idx]->GetTargetGF() != em.GetCurrentGF())
+            {
+                em.RemoveEvent(pendingEvents[idx]);
+                pendingEvents.erase(pendingEvents.begin() + idx);
+            }
+        }
+    }
+};
+
+template<class T_EventManager>
+std::chrono::nanoseconds runRandomEvents(T_EventManager& em, RandomEventHandler<T_EventManager>& handler, unsigned numGFs)
+{
+    for(unsigned i = 0; i < 2000; i++)
+        handler.AddRandomEvent();
+    const auto startTime = std::chrono::steady_clock::now();
+    for(unsigned gf = 0; gf < numGFs; gf++)
+        em.ExecuteNextGF();
+    return std::chrono::steady_clock::now() - startTime;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(SameOrderAsReference)
+{
+    const unsigned seed = rttr::test::randomValue<unsigned>();
+    const unsigned numGFs = 10000;
+    EventManager evMgr(0);
+    RandomEventHandler<EventManager> obj(evMgr, seed);
+    ReferenceEventManager refEvMgr;
+    RandomEventHandler<ReferenceEventManager> refObj(refEvMgr, seed);
+
+    const auto duration = runRandomEvents(evMgr, obj, numGFs);
+    const auto refDuration = runRandomEvents(refEvMgr, refObj, numGFs);
+    BOOST_TEST_MESSAGE("Add/Remove/Execute of " << obj.handledEventIds.size() << " events took "
+                                                << std::chrono::duration_cast<std::chrono::microseconds>(duration).count()
+                                                << "us. Reference: "
+                                                << std::chrono::duration_cast<std::chrono::microseconds>(refDuration).count() << "us");
+    BOOST_TEST(obj.handledEventIds == refObj.handledEventIds, boost::test_tools::per_element());
+    BOOST_TEST_REQUIRE(evMgr.GetNumActiveEvents() == obj.pendingEvents.size());
+}
+
+BOOST_AUTO_TEST_CASE(FarEventsKeepOrder)
+{
+    TestEventManager evMgr(0);
+    TestEventHandler obj;
+    // Added while still far away
+    evMgr.AddEvent(&obj, 5000, 1);
+    evMgr.AddEvent(&obj, 5000, 2);
+    const GameEvent* removedEv = evMgr.AddEvent(&obj, 5000, 3);
+    evMgr.RemoveEvent(removedEv);
+    while(evMgr.GetCurrentGF() < 4990)
+        evMgr.ExecuteNextGF();
+    // Added when near, but for the same GF
+    evMgr.AddEvent(&obj, 10, 4);
+    BOOST_TEST(evMgr.GetEvents().size() == 3u);
+    BOOST_TEST(evMgr.ExecuteNextEvent() == 10u);
+    BOOST_TEST(obj.handledEventIds == (std::vector<unsigned>{1, 2, 4}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(SkippedBucketsGetReused)
+{
+    TestEventManager evMgr(0);
+    TestEventHandler obj;
+    const GameEvent* removedEv = evMgr.AddEvent(&obj, 5, 1);
+    evMgr.RemoveEvent(removedEv);
+    // Far event which moves into the bucket of the removed one when skipping to its GF
+    evMgr.AddEvent(&obj, 5 + 1024, 2);
+    BOOST_TEST(evMgr.ObjectHasEvents(obj));
+    BOOST_TEST(evMgr.ExecuteNextEvent() == 1029u);
+    BOOST_TEST(obj.handledEventIds == (std::vector<unsigned>{2}), boost::test_tools::per_element());
+    BOOST_TEST(!evMgr.ObjectHasEvents(obj));
+    BOOST_TEST(evMgr.GetNumActiveEvents() == 0u);
+}
+
 BOOST_AUTO_TEST_CASE(InvalidEvent)
 {
     rttr::test::LogAccessor logAcc;
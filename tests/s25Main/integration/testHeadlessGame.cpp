@@ -0,0 +1,147 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "Game.h"
+#include "GamePlayer.h"
+#include "HeadlessGame.h"
+#include "Replay.h"
+#include "Savegame.h"
+#include "SerializedGameData.h"
+#include "factories/GameCommandFactory.h"
+#include "network/PlayerGameCommands.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/WorldFixture.h"
+#include "nodeObjs/noFlag.h"
+#include "gameTypes/MapInfo.h"
+#include "s25util/tmpFile.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+namespace {
+struct HeadlessGameFixture : public WorldFixture<CreateEmptyWorld, 2>
+{
+    HeadlessGameFixture()
+    {
+        world.GetPlayer(1).ps = PS_AI;
+        world.GetPlayer(1).aiInfo = AI::Info(AI::DEFAULT, AI::EASY);
+        ggs.speed = GS_VERYFAST;
+    }
+
+    std::unique_ptr<Savegame> CreateSavegame()
+    {
+        auto save = std::make_unique<Savegame>();
+        for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+            save->AddPlayer(world.GetPlayer(i));
+        save->ggs = ggs;
+        save->start_gf = em.GetCurrentGF();
+        save->sgd.MakeSnapshot(game);
+        return save;
+    }
+};
+
+struct RecordCommands : public GameCommandFactory
+{
+    PlayerGameCommands result;
+
+protected:
+    bool AddGC(gc::GameCommandPtr gc) override
+    {
+        result.gcs.push_back(gc);
+        return true;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(HeadlessGameSuite)
+
+BOOST_FIXTURE_TEST_CASE(RunSavegame, HeadlessGameFixture)
+{
+    TmpFile tmpFile;
+    BOOST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    BOOST_REQUIRE(CreateSavegame()->Save(tmpFile.filePath, "MapTitle"));
+    const unsigned startGF = em.GetCurrentGF();
+
+    AsyncChecksum checksum;
+    for(unsigned run = 0; run < 2; run++)
+    {
+        HeadlessGame headlessGame;
+        BOOST_REQUIRE(headlessGame.LoadSavegame(tmpFile.filePath, 42));
+        BOOST_REQUIRE_EQUAL(headlessGame.GetGFNumber(), startGF);
+        // All players are controlled by AIs
+        BOOST_REQUIRE_EQUAL(headlessGame.GetGame().aiPlayers_.size(), 2u);
+        for(unsigned i = 0; i < 100; i++)
+            headlessGame.RunGF();
+        BOOST_REQUIRE_EQUAL(headlessGame.GetGFNumber(), startGF + 100);
+        // Same seed -> Same result
+        if(run == 0)
+            checksum = headlessGame.GetChecksum();
+        else
+            BOOST_REQUIRE(headlessGame.GetChecksum() == checksum);
+    }
+
+    HeadlessGame invalidGame;
+    BOOST_REQUIRE(!invalidGame.LoadSavegame(tmpFile.filePath + "invalid", 42));
+    BOOST_REQUIRE(!invalidGame.GetLastErrorMsg().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(RunReplay, HeadlessGameFixture)
+{
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const MapPoint flagPos = hqPos + MapPoint(4, 0);
+    BOOST_REQUIRE(world.GetBQ(flagPos, 0) != BQ_NOTHING);
+
+    MapInfo map;
+    map.type = MAPTYPE_SAVEGAME;
+    map.title = "MapTitle";
+    map.savegame = CreateSavegame();
+    const unsigned startGF = map.savegame->start_gf;
+
+    Replay replay;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        replay.AddPlayer(world.GetPlayer(i));
+    replay.ggs = ggs;
+    replay.random_init = 815;
+    TmpFile tmpFile;
+    BOOST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    boost::filesystem::remove(tmpFile.filePath);
+    BOOST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+    RecordCommands cmds;
+    cmds.SetFlag(flagPos);
+    replay.AddGameCommand(startGF + 5, 0, cmds.result);
+    replay.UpdateLastGF(startGF + 20);
+    replay.StopRecording();
+
+    HeadlessGame headlessGame;
+    BOOST_REQUIRE(headlessGame.LoadReplay(tmpFile.filePath));
+    BOOST_REQUIRE_EQUAL(headlessGame.GetGFNumber(), startGF);
+    // Replays contain the AI commands
+    BOOST_REQUIRE(headlessGame.GetGame().aiPlayers_.empty());
+    while(!headlessGame.IsFinished())
+    {
+        BOOST_REQUIRE(!headlessGame.GetGame().world_.GetSpecObj<noFlag>(flagPos) || headlessGame.GetGFNumber() > startGF + 5);
+        headlessGame.RunGF();
+    }
+    BOOST_REQUIRE_EQUAL(headlessGame.GetGFNumber(), startGF + 21);
+    BOOST_REQUIRE(headlessGame.GetGame().world_.GetSpecObj<noFlag>(flagPos));
+    BOOST_REQUIRE_EQUAL(headlessGame.GetNumAsyncGFs(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
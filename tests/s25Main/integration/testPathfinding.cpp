@@ -16,9 +16,25 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "rttrDefines.h" // IWYU pragma: keep
+#include "BuildingRegister.h"
+#include "FindWhConditions.h"
+#include "GamePlayer.h"
+#include "PointOutput.h"
+#include "Ware.h"
+#include "buildings/nobBaseWarehouse.h"
+#include "factories/BuildingFactory.h"
 #include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/CreateSeaWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noGranite.h"
+#include "pathfinding/FreePathFinder.h"
+#include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/HierarchicalPathFinder.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ShipDistanceFields.h"
 #include "gameTypes/Direction_Output.h"
 #include "gameData/GameConsts.h"
 #include "gameData/TerrainDesc.h"
@@ -26,6 +42,12 @@
 #include <boost/assign/std/vector.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <set>
+#include <thread>
 #include <vector>
 
 using namespace boost::assign;
@@ -39,6 +61,8 @@ BOOST_AUTO_TEST_SUITE(PathfindingSuite)
 namespace {
 using WorldFixtureEmpty0P = WorldFixture<CreateEmptyWorld, 0>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
+using WorldFixtureEmptyLarge = WorldFixture<CreateEmptyWorld, 0, 256, 256>;
+using WorldFixtureSea1P = WorldFixture<CreateSeaWorld, 1, SeaWorldDefault::width, SeaWorldDefault::height>;
 
 /// Sets all terrain to the given terrain
 void clearWorld(GameWorldGame& world, DescIdx<TerrainDesc> terrain)
@@ -50,6 +74,35 @@ void clearWorld(GameWorldGame& world, DescIdx<TerrainDesc> terrain)
     }
 }
 
+/// Walls with a gap at alternating ends so the searches need to walk around them
+void createWalls(GameWorldGame& world)
+{
+    for(MapCoord x = 32; x < world.GetWidth(); x += 64)
+    {
+        const bool gapAtTop = (x / 64) % 2 == 0;
+        for(MapCoord y = 0; y < world.GetHeight(); y++)
+        {
+            if((gapAtTop && y > 10) || (!gapAtTop && y + 10 < world.GetHeight()))
+                world.SetNO(MapPoint(x, y), new noGranite(GT_1, 1));
+        }
+    }
+}
+
+/// Return true if a human can walk the route from start to dest
+bool isValidHumanRoute(const GameWorldBase& world, MapPoint start, const MapPoint dest, const std::vector<Direction>& route)
+{
+    const PathConditionHuman condition(world);
+    for(unsigned i = 0; i < route.size(); i++)
+    {
+        if(!condition.IsEdgeOk(start, route[i]))
+            return false;
+        start = world.GetNeighbour(start, route[i]);
+        if(i + 1 < route.size() && !condition.IsNodeOk(start))
+            return false;
+    }
+    return start == dest;
+}
+
 void setupTestcase1(GameWorldGame& world, const MapPoint& startPt, DescIdx<TerrainDesc> tBlue, DescIdx<TerrainDesc> tWhite)
 {
     // test case 1: Everything is covered in blue terrain (e.g. water) which is walkable on the shore
@@ -306,4 +359,362 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     BOOST_REQUIRE_EQUAL(world.FindHumanPath(startPt, surroundingPts2[0]), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(ConcurrentSearches, WorldFixtureEmptyLarge)
+{
+    createWalls(world);
+    std::mt19937 rng(42);
+    std::vector<std::pair<MapPoint, MapPoint>> searches;
+    while(searches.size() < 200u)
+    {
+        const MapPoint startPt(static_cast<MapCoord>(rng() % world.GetWidth()), static_cast<MapCoord>(rng() % world.GetHeight()));
+        const MapPoint endPt(static_cast<MapCoord>(rng() % world.GetWidth()), static_cast<MapCoord>(rng() % world.GetHeight()));
+        if(startPt != endPt && world.GetNO(startPt)->GetType() == NOP_NOTHING && world.GetNO(endPt)->GetType() == NOP_NOTHING)
+            searches.emplace_back(startPt, endPt);
+    }
+
+    // Run all searches distributed over the given number of threads and return the results and the time required
+    const auto runSearches = [&](unsigned numThreads, std::vector<unsigned>& lengths) {
+        lengths.assign(searches.size(), 0);
+        const auto startTime = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for(unsigned i = 0; i < numThreads; i++)
+        {
+            threads.emplace_back([&, i]() {
+                for(unsigned j = i; j < searches.size(); j += numThreads)
+                {
+                    if(world.FindHumanPath(searches[j].first, searches[j].second, 0xFFFFFFFF, false, &lengths[j]) == INVALID_DIR)
+                        lengths[j] = 0;
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+            thread.join();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    };
+
+    std::vector<unsigned> expectedLengths;
+    const auto singleThreadTime = runSearches(1, expectedLengths);
+    BOOST_TEST_MESSAGE("1 thread: " << singleThreadTime.count() << "ms");
+    const unsigned maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    for(unsigned numThreads = 2; numThreads <= maxThreads; numThreads *= 2)
+    {
+        std::vector<unsigned> lengths;
+        const auto time = runSearches(numThreads, lengths);
+        BOOST_TEST_MESSAGE(numThreads << " threads: " << time.count() << "ms, speedup per core: "
+                                      << singleThreadTime.count() / (std::max<double>(time.count(), 1) * numThreads));
+        BOOST_TEST(lengths == expectedLengths, boost::test_tools::per_element());
+    }
+    // Workspaces are reused
+    BOOST_TEST(world.GetFreePathFinder().GetNumWorkspaces() <= maxThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE(NestedSearches, WorldFixtureEmpty0P)
+{
+    // A search started while another is running (e.g. from a node check) must not interfere with the outer one
+    struct NestedCondition
+    {
+        const GameWorldBase& world;
+        bool IsNodeOk(const MapPoint& pt) const
+        {
+            const MapPoint otherPt = world.GetNeighbour(pt, Direction::EAST);
+            return world.FindHumanPath(pt, world.GetNeighbour(otherPt, Direction::EAST), 10) != INVALID_DIR;
+        }
+        bool IsEdgeOk(const MapPoint&, const Direction) const { return true; }
+    };
+    unsigned length = 0;
+    BOOST_TEST(world.GetFreePathFinder().FindPath(MapPoint(1, 1), MapPoint(6, 5), false, 100, nullptr, &length, nullptr,
+                                                  NestedCondition{world}));
+    BOOST_TEST(length == world.CalcDistance(MapPoint(1, 1), MapPoint(6, 5)));
+    BOOST_TEST(world.GetFreePathFinder().GetNumWorkspaces() == 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(HierarchicalPaths, WorldFixtureEmptyLarge)
+{
+    ggs.setSelection(AddonId::HIERARCHICAL_PATHFINDING, 1);
+    createWalls(world);
+    std::mt19937 rng(42);
+    std::vector<std::pair<MapPoint, MapPoint>> searches;
+    while(searches.size() < 100u)
+    {
+        const MapPoint startPt(static_cast<MapCoord>(rng() % world.GetWidth()), static_cast<MapCoord>(rng() % world.GetHeight()));
+        const MapPoint endPt(static_cast<MapCoord>(rng() % world.GetWidth()), static_cast<MapCoord>(rng() % world.GetHeight()));
+        if(world.CalcDistance(startPt, endPt) >= HierarchicalPathFinder::MIN_DISTANCE && world.GetNO(startPt)->GetType() == NOP_NOTHING
+           && world.GetNO(endPt)->GetType() == NOP_NOTHING)
+            searches.emplace_back(startPt, endPt);
+    }
+
+    std::vector<unsigned> exactLengths(searches.size());
+    auto startTime = std::chrono::steady_clock::now();
+    for(unsigned i = 0; i < searches.size(); i++)
+    {
+        BOOST_TEST_REQUIRE(world.GetFreePathFinder().FindPath(searches[i].first, searches[i].second, false, 0xFFFFFFFF, nullptr,
+                                                              &exactLengths[i], nullptr, PathConditionHuman(world)));
+    }
+    const auto exactTime = std::chrono::steady_clock::now() - startTime;
+
+    std::vector<std::vector<Direction>> routes(searches.size());
+    std::vector<unsigned> lengths(searches.size());
+    startTime = std::chrono::steady_clock::now();
+    for(unsigned i = 0; i < searches.size(); i++)
+        BOOST_TEST_REQUIRE(world.FindHumanPath(searches[i].first, searches[i].second, 0xFFFFFFFF, false, &lengths[i], &routes[i])
+                           != INVALID_DIR);
+    const auto hierarchicalTime = std::chrono::steady_clock::now() - startTime;
+    BOOST_TEST_MESSAGE("Exact: " << std::chrono::duration_cast<std::chrono::milliseconds>(exactTime).count()
+                                 << "ms, hierarchical: " << std::chrono::duration_cast<std::chrono::milliseconds>(hierarchicalTime).count()
+                                 << "ms (including building the abstraction)");
+
+    unsigned sumExactLengths = 0, sumLengths = 0;
+    for(unsigned i = 0; i < searches.size(); i++)
+    {
+        BOOST_TEST(lengths[i] == routes[i].size());
+        BOOST_TEST(isValidHumanRoute(world, searches[i].first, searches[i].second, routes[i]));
+        // Not optimal but close to it
+        BOOST_TEST(lengths[i] >= exactLengths[i]);
+        BOOST_TEST(lengths[i] <= exactLengths[i] * 3 / 2 + HierarchicalPathFinder::CLUSTER_SIZE);
+        sumExactLengths += exactLengths[i];
+        sumLengths += lengths[i];
+    }
+    BOOST_TEST_MESSAGE("Paths are " << (sumLengths * 100.f / sumExactLengths - 100.f) << "% longer");
+
+    // Only the clusters around changed nodes are recalculated
+    const unsigned numClusterUpdates = world.GetHierarchicalPathFinder().GetNumClusterUpdates();
+    MapPoint curPt = searches[0].first;
+    for(unsigned i = 0; i < routes[0].size() / 2; i++)
+        curPt = world.GetNeighbour(curPt, routes[0][i]);
+    for(const MapPoint& pt : world.GetPointsInRadius(curPt, 2))
+    {
+        if(pt != searches[0].second && world.GetNO(pt)->GetType() == NOP_NOTHING)
+            world.SetNO(pt, new noGranite(GT_1, 1));
+    }
+    std::vector<Direction> route;
+    if(world.FindHumanPath(searches[0].first, searches[0].second, 0xFFFFFFFF, false, nullptr, &route) != INVALID_DIR)
+        BOOST_TEST(isValidHumanRoute(world, searches[0].first, searches[0].second, route));
+    BOOST_TEST(world.GetHierarchicalPathFinder().GetNumClusterUpdates() - numClusterUpdates <= 4u * 9u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ShipPathsByDistanceFields, WorldFixtureSea1P)
+{
+    ShipDistanceFields& fields = world.GetShipDistanceFields();
+    BOOST_TEST_REQUIRE(fields.IsUsable());
+    std::set<unsigned> coastalPts;
+    for(unsigned harborId = 1; harborId <= world.GetNumHarborPoints(); harborId++)
+    {
+        for(unsigned seaId = 1; seaId <= world.GetNumSeas(); seaId++)
+        {
+            if(!world.IsHarborAtSea(harborId, seaId))
+                continue;
+            const MapPoint coastalPt = world.GetCoastalPoint(harborId, seaId);
+            coastalPts.insert(world.GetIdx(coastalPt));
+            RTTR_FOREACH_PT(MapPoint, world.GetSize())
+            {
+                if(pt == coastalPt)
+                    continue;
+                // Same result as the exact search, but the route may be another one of the same length
+                std::vector<Direction> route, exactRoute;
+                unsigned length = 0, exactLength = 0;
+                const bool found = world.FindShipPathToHarbor(pt, harborId, seaId, &route, &length, 100);
+                BOOST_TEST_REQUIRE(found == world.FindShipPath(pt, coastalPt, 100, &exactRoute, &exactLength));
+                if(!found)
+                    continue;
+                BOOST_TEST_REQUIRE(length == exactLength);
+                BOOST_TEST_REQUIRE(route.size() == length);
+                MapPoint dest;
+                BOOST_TEST_REQUIRE(world.CheckShipRoute(pt, route, 0, &dest));
+                BOOST_TEST_REQUIRE(dest == coastalPt);
+                // Length limit is respected (0 would be the default limit)
+                if(length > 1)
+                    BOOST_TEST_REQUIRE(!world.FindShipPathToHarbor(pt, harborId, seaId, nullptr, nullptr, length - 1));
+            }
+        }
+    }
+    // One field per coastal point
+    BOOST_TEST(fields.GetNumFields() == coastalPts.size());
+
+    // Without enough memory the exact search is used
+    fields.Init(0);
+    BOOST_TEST_REQUIRE(!fields.IsUsable());
+    // Harbors 1 and 3 are both at the outer sea
+    unsigned short seaId = 1;
+    while(seaId < world.GetNumSeas() && !(world.IsHarborAtSea(1, seaId) && world.IsHarborAtSea(3, seaId)))
+        seaId++;
+    BOOST_TEST_REQUIRE((world.IsHarborAtSea(1, seaId) && world.IsHarborAtSea(3, seaId)));
+    const MapPoint coastalPt = world.GetCoastalPoint(1, seaId);
+    const MapPoint startPt = world.GetCoastalPoint(3, seaId);
+    std::vector<Direction> route;
+    unsigned length;
+    BOOST_TEST_REQUIRE(world.FindShipPathToHarbor(startPt, 1, seaId, &route, &length));
+    BOOST_TEST(route.size() == length);
+    BOOST_TEST(fields.GetNumFields() == 0u);
+    MapPoint dest;
+    BOOST_TEST_REQUIRE(world.CheckShipRoute(startPt, route, 0, &dest));
+    BOOST_TEST(dest == coastalPt);
+}
+
+BOOST_FIXTURE_TEST_CASE(CachedWarePaths, WorldWithGCExecution1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SOUTHEAST);
+    const MapPoint flagPos = world.MakeMapPoint(hqFlagPos - Position(4, 0));
+    BuildRoad(hqFlagPos, false, std::vector<Direction>(4, Direction::WEST));
+    auto* flag = world.GetSpecObj<noFlag>(flagPos);
+    const auto* hqFlag = world.GetSpecObj<noFlag>(hqFlagPos);
+    BOOST_TEST_REQUIRE(flag);
+
+    unsigned length = 0, cachedLength = 0;
+    unsigned char dir = INVALID_DIR, cachedDir = INVALID_DIR;
+    MapPoint firstPt, cachedFirstPt;
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*flag, *hqFlag, true, 1000, nullptr, &length, &dir, &firstPt));
+    BOOST_TEST(dir == Direction::EAST);
+    BOOST_TEST(firstPt == hqFlagPos);
+    // Same search again is answered from the cache
+    unsigned numHits = pathFinder.GetNumWarePathCacheHits();
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*flag, *hqFlag, true, 1000, nullptr, &cachedLength, &cachedDir, &cachedFirstPt));
+    BOOST_TEST(pathFinder.GetNumWarePathCacheHits() == numHits + 1);
+    BOOST_TEST(cachedLength == length);
+    BOOST_TEST(cachedDir == dir);
+    BOOST_TEST(cachedFirstPt == firstPt);
+    // Failed searches are cached too
+    BOOST_TEST(!pathFinder.FindPath(*flag, *hqFlag, true, length - 1, nullptr, &cachedLength));
+    BOOST_TEST(!pathFinder.FindPath(*flag, *hqFlag, true, length - 1, nullptr, &cachedLength));
+    BOOST_TEST(pathFinder.GetNumWarePathCacheHits() == numHits + 2);
+
+    // A ware waiting at the flag makes the road more expensive
+    auto* hq = world.GetSpecObj<nobBaseWarehouse>(hqPos);
+    auto* ware = new Ware(GD_BOARDS, hq, flag);
+    ware->WaitAtFlag(flag);
+    ware->RecalcRoute();
+    flag->AddWare(ware);
+    world.GetPlayer(curPlayer).IncreaseInventoryWare(GD_BOARDS, 1);
+    numHits = pathFinder.GetNumWarePathCacheHits();
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*flag, *hqFlag, true, 1000, nullptr, &cachedLength));
+    BOOST_TEST(pathFinder.GetNumWarePathCacheHits() == numHits);
+    BOOST_TEST(cachedLength == length + 2);
+
+    // Splitting the road changes the first node
+    const MapPoint middleFlagPos = world.MakeMapPoint(hqFlagPos - Position(2, 0));
+    SetFlag(middleFlagPos);
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*flag, *hqFlag, true, 1000, nullptr, nullptr, nullptr, &cachedFirstPt));
+    BOOST_TEST(pathFinder.GetNumWarePathCacheHits() == numHits);
+    BOOST_TEST(cachedFirstPt == middleFlagPos);
+}
+
+BOOST_FIXTURE_TEST_CASE(FindNearestWarehouse, WorldWithGCExecution1P)
+{
+    GamePlayer& player = world.GetPlayer(curPlayer);
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SOUTHEAST);
+    const MapPoint whFlagPos = world.MakeMapPoint(hqFlagPos - Position(4, 0));
+    const MapPoint midFlagPos = world.MakeMapPoint(hqFlagPos - Position(2, 0));
+    const MapPoint farFlagPos = world.MakeMapPoint(whFlagPos - Position(2, 0));
+    const auto* wh = static_cast<nobBaseWarehouse*>(
+      BuildingFactory::CreateBuilding(world, BLD_STOREHOUSE, world.GetNeighbour(whFlagPos, Direction::NORTHWEST), curPlayer, NAT_ROMANS));
+    // Not connected to the others
+    const MapPoint unconnectedFlagPos = world.MakeMapPoint(hqFlagPos + Position(2, 2));
+    BuildingFactory::CreateBuilding(world, BLD_STOREHOUSE, world.GetNeighbour(unconnectedFlagPos, Direction::NORTHWEST), curPlayer,
+                                    NAT_ROMANS);
+    BOOST_TEST_REQUIRE(player.GetBuildingRegister().GetStorehouses().size() == 3u);
+    BuildRoad(hqFlagPos, false, std::vector<Direction>(4, Direction::WEST));
+    BuildRoad(whFlagPos, false, std::vector<Direction>(2, Direction::WEST));
+    SetFlag(midFlagPos);
+    const auto* midFlag = world.GetSpecObj<noFlag>(midFlagPos);
+    const auto* farFlag = world.GetSpecObj<noFlag>(farFlagPos);
+    const auto* hqFlag = world.GetSpecObj<noFlag>(hqFlagPos);
+    BOOST_TEST_REQUIRE(midFlag);
+    BOOST_TEST_REQUIRE(farFlag);
+
+    // Reference: One search per warehouse taking the first one with the lowest costs
+    const auto findWhSeparately = [&](const noRoadNode& start, bool toWh, bool wareMode, const RoadSegment* forbidden, unsigned& length) {
+        const nobBaseWarehouse* best = nullptr;
+        length = std::numeric_limits<unsigned>::max();
+        for(const nobBaseWarehouse* curWh : player.GetBuildingRegister().GetStorehouses())
+        {
+            unsigned curLength;
+            if(pathFinder.FindPath(toWh ? start : *curWh, toWh ? *curWh : start, wareMode, length, forbidden, &curLength)
+               && (!best || curLength < length))
+            {
+                best = curWh;
+                length = curLength;
+            }
+        }
+        return best;
+    };
+
+    const RoadSegment* midRoad = midFlag->GetRoute(Direction::WEST);
+    for(const noFlag* start : {midFlag, farFlag, hqFlag})
+    {
+        for(const RoadSegment* forbidden : {static_cast<const RoadSegment*>(nullptr), midRoad})
+        {
+            for(bool toWh : {true, false})
+            {
+                for(bool wareMode : {true, false})
+                {
+                    unsigned length, expectedLength;
+                    const nobBaseWarehouse* expectedWh = findWhSeparately(*start, toWh, wareMode, forbidden, expectedLength);
+                    BOOST_TEST(player.FindWarehouse(*start, FW::NoCondition(), toWh, wareMode, &length, forbidden) == expectedWh);
+                    BOOST_TEST(length == expectedLength);
+                }
+            }
+        }
+    }
+
+    // Same distance to both -> HQ is registered first
+    unsigned length;
+    BOOST_TEST(player.FindWarehouse(*midFlag, FW::NoCondition(), true, false, &length, nullptr)->GetPos() == hqPos);
+    BOOST_TEST(length == 3u);
+    BOOST_TEST(player.FindWarehouse(*farFlag, FW::NoCondition(), true, false, &length, nullptr) == wh);
+    BOOST_TEST(length == 3u);
+    // Only way is blocked
+    BOOST_TEST(!player.FindWarehouse(*farFlag, FW::NoCondition(), false, false, &length, farFlag->GetRoute(Direction::EAST)));
+    BOOST_TEST(length == std::numeric_limits<unsigned>::max());
+}
+
+BOOST_FIXTURE_TEST_CASE(WarePathLengths, WorldWithGCExecution1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SOUTHEAST);
+    const MapPoint whFlagPos = world.MakeMapPoint(hqFlagPos - Position(4, 0));
+    const auto* wh = BuildingFactory::CreateBuilding(world, BLD_STOREHOUSE, world.GetNeighbour(whFlagPos, Direction::NORTHWEST),
+                                                     curPlayer, NAT_ROMANS);
+    BuildRoad(hqFlagPos, false, std::vector<Direction>(4, Direction::WEST));
+    BuildRoad(whFlagPos, false, std::vector<Direction>(2, Direction::SOUTHWEST));
+    const MapPoint midFlagPos = world.MakeMapPoint(hqFlagPos - Position(2, 0));
+    SetFlag(midFlagPos);
+    const noRoadNode* hq = world.GetSpecObj<noRoadNode>(hqPos);
+    std::vector<const noRoadNode*> goals{wh, world.GetSpecObj<noRoadNode>(hqFlagPos), world.GetSpecObj<noRoadNode>(midFlagPos),
+                                         world.GetSpecObj<noRoadNode>(whFlagPos)};
+    goals.push_back(goals.back()->GetNeighbour(Direction::SOUTHWEST));
+    for(const noRoadNode* goal : goals)
+        BOOST_TEST_REQUIRE(goal);
+
+    // Without calculating them first every request is a search
+    unsigned length;
+    BOOST_TEST_REQUIRE(pathFinder.GetWarePathLength(*hq, *wh, 10000, &length));
+    BOOST_TEST(pathFinder.GetNumWarePathSearchesSaved() == 0u);
+
+    pathFinder.CalcWarePathLengths(*hq, 10000);
+    for(const unsigned max : {10000u, 100u, 1u})
+    {
+        for(const noRoadNode* goal : goals)
+        {
+            unsigned expectedLength;
+            const bool expectedFound = pathFinder.FindPath(*hq, *goal, true, max, nullptr, &expectedLength);
+            const unsigned numSaved = pathFinder.GetNumWarePathSearchesSaved();
+            BOOST_TEST(pathFinder.GetWarePathLength(*hq, *goal, max, &length) == expectedFound);
+            BOOST_TEST(pathFinder.GetNumWarePathSearchesSaved() == numSaved + 1);
+            if(expectedFound)
+                BOOST_TEST(length == expectedLength);
+        }
+    }
+    // Longer paths were not calculated
+    unsigned numSaved = pathFinder.GetNumWarePathSearchesSaved();
+    BOOST_TEST(pathFinder.GetWarePathLength(*hq, *wh, 10001, &length));
+    BOOST_TEST(pathFinder.GetNumWarePathSearchesSaved() == numSaved);
+
+    // Changes to the road network discard the lengths
+    DestroyFlag(midFlagPos);
+    numSaved = pathFinder.GetNumWarePathSearchesSaved();
+    BOOST_TEST(!pathFinder.GetWarePathLength(*hq, *wh, 10000, &length));
+    BOOST_TEST(pathFinder.GetNumWarePathSearchesSaved() == numSaved);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
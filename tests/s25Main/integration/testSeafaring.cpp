@@ -23,10 +23,12 @@
 #include "buildings/nobShipYard.h"
 #include "factories/BuildingFactory.h"
 #include "pathfinding/FindPathForRoad.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "postSystem/PostBox.h"
 #include "postSystem/ShipPostMsg.h"
 #include "worldFixtures/SeaWorldWithGCExecution.h"
 #include "worldFixtures/initGameRNG.hpp"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noShip.h"
 #include <boost/test/unit_test.hpp>
 
@@ -635,4 +637,23 @@ BOOST_FIXTURE_TEST_CASE(HarborDestroyed, ShipAndHarborsReadyFixture<1>)
     BOOST_REQUIRE_EQUAL(ship.GetTargetHarbor(), 1u);
 }
 
+BOOST_FIXTURE_TEST_CASE(CachedWarePathsOverDestroyedHarbor, ShipAndHarborsReadyFixture<1>)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hb2Pos = world.GetHarborPoint(2);
+    const auto* hb1Flag = world.GetSpecObj<noFlag>(world.GetNeighbour(world.GetHarborPoint(1), Direction::SOUTHEAST));
+    const auto* hb2Flag = world.GetSpecObj<noFlag>(world.GetNeighbour(hb2Pos, Direction::SOUTHEAST));
+    BOOST_TEST_REQUIRE(hb1Flag);
+    BOOST_TEST_REQUIRE(hb2Flag);
+    // Only reachable by ship
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*hb1Flag, *hb2Flag, true));
+    const unsigned numHits = pathFinder.GetNumWarePathCacheHits();
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(*hb1Flag, *hb2Flag, true));
+    BOOST_TEST(pathFinder.GetNumWarePathCacheHits() == numHits + 1);
+
+    destroyBldAndFire(world, hb2Pos);
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(hb2Flag->GetPos()) == hb2Flag);
+    BOOST_TEST(!pathFinder.FindPath(*hb1Flag, *hb2Flag, true));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
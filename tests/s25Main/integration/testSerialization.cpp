@@ -16,6 +16,7 @@
 // along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
 
 #include "rttrDefines.h" // IWYU pragma: keep
+#include "AsyncSavegameWriter.h"
 #include "GameCommands.h"
 #include "GameEvent.h"
 #include "GamePlayer.h"
@@ -30,12 +31,20 @@
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
 #include "nodeObjs/noFire.h"
+#include "nodeObjs/noGranite.h"
 #include "gameTypes/MapInfo.h"
+#include "s25util/BinaryFile.h"
 #include "s25util/tmpFile.h"
 #include <rttr/test/testHelpers.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
+#include <utility>
+#include <vector>
 
 // LCOV_EXCL_START
 template<class T>
@@ -74,6 +83,8 @@ struct RandWorldFixture : public WorldFixture<CreateEmptyWorld, 4>
     }
 };
 
+using LargeWorldFixture = WorldFixture<CreateEmptyWorld, 2, 256, 256>;
+
 struct GetTestCommands : public GameCommandFactory
 {
     PlayerGameCommands result;
@@ -318,6 +329,144 @@ BOOST_FIXTURE_TEST_CASE(BaseSaveLoad, RandWorldFixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(LargeSnapshot, LargeWorldFixture)
+{
+    // Simulate a late game where most objects ever created are gone already
+    for(unsigned i = 0; i < 200000; i++)
+        delete new noGranite(GT_1, 1);
+    unsigned numFires = 0;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(world.GetNode(pt).obj)
+            continue;
+        if(world.GetIdx(pt) % 16 == 0)
+        {
+            world.SetNO(pt, new noFire(pt, false));
+            numFires++;
+        } else
+            world.SetNO(pt, new noGranite(GT_1, 1));
+    }
+    BOOST_TEST_REQUIRE(em.GetNumActiveEvents() >= numFires);
+    const unsigned origObjNum = GameObject::GetNumObjs();
+    const unsigned origObjIdNum = GameObject::GetObjIDCounter();
+
+    SerializedGameData sgd;
+    auto startTime = std::chrono::steady_clock::now();
+    sgd.MakeSnapshot(game);
+    const auto makeTime = std::chrono::steady_clock::now() - startTime;
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        players.push_back(PlayerInfo(world.GetPlayer(i)));
+    const auto loadedGame = std::make_shared<Game>(ggs, em.GetCurrentGF(), players);
+    startTime = std::chrono::steady_clock::now();
+    sgd.ReadSnapshot(loadedGame);
+    const auto readTime = std::chrono::steady_clock::now() - startTime;
+    BOOST_TEST_MESSAGE("Snapshot of " << origObjNum << " objects and " << em.GetNumActiveEvents() << " events made in "
+                                      << std::chrono::duration_cast<std::chrono::milliseconds>(makeTime).count() << "ms, read in "
+                                      << std::chrono::duration_cast<std::chrono::milliseconds>(readTime).count() << "ms");
+    BOOST_TEST(GameObject::GetNumObjs() == origObjNum);
+    BOOST_TEST(GameObject::GetObjIDCounter() == origObjIdNum);
+    BOOST_TEST(loadedGame->world_.GetEvMgr().GetNumActiveEvents() == em.GetNumActiveEvents());
+
+    SerializedGameData loadedSgd;
+    loadedSgd.MakeSnapshot(loadedGame);
+    BOOST_TEST_REQUIRE(loadedSgd.GetLength() == sgd.GetLength());
+    BOOST_TEST(std::equal(sgd.GetData(), sgd.GetData() + sgd.GetLength(), loadedSgd.GetData()));
+}
+
+BOOST_FIXTURE_TEST_CASE(LoadUncompressedSavegame, RandWorldFixture)
+{
+    Savegame save;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save.AddPlayer(world.GetPlayer(i));
+    save.ggs = ggs;
+    save.start_gf = em.GetCurrentGF();
+    save.sgd.MakeSnapshot(game);
+
+    TmpFile compressedFile, storedFile, uncompressedFile;
+    BOOST_REQUIRE(compressedFile.isValid() && storedFile.isValid() && uncompressedFile.isValid());
+    compressedFile.close();
+    storedFile.close();
+    uncompressedFile.close();
+    BOOST_REQUIRE(save.Save(compressedFile.filePath, "MapTitle"));
+    // Current format with compression disabled
+    save.compressGameData = false;
+    BOOST_REQUIRE(save.Save(storedFile.filePath, "MapTitle"));
+    {
+        // Version 4 format: Game data written as-is
+        BinaryFile file;
+        BOOST_REQUIRE(file.Open(uncompressedFile.filePath, OFM_WRITE));
+        save.WriteAllHeaderData(file, "MapTitle");
+        save.WritePlayerData(file);
+        save.WriteGGS(file);
+        save.sgd.WriteToFile(file);
+    }
+    {
+        // Version is stored right after the signature
+        boost::nowide::fstream file(uncompressedFile.filePath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(save.GetSignature().size());
+        const std::array<char, 2> version = {4, 0};
+        file.write(version.data(), version.size());
+    }
+    BOOST_TEST(boost::filesystem::file_size(compressedFile.filePath) < boost::filesystem::file_size(uncompressedFile.filePath));
+    BOOST_TEST(boost::filesystem::file_size(compressedFile.filePath) < boost::filesystem::file_size(storedFile.filePath));
+
+    for(const std::string& filePath : {compressedFile.filePath, storedFile.filePath, uncompressedFile.filePath})
+    {
+        Savegame loadSave;
+        BOOST_REQUIRE_MESSAGE(loadSave.Load(filePath, true, true), loadSave.GetLastErrorMsg());
+        BOOST_REQUIRE_EQUAL(loadSave.GetMapName(), "MapTitle");
+        BOOST_REQUIRE_EQUAL(loadSave.start_gf, save.start_gf);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(loadSave.sgd.GetData(), loadSave.sgd.GetData() + loadSave.sgd.GetLength(), save.sgd.GetData(),
+                                        save.sgd.GetData() + save.sgd.GetLength());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(AsyncSave, RandWorldFixture)
+{
+    for(unsigned i = 0; i < 10; i++)
+        em.ExecuteNextGF();
+
+    auto save = std::make_unique<Savegame>();
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save->AddPlayer(world.GetPlayer(i));
+    save->ggs = ggs;
+    save->start_gf = em.GetCurrentGF();
+    save->sgd.MakeSnapshot(game);
+    // Keep a copy of the data as the savegame is owned by the writer
+    const std::vector<uint8_t> snapshot(save->sgd.GetData(), save->sgd.GetData() + save->sgd.GetLength());
+
+    TmpFile tmpFile;
+    BOOST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+
+    std::vector<AsyncSavegameWriter::Result> results;
+    {
+        AsyncSavegameWriter writer;
+        BOOST_REQUIRE(writer.Push(std::move(save), tmpFile.filePath, "MapTitle"));
+        // Writing to a folder fails and must be reported
+        const std::string invalidPath = boost::filesystem::temp_directory_path().string();
+        BOOST_REQUIRE(writer.Push(std::make_unique<Savegame>(), invalidPath, "MapTitle"));
+        writer.WaitForCompletion();
+        BOOST_REQUIRE(!writer.IsFull());
+        results = writer.PopResults();
+        BOOST_REQUIRE(writer.PopResults().empty());
+    }
+    BOOST_REQUIRE_EQUAL(results.size(), 2u);
+    BOOST_REQUIRE_EQUAL(results[0].filePath, tmpFile.filePath);
+    BOOST_REQUIRE(results[0].success);
+    BOOST_REQUIRE(!results[1].success);
+    BOOST_REQUIRE(!results[1].errorMsg.empty());
+
+    Savegame loadSave;
+    BOOST_REQUIRE(loadSave.Load(tmpFile.filePath, true, true));
+    BOOST_REQUIRE_EQUAL(loadSave.GetMapName(), "MapTitle");
+    BOOST_REQUIRE_EQUAL(loadSave.start_gf, em.GetCurrentGF());
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(loadSave.sgd.GetData(), loadSave.sgd.GetData() + loadSave.sgd.GetLength(), snapshot.begin(),
+                                    snapshot.end());
+}
+
 BOOST_AUTO_TEST_CASE(ReplayWithMap)
 {
     MapInfo map;
@@ -521,4 +670,118 @@ BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(ReplayKeyframes, RandWorldFixture)
+{
+    MapInfo map;
+    map.type = MAPTYPE_OLDMAP;
+    map.title = "MapTitle";
+    map.filepath = "Map.swd";
+    map.mapData.data = std::vector<char>(42, 0x42);
+    map.mapData.length = 50;
+
+    Savegame save;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save.AddPlayer(world.GetPlayer(i));
+    save.ggs = ggs;
+    save.start_gf = em.GetCurrentGF();
+    save.sgd.MakeSnapshot(game);
+    const UsedPRNG rngState(4711);
+
+    Replay replay;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        replay.AddPlayer(world.GetPlayer(i));
+    TmpFile tmpFile;
+    BOOST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    bfs::remove(tmpFile.filePath);
+    BOOST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+    replay.AddChatCommand(1, 0, 1, "Hello");
+    replay.AddKeyframe(2);
+    replay.AddChatCommand(3, 0, 1, "Hello2");
+    // Data gets added later when written in the background
+    replay.AddKeyframeData(2, save, rngState);
+    replay.AddKeyframe(4);
+    save.CompressGameData();
+    replay.AddKeyframeData(4, save, rngState);
+    replay.AddChatCommand(5, 0, 1, "Hello3");
+    // Data never added (e.g. recording stopped before it was written)
+    replay.AddKeyframe(5);
+    replay.UpdateLastGF(5);
+    const auto sizeWithoutIndex = static_cast<uintmax_t>(replay.GetFile().Tell());
+    replay.StopRecording();
+
+    // 2nd run: Index is missing (e.g. after a crash) and keyframes must be found by scanning the file
+    for(int i = 0; i < 2; i++)
+    {
+        if(i > 0)
+            bfs::resize_file(tmpFile.filePath, sizeWithoutIndex);
+        Replay loadReplay;
+        BOOST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath, true));
+        MapInfo newMap;
+        BOOST_REQUIRE(loadReplay.LoadGameData(newMap));
+        BOOST_REQUIRE_EQUAL(loadReplay.GetKeyframes().size(), 2u);
+        BOOST_REQUIRE_EQUAL(loadReplay.GetKeyframes()[0].gf, 2u);
+        BOOST_REQUIRE_EQUAL(loadReplay.GetKeyframes()[1].gf, 4u);
+        BOOST_REQUIRE(!loadReplay.FindKeyframe(1));
+        BOOST_REQUIRE_EQUAL(loadReplay.FindKeyframe(3)->gf, 2u);
+        BOOST_REQUIRE_EQUAL(loadReplay.FindKeyframe(4)->gf, 4u);
+        BOOST_REQUIRE_EQUAL(loadReplay.FindKeyframe(100)->gf, 4u);
+
+        // Sequential playback skips the keyframes
+        unsigned gf;
+        uint8_t player, dst;
+        std::string txt;
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 1u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_CHAT);
+        loadReplay.ReadChatCommand(player, dst, txt);
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 2u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_KEYFRAME);
+        loadReplay.SkipKeyframe();
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 3u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_CHAT);
+        loadReplay.ReadChatCommand(player, dst, txt);
+        BOOST_REQUIRE_EQUAL(txt, "Hello2");
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 3u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_KEYFRAMEDATA);
+        loadReplay.SkipKeyframe();
+
+        // Jump back to the first keyframe and continue from there
+        Savegame loadSave;
+        UsedPRNG loadRngState;
+        BOOST_REQUIRE(loadReplay.ReadKeyframe(loadReplay.GetKeyframes()[0], loadSave, loadRngState));
+        BOOST_REQUIRE(loadRngState == rngState);
+        BOOST_REQUIRE_EQUAL(loadSave.start_gf, save.start_gf);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(loadSave.sgd.GetData(), loadSave.sgd.GetData() + loadSave.sgd.GetLength(), save.sgd.GetData(),
+                                        save.sgd.GetData() + save.sgd.GetLength());
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 3u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_CHAT);
+        loadReplay.ReadChatCommand(player, dst, txt);
+        BOOST_REQUIRE_EQUAL(txt, "Hello2");
+        const std::vector<std::pair<unsigned, Replay::ReplayCommand>> keyframeRecords = {
+          {3u, Replay::RC_KEYFRAMEDATA}, {4u, Replay::RC_KEYFRAME}, {4u, Replay::RC_KEYFRAMEDATA}};
+        for(const auto& record : keyframeRecords)
+        {
+            BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+            BOOST_REQUIRE_EQUAL(gf, record.first);
+            BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), record.second);
+            loadReplay.SkipKeyframe();
+        }
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 5u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_CHAT);
+        loadReplay.ReadChatCommand(player, dst, txt);
+        BOOST_REQUIRE_EQUAL(txt, "Hello3");
+        BOOST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_REQUIRE_EQUAL(gf, 5u);
+        BOOST_REQUIRE_EQUAL(loadReplay.ReadRCType(), Replay::RC_KEYFRAME);
+        loadReplay.SkipKeyframe();
+        BOOST_REQUIRE(!loadReplay.ReadGF(&gf));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
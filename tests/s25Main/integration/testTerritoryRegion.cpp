@@ -328,4 +328,28 @@ BOOST_FIXTURE_TEST_CASE(CreateTerritoryRegion, WorldFixtureEmpty2P)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(PartialTerritoryRegion, WorldFixtureEmpty2P)
+{
+    // Regions at all positions (including wrapping around the map border) must contain the same territory as the whole map
+    const auto* hq = world.GetSpecObj<nobBaseMilitary>(world.GetPlayer(0).GetHQPos());
+    BOOST_REQUIRE(hq);
+    const Extent regionSize(5, 3);
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        TerritoryRegion region(Position(pt), regionSize, world);
+        region.CalcTerritoryOfBuilding(*hq);
+        for(unsigned y = 0; y < regionSize.y; y++)
+        {
+            for(unsigned x = 0; x < regionSize.x; x++)
+            {
+                const Position relPt(x, y);
+                const MapPoint curPt = world.MakeMapPoint(Position(pt) + relPt);
+                const bool isOwned = world.CalcDistance(curPt, hq->GetPos()) <= hq->GetMilitaryRadius();
+                BOOST_TEST_INFO(curPt << " in region at " << pt);
+                BOOST_TEST_REQUIRE(region.GetOwner(relPt) == (isOwned ? 1u : 0u));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,9 +28,13 @@
 #include "worldFixtures/WorldFixture.h"
 #include "world/MapLoader.h"
 #include "nodeObjs/noBase.h"
+#include "nodeObjs/noFlag.h"
+#include "gameTypes/ShipDirection.h"
 #include "libsiedler2/ArchivItem_Map_Header.h"
 #include "s25util/tmpFile.h"
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 struct MapTestFixture
@@ -92,6 +96,30 @@ struct WorldLoaded1PFixture : public WorldFixture<LoadWorldFromFileCreator, 1>
 {
     using WorldFixture<LoadWorldFromFileCreator, 1>::world;
 };
+using EmptyWorldFixture1P = WorldFixture<CreateEmptyWorld, 1>;
+
+/// Return the first terrain of the given kind which is (not) walkable
+DescIdx<TerrainDesc> findTerrain(const WorldDescription& desc, TerrainKind kind, bool walkable)
+{
+    DescIdx<TerrainDesc> t(0);
+    for(; t.value < desc.terrain.size(); t.value++)
+    {
+        if(desc.get(t).kind == kind && desc.get(t).Is(ETerrain::Walkable) == walkable)
+            break;
+    }
+    return t;
+}
+
+/// Initialize the world with the given size and fill it with the terrain
+void initWorld(GameWorldGame& world, const MapExtent& size, DescIdx<TerrainDesc> terrain)
+{
+    world.Init(size);
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        MapNode& node = world.GetNodeWriteable(pt);
+        node.t1 = node.t2 = terrain;
+    }
+}
 } // namespace
 
 BOOST_FIXTURE_TEST_CASE(LoadWorld, WorldFixture<UninitializedWorldCreator>)
@@ -231,4 +259,100 @@ BOOST_FIXTURE_TEST_CASE(CloseHarborSpots, WorldFixture<UninitializedWorldCreator
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(HarborNeighborsOnLargeMap, WorldFixture<UninitializedWorldCreator>)
+{
+    loadGameData(world.GetDescriptionWriteable());
+    const DescIdx<TerrainDesc> tWater = findTerrain(world.GetDescription(), TerrainKind::WATER, false);
+    const DescIdx<TerrainDesc> tLand = findTerrain(world.GetDescription(), TerrainKind::LAND, true);
+    initWorld(world, MapExtent(256, 256), tWater);
+
+    // Small islands with a harbor each in a single sea
+    std::vector<MapPoint> hbPos;
+    for(MapCoord y = 16; y < world.GetHeight(); y += 32)
+    {
+        for(MapCoord x = 16; x < world.GetWidth(); x += 32)
+            hbPos.push_back(MapPoint(x + y % 64 / 4, y));
+    }
+    for(const MapPoint& pt : hbPos)
+    {
+        for(const MapPoint& curPt : world.GetPointsInRadius(pt, 1))
+        {
+            for(unsigned dir = 0; dir < Direction::COUNT; dir++)
+                setRightTerrain(world, curPt, Direction::fromInt(dir), tLand);
+        }
+        // Water directly behind the coastal points
+        for(unsigned dir = 0; dir < Direction::COUNT; dir++)
+        {
+            const MapPoint waterPt = world.GetNeighbour(world.GetNeighbour(pt, Direction::fromInt(dir)), Direction::fromInt(dir));
+            for(unsigned dir2 = 0; dir2 < Direction::COUNT; dir2++)
+                setRightTerrain(world, waterPt, Direction::fromInt(dir2), tWater);
+        }
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(MapLoader::InitSeasAndHarbors(world, hbPos));
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+    BOOST_TEST_MESSAGE("Seas and " << hbPos.size() << " harbors initialized in "
+                                   << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << "ms");
+
+    BOOST_REQUIRE_EQUAL(world.GetNumHarborPoints(), hbPos.size());
+    BOOST_REQUIRE_EQUAL(world.GetNumSeas(), 1u);
+    std::vector<std::vector<HarborPos::Neighbor>> parallelNeighbors;
+    for(unsigned hbId = 1; hbId <= world.GetNumHarborPoints(); hbId++)
+    {
+        // All other harbors are found
+        std::vector<unsigned> neighborIds;
+        for(unsigned dir = 0; dir < ShipDirection::COUNT; dir++)
+        {
+            const std::vector<HarborPos::Neighbor>& neighbors = world.GetHarborNeighbors(hbId, ShipDirection::fromInt(dir));
+            for(const HarborPos::Neighbor& neighbor : neighbors)
+                neighborIds.push_back(neighbor.id);
+            parallelNeighbors.push_back(neighbors);
+        }
+        std::sort(neighborIds.begin(), neighborIds.end());
+        BOOST_REQUIRE_EQUAL(neighborIds.size(), hbPos.size() - 1u);
+        BOOST_REQUIRE(std::unique(neighborIds.begin(), neighborIds.end()) == neighborIds.end());
+    }
+
+    // A single thread finds the same neighbors in the same order with the same distances
+    MapLoader::CalcHarborPosNeighbors(world, 1);
+    auto itParallel = parallelNeighbors.begin();
+    for(unsigned hbId = 1; hbId <= world.GetNumHarborPoints(); hbId++)
+    {
+        for(unsigned dir = 0; dir < ShipDirection::COUNT; dir++, ++itParallel)
+        {
+            const std::vector<HarborPos::Neighbor>& expected = world.GetHarborNeighbors(hbId, ShipDirection::fromInt(dir));
+            BOOST_REQUIRE_EQUAL(itParallel->size(), expected.size());
+            for(unsigned i = 0; i < expected.size(); i++)
+            {
+                BOOST_TEST((*itParallel)[i].id == expected[i].id);
+                BOOST_TEST((*itParallel)[i].distance == expected[i].distance);
+            }
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(StateHashTracksChanges, EmptyWorldFixture1P)
+{
+    const unsigned startHash = world.GetStateHash();
+    BOOST_REQUIRE_EQUAL(startHash, world.CalcStateHash());
+
+    const MapPoint hqFlagPos = world.GetNeighbour(world.GetPlayer(0).GetHQPos(), Direction::SOUTHEAST);
+    const MapPoint flagPos = hqFlagPos + MapPoint(4, 0);
+    world.SetFlag(flagPos, 0);
+    BOOST_REQUIRE(world.GetSpecObj<noFlag>(flagPos));
+    const unsigned flagHash = world.GetStateHash();
+    BOOST_REQUIRE_NE(flagHash, startHash);
+    BOOST_REQUIRE_EQUAL(flagHash, world.CalcStateHash());
+
+    world.BuildRoad(0, false, hqFlagPos, std::vector<Direction>(4, Direction::EAST));
+    BOOST_REQUIRE_NE(world.GetStateHash(), flagHash);
+    BOOST_REQUIRE_EQUAL(world.GetStateHash(), world.CalcStateHash());
+
+    // Removing everything again restores the hash
+    world.DestroyFlag(flagPos, 0);
+    BOOST_REQUIRE(!world.GetSpecObj<noFlag>(flagPos));
+    BOOST_REQUIRE_EQUAL(world.GetStateHash(), startHash);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 #include "gameData/MaxPlayers.h"
 #include "libsiedler2/enumTypes.h"
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -132,4 +133,64 @@ BOOST_AUTO_TEST_CASE(InvalidConfig)
     BOOST_REQUIRE_EQUAL(map.size, MapExtent(32, 34));
 }
 
+namespace {
+Map createMap(const MapSettings& settings, uint64_t seed, RandomMapGenerator::PhaseTimings* timings = nullptr)
+{
+    RandomConfig config;
+    BOOST_REQUIRE(config.Init(MapStyle::Random, DescIdx<LandscapeDesc>(0), seed));
+    RandomMapGenerator generator(config);
+    Map map(generator.Create(settings));
+    if(timings)
+        *timings = generator.GetPhaseTimings();
+    return map;
+}
+
+void checkMapsEqual(const Map& map1, const Map& map2)
+{
+    BOOST_TEST(map1.z == map2.z, boost::test_tools::per_element());
+    BOOST_TEST(map1.textureRsu == map2.textureRsu, boost::test_tools::per_element());
+    BOOST_TEST(map1.textureLsd == map2.textureLsd, boost::test_tools::per_element());
+    BOOST_TEST(map1.objectType == map2.objectType, boost::test_tools::per_element());
+    BOOST_TEST(map1.objectInfo == map2.objectInfo, boost::test_tools::per_element());
+    BOOST_TEST(map1.animal == map2.animal, boost::test_tools::per_element());
+    BOOST_TEST(map1.resource == map2.resource, boost::test_tools::per_element());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(Create_SameSeedSameMap)
+{
+    MapSettings settings;
+    settings.size = MapExtent(70, 64);
+    settings.numPlayers = 3;
+    checkMapsEqual(createMap(settings, 0x1337), createMap(settings, 0x1337));
+}
+
+/**
+ * The tiled generation must give the same map for every number of threads.
+ * Also shows the time taken by each phase of the generation.
+ */
+BOOST_AUTO_TEST_CASE(Create_TiledIndependentOfThreads)
+{
+    MapSettings settings;
+    settings.size = MapExtent(200, 166);
+    settings.numPlayers = 4;
+    settings.numThreads = 1;
+    RandomMapGenerator::PhaseTimings timings;
+    const Map map = createMap(settings, 0x1337, &timings);
+    BOOST_TEST(timings.size() == 7u);
+    for(const auto& timing : timings)
+    {
+        BOOST_TEST_MESSAGE(timing.first << ": " << std::chrono::duration_cast<std::chrono::microseconds>(timing.second).count()
+                                        << "us");
+    }
+    for(unsigned numThreads : {2u, 3u, 8u})
+    {
+        settings.numThreads = numThreads;
+        checkMapsEqual(map, createMap(settings, 0x1337));
+    }
+    // Seed still matters
+    settings.numThreads = 2;
+    BOOST_TEST(!(map.z == createMap(settings, 0x1338).z));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 #include "s25util/Serializer.h"
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <limits>
 #include <random>
 #include <vector>
@@ -94,6 +95,61 @@ BOOST_AUTO_TEST_CASE(RandomEmptySeq)
     }
 }
 
+BOOST_AUTO_TEST_CASE(AsyncLog)
+{
+    RANDOM.Init(0x1337);
+    std::vector<int> values;
+    std::vector<unsigned> lines;
+    for(unsigned i = 0; i < 10; i++)
+    {
+        lines.push_back(__LINE__ + 1);
+        values.push_back(RANDOM_RAND(i, 100));
+    }
+    std::vector<RandomEntry> log = RANDOM.GetAsyncLog();
+    BOOST_REQUIRE_EQUAL(log.size(), values.size());
+    for(unsigned i = 0; i < log.size(); i++)
+    {
+        BOOST_TEST(log[i].counter == i);
+        BOOST_TEST(log[i].max == 100);
+        BOOST_TEST(log[i].obj_id == i);
+        BOOST_TEST(log[i].src_name == __FILE__);
+        BOOST_TEST(log[i].src_line == lines[i]);
+        BOOST_TEST(log[i].GetValue() == values[i]);
+    }
+
+    // Size gets rounded up to the next power of 2
+    RANDOM.SetHistorySize(100);
+    BOOST_TEST(RANDOM.GetHistorySize() == 128u);
+    RANDOM.Init(0x1337);
+    for(unsigned i = 0; i < 200; i++)
+        RANDOM_RAND(i, 10);
+    log = RANDOM.GetAsyncLog();
+    BOOST_REQUIRE_EQUAL(log.size(), 128u);
+    // Only the last invocations are kept
+    for(unsigned i = 0; i < log.size(); i++)
+    {
+        BOOST_TEST(log[i].counter == 72u + i);
+        BOOST_TEST(log[i].obj_id == 72u + i);
+    }
+    RANDOM.SetHistorySize(UsedRandom::DEFAULT_HISTORY_SIZE);
+    BOOST_TEST(RANDOM.GetHistorySize() == UsedRandom::DEFAULT_HISTORY_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(RandThroughput)
+{
+    // Not a real test but shows the cost of a call including the recording in the history
+    RANDOM.Init(0x1337);
+    const unsigned numCalls = 1000000;
+    int sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned i = 0; i < numCalls; i++)
+        sum += RANDOM_RAND(i, 1024);
+    const auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+    BOOST_TEST(sum >= 0);
+    if(duration.count() > 0)
+        BOOST_TEST_MESSAGE("RANDOM_RAND: " << static_cast<unsigned>(numCalls / duration.count()) << " calls/s");
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(ValueRangeValid, T_RNG, TestedRNGS)
 {
     for(unsigned seed : seeds)
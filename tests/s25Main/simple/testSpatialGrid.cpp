@@ -0,0 +1,110 @@
+// Copyright (c) 2005 - 2020 Settlers Freaks (sf-team at siedler25.org)
+//
+// This file is part of Return To The Roots.
+//
+// Return To The Roots is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Return To The Roots is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Return To The Roots. If not, see <http://www.gnu.org/licenses/>.
+
+#include "rttrDefines.h" // IWYU pragma: keep
+#include "helpers/containerUtils.h"
+#include "world/SpatialGrid.h"
+#include <rttr/test/random.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+struct Object
+{
+    MapPoint pos;
+    unsigned char player;
+};
+
+std::vector<const Object*> getObjectsInRange(const SpatialGrid<Object>& grid, MapPoint pt, unsigned short radius)
+{
+    std::vector<const Object*> result;
+    grid.VisitObjectsInRange(pt, radius, [&result](const Object* obj) { result.push_back(obj); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<const Object*> getObjectsInRange(const SpatialGrid<Object>& grid, MapPoint pt, unsigned short radius, unsigned char player)
+{
+    std::vector<const Object*> result;
+    grid.VisitObjectsInRange(pt, radius, player, [&result](const Object* obj) { result.push_back(obj); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/// Distance in cells taking the wrap-around into account
+unsigned getCellDistance(unsigned cell1, unsigned cell2, unsigned numCells)
+{
+    const unsigned dist = std::max(cell1, cell2) - std::min(cell1, cell2);
+    return std::min(dist, numCells - dist);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(SpatialGridSuite)
+
+BOOST_AUTO_TEST_CASE(VisitObjectsInRange)
+{
+    // Last column and row of cells is only partially on the map
+    const MapExtent mapSize(98, 64);
+    const unsigned short cellSize = 10;
+    const MapExtent numCells(10, 7);
+    SpatialGrid<Object> grid;
+    grid.Init(mapSize, cellSize);
+
+    std::vector<Object> objects(200);
+    for(Object& obj : objects)
+    {
+        obj.pos = MapPoint(rttr::test::randomValue<MapCoord>(0, mapSize.x - 1), rttr::test::randomValue<MapCoord>(0, mapSize.y - 1));
+        obj.player = rttr::test::randomValue<unsigned char>(0, 2);
+        grid.Add(&obj, obj.pos, obj.player);
+    }
+    // Remove some
+    for(unsigned i = 0; i < objects.size(); i += 3)
+        grid.Remove(&objects[i], objects[i].pos);
+
+    for(unsigned short radius = 0; radius < 7; radius++)
+    {
+        const MapPoint pt(rttr::test::randomValue<MapCoord>(0, mapSize.x - 1), rttr::test::randomValue<MapCoord>(0, mapSize.y - 1));
+        std::vector<const Object*> expected;
+        for(unsigned i = 0; i < objects.size(); i++)
+        {
+            const Object& obj = objects[i];
+            if(i % 3 != 0 && getCellDistance(pt.x / cellSize, obj.pos.x / cellSize, numCells.x) <= radius
+               && getCellDistance(pt.y / cellSize, obj.pos.y / cellSize, numCells.y) <= radius)
+                expected.push_back(&obj);
+        }
+        std::sort(expected.begin(), expected.end());
+        // Each object only once
+        const std::vector<const Object*> actual = getObjectsInRange(grid, pt, radius);
+        BOOST_TEST(actual == expected, boost::test_tools::per_element());
+
+        // Filtered by player
+        const unsigned char player = rttr::test::randomValue<unsigned char>(0, 2);
+        helpers::remove_if(expected, [player](const Object* obj) { return obj->player != player; });
+        const std::vector<const Object*> actualOfPlayer = getObjectsInRange(grid, pt, radius, player);
+        BOOST_TEST(actualOfPlayer == expected, boost::test_tools::per_element());
+    }
+
+    // Big radius returns all
+    BOOST_TEST(getObjectsInRange(grid, MapPoint(0, 0), 100).size() == objects.size() - (objects.size() + 2) / 3);
+
+    grid.Clear();
+    grid.Init(mapSize, cellSize);
+    BOOST_TEST(getObjectsInRange(grid, MapPoint(0, 0), 100).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,22 +23,16 @@ unsigned TestEventManager::ExecuteNextEvent(unsigned maxGF)
 {
     if(GetCurrentGF() >= maxGF)
         return 0;
-    if(events.empty())
+    const unsigned nextEventGF = GetNextEventGF();
+    if(nextEventGF == 0 || nextEventGF > maxGF)
     {
         unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
+        AdvanceToGF(maxGF);
         return numGFs;
     }
-    auto itEvents = events.begin();
-    if(itEvents->first > maxGF)
-    {
-        unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
-        return numGFs;
-    }
-    unsigned numGFs = itEvents->first - GetCurrentGF();
-    currentGF = itEvents->first;
-    ExecuteEvents(itEvents);
+    unsigned numGFs = nextEventGF - GetCurrentGF();
+    AdvanceToGF(nextEventGF);
+    ExecuteCurrentEvents();
     DestroyCurrentObjects();
     return numGFs;
 }
@@ -46,26 +40,20 @@ unsigned TestEventManager::ExecuteNextEvent(unsigned maxGF)
 std::vector<const GameEvent*> TestEventManager::GetObjEvents(const GameObject& obj) const
 {
     std::vector<const GameEvent*> objEvnts;
-    for(const auto& event : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                objEvnts.push_back(ev);
-        }
+        if(ev->obj == &obj)
+            objEvnts.push_back(ev);
     }
     return objEvnts;
 }
 
 bool TestEventManager::IsEventActive(const GameObject& obj, const unsigned id) const
 {
-    for(const auto& event : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->id == id && ev->obj == &obj)
-                return true;
-        }
+        if(ev->id == id && ev->obj == &obj)
+            return true;
     }
 
     return false;